@@ -79,6 +79,7 @@ static char *aus_rs_error(char data_pattern[], char *d) {
     unsigned char triple[31];
     unsigned char result[5];
     rs_t rs;
+    const rs_t *p_rs;
 
     for (reader = 2, length = d - data_pattern; reader < length; reader += 3, triple_writer++) {
         triple[triple_writer] = aus_convert_pattern(data_pattern[reader], 4)
@@ -86,9 +87,8 @@ static char *aus_rs_error(char data_pattern[], char *d) {
                 + aus_convert_pattern(data_pattern[reader + 2], 0);
     }
 
-    rs_init_gf(&rs, 0x43);
-    rs_init_code(&rs, 4, 1);
-    rs_encode(&rs, triple_writer, triple, result);
+    p_rs = rs_init_cached(&rs, 0x43, 4, 1);
+    rs_encode(p_rs, triple_writer, triple, result);
 
     for (reader = 4; reader > 0; reader--, d += 3) {
         memcpy(d, AusBarTable[(int) result[reader - 1]], 3);
@@ -848,7 +848,9 @@ INTERNAL int aztec(struct zint_symbol *symbol, struct zint_seg segs[], const int
     const int gs1 = (symbol->input_mode & 0x07) == GS1_MODE;
     const int debug_print = (symbol->debug & ZINT_DEBUG_PRINT);
     rs_t rs;
+    const rs_t *p_rs;
     rs_uint_t rs_uint;
+    const rs_uint_t *p_rs_uint;
     unsigned int *data_part;
     unsigned int *ecc_part;
 
@@ -1215,32 +1217,28 @@ INTERNAL int aztec(struct zint_symbol *symbol, struct zint_seg segs[], const int
 
     switch (codeword_size) {
         case 6:
-            rs_init_gf(&rs, 0x43);
-            rs_init_code(&rs, ecc_blocks, 1);
-            rs_encode_uint(&rs, data_blocks, data_part, ecc_part);
+            p_rs = rs_init_cached(&rs, 0x43, ecc_blocks, 1);
+            rs_encode_uint(p_rs, data_blocks, data_part, ecc_part);
             break;
         case 8:
-            rs_init_gf(&rs, 0x12d);
-            rs_init_code(&rs, ecc_blocks, 1);
-            rs_encode_uint(&rs, data_blocks, data_part, ecc_part);
+            p_rs = rs_init_cached(&rs, 0x12d, ecc_blocks, 1);
+            rs_encode_uint(p_rs, data_blocks, data_part, ecc_part);
             break;
         case 10:
-            if (!rs_uint_init_gf(&rs_uint, 0x409, 1023)) { /* Can fail on malloc() */
+            if (!(p_rs_uint = rs_uint_init_cached(&rs_uint, 0x409, 1023, ecc_blocks, 1))) { /* Can fail on malloc() */
                 strcpy(symbol->errtxt, "500: Insufficient memory for Reed-Solomon log tables");
                 return ZINT_ERROR_MEMORY;
             }
-            rs_uint_init_code(&rs_uint, ecc_blocks, 1);
-            rs_uint_encode(&rs_uint, data_blocks, data_part, ecc_part);
+            rs_uint_encode(p_rs_uint, data_blocks, data_part, ecc_part);
             rs_uint_free(&rs_uint);
             break;
         case 12:
-            if (!rs_uint_init_gf(&rs_uint, 0x1069, 4095)) { /* Can fail on malloc() */
+            if (!(p_rs_uint = rs_uint_init_cached(&rs_uint, 0x1069, 4095, ecc_blocks, 1))) { /* Can fail on malloc() */
                 /* Note using AUSPOST error nos range as out of 50x ones & 51x taken by CODEONE */
                 strcpy(symbol->errtxt, "700: Insufficient memory for Reed-Solomon log tables");
                 return ZINT_ERROR_MEMORY;
             }
-            rs_uint_init_code(&rs_uint, ecc_blocks, 1);
-            rs_uint_encode(&rs_uint, data_blocks, data_part, ecc_part);
+            rs_uint_encode(p_rs_uint, data_blocks, data_part, ecc_part);
             rs_uint_free(&rs_uint);
             break;
     }
@@ -1342,10 +1340,9 @@ INTERNAL int aztec(struct zint_symbol *symbol, struct zint_seg segs[], const int
     /* Add reed-solomon error correction with Galois field GF(16) and prime modulus
     x^4 + x + 1 (section 7.2.3)*/
 
-    rs_init_gf(&rs, 0x13);
     if (compact) {
-        rs_init_code(&rs, 5, 1);
-        rs_encode(&rs, 2, desc_data, desc_ecc);
+        p_rs = rs_init_cached(&rs, 0x13, 5, 1);
+        rs_encode(p_rs, 2, desc_data, desc_ecc);
         for (i = 0; i < 5; i++) {
             if (desc_ecc[4 - i] & 0x08) {
                 descriptor[(i * 4) + 8] = '1';
@@ -1369,8 +1366,8 @@ INTERNAL int aztec(struct zint_symbol *symbol, struct zint_seg segs[], const int
             }
         }
     } else {
-        rs_init_code(&rs, 6, 1);
-        rs_encode(&rs, 4, desc_data, desc_ecc);
+        p_rs = rs_init_cached(&rs, 0x13, 6, 1);
+        rs_encode(p_rs, 4, desc_data, desc_ecc);
         for (i = 0; i < 6; i++) {
             if (desc_ecc[5 - i] & 0x08) {
                 descriptor[(i * 4) + 16] = '1';
@@ -1454,6 +1451,7 @@ INTERNAL int azrune(struct zint_symbol *symbol, unsigned char source[], int leng
     int bp = 0;
     const int debug_print = symbol->debug & ZINT_DEBUG_PRINT;
     rs_t rs;
+    const rs_t *p_rs;
 
     input_value = 0;
     if (length > 3) {
@@ -1486,9 +1484,8 @@ INTERNAL int azrune(struct zint_symbol *symbol, unsigned char source[], int leng
     data_codewords[0] = (unsigned char) (input_value >> 4);
     data_codewords[1] = (unsigned char) (input_value & 0xF);
 
-    rs_init_gf(&rs, 0x13);
-    rs_init_code(&rs, 5, 1);
-    rs_encode(&rs, 2, data_codewords, ecc_codewords);
+    p_rs = rs_init_cached(&rs, 0x13, 5, 1);
+    rs_encode(p_rs, 2, data_codewords, ecc_codewords);
 
     for (i = 0; i < 5; i++) {
         bp = bin_append_posn(ecc_codewords[4 - i], 4, binary_string, bp);
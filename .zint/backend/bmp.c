@@ -33,11 +33,8 @@
 #include <errno.h>
 #include <stdio.h>
 #include "common.h"
+#include "filemem.h"
 #include "bmp.h"        /* Bitmap header structure */
-#ifdef _MSC_VER
-#include <io.h>
-#include <fcntl.h>
-#endif
 
 INTERNAL int bmp_pixel_plot(struct zint_symbol *symbol, unsigned char *pixelbuf) {
     int i, row, column;
@@ -47,14 +44,14 @@ INTERNAL int bmp_pixel_plot(struct zint_symbol *symbol, unsigned char *pixelbuf)
     unsigned int data_offset, data_size, file_size;
     unsigned char *bitmap_file_start, *bmp_posn;
     unsigned char *bitmap;
-    FILE *bmp_file;
+    struct filemem fm;
+    struct filemem *const fmp = &fm;
     bitmap_file_header_t file_header;
     bitmap_info_header_t info_header;
     color_ref_t bg_color_ref;
     color_ref_t fg_color_ref;
     color_ref_t ultra_color_ref[8];
     int ultra_fg_index = 9;
-    const int output_to_stdout = symbol->output_options & BARCODE_STDOUT; /* Suppress gcc -fanalyzer warning */
 
     fg_color_ref.red = (16 * ctoi(symbol->fgcolour[0])) + ctoi(symbol->fgcolour[1]);
     fg_color_ref.green = (16 * ctoi(symbol->fgcolour[2])) + ctoi(symbol->fgcolour[3]);
@@ -184,32 +181,21 @@ INTERNAL int bmp_pixel_plot(struct zint_symbol *symbol, unsigned char *pixelbuf)
     }
 
     /* Open output file in binary mode */
-    if (output_to_stdout) {
-#ifdef _MSC_VER
-        if (-1 == _setmode(_fileno(stdout), _O_BINARY)) {
-            sprintf(symbol->errtxt, "600: Could not set stdout to binary (%d: %.30s)", errno, strerror(errno));
-            free(bitmap_file_start);
-            return ZINT_ERROR_FILE_ACCESS;
-        }
-#endif
-        bmp_file = stdout;
-    } else {
-        if (!(bmp_file = fopen(symbol->outfile, "wb"))) {
-            free(bitmap_file_start);
-            sprintf(symbol->errtxt, "601: Could not open output file (%d: %.30s)", errno, strerror(errno));
-            return ZINT_ERROR_FILE_ACCESS;
-        }
+    if (!fm_open(fmp, symbol, "wb")) {
+        free(bitmap_file_start);
+        sprintf(symbol->errtxt, "601: Could not open output file (%d: %.30s)", fmp->err, strerror(fmp->err));
+        return ZINT_ERROR_FILE_ACCESS;
     }
 
-    fwrite(bitmap_file_start, file_header.file_size, 1, bmp_file);
+    fm_write(bitmap_file_start, file_header.file_size, 1, fmp);
 
-    if (output_to_stdout) {
-        fflush(bmp_file);
-    } else {
-        fclose(bmp_file);
+    free(bitmap_file_start);
+
+    if (!fm_close(fmp, symbol)) {
+        sprintf(symbol->errtxt, "603: Failure on closing output file (%d: %.30s)", fmp->err, strerror(fmp->err));
+        return ZINT_ERROR_FILE_WRITE;
     }
 
-    free(bitmap_file_start);
     return 0;
 }
 
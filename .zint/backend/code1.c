@@ -1005,6 +1005,7 @@ INTERNAL int codeone(struct zint_symbol *symbol, struct zint_seg segs[], const i
     int row, col;
     int sub_version = 0;
     rs_t rs;
+    const rs_t *p_rs;
     int error_number = 0;
     const int gs1 = (symbol->input_mode & 0x07) == GS1_MODE;
     const int debug_print = symbol->debug & ZINT_DEBUG_PRINT;
@@ -1084,9 +1085,8 @@ INTERNAL int codeone(struct zint_symbol *symbol, struct zint_seg segs[], const i
         large_add_u64(&elreg, 1);
         large_uint_array(&elreg, target, codewords, 5 /*bits*/);
 
-        rs_init_gf(&rs, 0x25);
-        rs_init_code(&rs, codewords, 0);
-        rs_encode_uint(&rs, codewords, target, ecc);
+        p_rs = rs_init_cached(&rs, 0x25, codewords, 0);
+        rs_encode_uint(p_rs, codewords, target, ecc);
 
         for (i = 0; i < codewords; i++) {
             target[i + codewords] = ecc[codewords - i - 1];
@@ -1172,9 +1172,8 @@ INTERNAL int codeone(struct zint_symbol *symbol, struct zint_seg segs[], const i
         }
 
         /* Calculate error correction data */
-        rs_init_gf(&rs, 0x12d);
-        rs_init_code(&rs, ecc_cw, 0);
-        rs_encode_uint(&rs, data_cw, target, ecc);
+        p_rs = rs_init_cached(&rs, 0x12d, ecc_cw, 0);
+        rs_encode_uint(p_rs, data_cw, target, ecc);
 
         for (i = 0; i < ecc_cw; i++) {
             target[data_cw + i] = ecc[ecc_cw - i - 1];
@@ -1258,13 +1257,12 @@ INTERNAL int codeone(struct zint_symbol *symbol, struct zint_seg segs[], const i
         ecc_blocks = c1_ecc_blocks[size - 1];
         ecc_length = c1_ecc_length[size - 1];
 
-        rs_init_gf(&rs, 0x12d);
-        rs_init_code(&rs, ecc_blocks, 0);
+        p_rs = rs_init_cached(&rs, 0x12d, ecc_blocks, 0);
         for (i = 0; i < blocks; i++) {
             for (j = 0; j < data_blocks; j++) {
                 sub_data[j] = target[j * blocks + i];
             }
-            rs_encode_uint(&rs, data_blocks, sub_data, sub_ecc);
+            rs_encode_uint(p_rs, data_blocks, sub_data, sub_ecc);
             for (j = 0; j < ecc_blocks; j++) {
                 target[data_cw + j * blocks + i] = sub_ecc[ecc_blocks - 1 - j];
             }
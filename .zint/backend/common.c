@@ -31,6 +31,11 @@
 /* SPDX-License-Identifier: BSD-3-Clause */
 
 #include <assert.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
 #ifdef ZINT_TEST
 #include <stdio.h>
 #endif
@@ -572,6 +577,20 @@ INTERNAL int colour_to_green(const int colour) {
     return return_val;
 }
 
+/* Returns a monotonic time in milliseconds, for `BARCODE_TIMINGS` */
+INTERNAL double monotonic_ms(void) {
+#ifdef _WIN32
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (double) counter.QuadPart * 1000.0 / (double) frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1000.0 + (double) ts.tv_nsec / 1000000.0;
+#endif
+}
+
 /* Returns blue component if any of ultra colour indexing "0CBMRYGKW" */
 INTERNAL int colour_to_blue(const int colour) {
     int return_val = 0;
@@ -202,6 +202,9 @@ extern "C" {
     INTERNAL void segs_cpy(const struct zint_symbol *symbol, const struct zint_seg segs[], const int seg_count,
                 struct zint_seg local_segs[]);
 
+    /* Returns a monotonic time in milliseconds, for `BARCODE_TIMINGS` */
+    INTERNAL double monotonic_ms(void);
+
     INTERNAL int colour_to_red(const int colour);
     INTERNAL int colour_to_green(const int colour);
     INTERNAL int colour_to_blue(const int colour);
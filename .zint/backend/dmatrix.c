@@ -170,15 +170,15 @@ static void dm_ecc(unsigned char *binary, const int bytes, const int datablock,
     int rsblocks = rsblock * blocks;
     int n;
     rs_t rs;
+    const rs_t *p_rs;
 
-    rs_init_gf(&rs, 0x12d);
-    rs_init_code(&rs, rsblock, 1);
+    p_rs = rs_init_cached(&rs, 0x12d, rsblock, 1);
     for (b = 0; b < blocks; b++) {
         unsigned char buf[256], ecc[256];
         int p = 0;
         for (n = b; n < bytes; n += blocks)
             buf[p++] = binary[n];
-        rs_encode(&rs, p, buf, ecc);
+        rs_encode(p_rs, p, buf, ecc);
         p = rsblock - 1; /* comes back reversed */
         for (n = b; n < rsblocks; n += blocks) {
             if (skew) {
@@ -685,21 +685,40 @@ static int dm_switch_mode(const int next_mode, unsigned char target[], int tp, i
 
 static const char *dm_smodes[] = { "?", "ASCII", "C40", "TEXT", "X12", "EDF", "B256" };
 
-/* The size of this structure could be significantly reduced using techniques pointed out by Alex Geller,
-   but not done currently to avoid the processing overhead */
 struct dm_edge {
     unsigned char mode;
     unsigned char endMode; /* Mode returned by `dm_getEndMode()` */
+    unsigned char previous; /* `endMode` of previous edge (at vertex `from`), 0 if none */
     unsigned short from; /* Position in input data, 0-based */
     unsigned short len;
     unsigned short size; /* Cumulative number of codewords */
     unsigned short bytes; /* DM_BASE256 byte count, kept to avoid runtime calc */
-    unsigned short previous; /* Index into edges array */
 };
 
-/* Note 1st row of edges not used so valid previous cannot point there, i.e. won't be zero */
-#define DM_PREVIOUS(edges, edge) \
-    ((edge)->previous ? (edges) + (edge)->previous : NULL)
+/* The edges kept at the vertices (position, `endMode`), as arrays of their fields indexed by
+   `position * DM_NUM_MODES + endMode - 1`. `from` and `endMode` are implied by the index, and `mode` and `previous`
+   are packed into a path byte, which is zero if no edge */
+struct dm_vertices {
+    unsigned char *paths;
+    unsigned short *lens;
+    unsigned short *sizes;
+    unsigned short *bytes;
+};
+
+#define DM_PATH(edge)           ((unsigned char) ((edge)->mode | ((edge)->previous << 3)))
+#define DM_PATH_MODE(path)      ((path) & 0x07)
+#define DM_PATH_PREVIOUS(path)  ((path) >> 3)
+
+/* Set `edge` to the edge kept at vertex index `v_ij` (at `position`) */
+static void dm_getEdge(const struct dm_vertices *vertices, const int position, const int v_ij, struct dm_edge *edge) {
+    edge->mode = DM_PATH_MODE(vertices->paths[v_ij]);
+    edge->endMode = v_ij % DM_NUM_MODES + 1;
+    edge->previous = DM_PATH_PREVIOUS(vertices->paths[v_ij]);
+    edge->len = vertices->lens[v_ij];
+    edge->from = position - edge->len;
+    edge->size = vertices->sizes[v_ij];
+    edge->bytes = vertices->bytes[v_ij];
+}
 
 /* Determine if next 1 to 4 chars are at EOD and can be encoded as 1 or 2 ASCII codewords */
 static int dm_last_ascii(const unsigned char source[], const int length, const int from) {
@@ -794,8 +813,8 @@ static int dm_getNumberOfC40Words(const unsigned char *source, const int length,
 
 /* Initialize a new edge. Returns endMode */
 static int dm_new_Edge(struct zint_symbol *symbol, const unsigned char *source, const int length,
-            struct dm_edge *edges, const int mode, const int from, const int len, struct dm_edge *previous,
-            struct dm_edge *edge, const int cwds) {
+            const int mode, const int from, const int len, const struct dm_edge *previous, struct dm_edge *edge,
+            const int cwds) {
     int previousMode;
     int size;
     int last_ascii, symbols_left;
@@ -808,7 +827,7 @@ static int dm_new_Edge(struct zint_symbol *symbol, const unsigned char *source,
     if (previous) {
         assert(previous->mode && previous->len && previous->size && previous->endMode);
         previousMode = previous->endMode;
-        edge->previous = previous - edges;
+        edge->previous = previous->endMode;
         size = previous->size;
     } else {
         previousMode = DM_ASCII;
@@ -905,24 +924,27 @@ static int dm_new_Edge(struct zint_symbol *symbol, const unsigned char *source,
 
 /* Add an edge for a mode at a vertex if no existing edge or if more optimal than existing edge */
 static void dm_addEdge(struct zint_symbol *symbol, const unsigned char *source, const int length,
-            struct dm_edge *edges, const int mode, const int from, const int len, struct dm_edge *previous,
-            const int cwds) {
+            struct dm_vertices *vertices, const int mode, const int from, const int len,
+            const struct dm_edge *previous, const int cwds) {
     struct dm_edge edge;
-    const int endMode = dm_new_Edge(symbol, source, length, edges, mode, from, len, previous, &edge, cwds);
+    const int endMode = dm_new_Edge(symbol, source, length, mode, from, len, previous, &edge, cwds);
     const int vertexIndex = from + len;
     const int v_ij = vertexIndex * DM_NUM_MODES + endMode - 1;
 
-    if (edges[v_ij].mode == 0 || edges[v_ij].size > edge.size) {
-        DM_TRACE_AddEdge(source, length, edges, previous, vertexIndex, &edge);
-        edges[v_ij] = edge;
+    if (vertices->paths[v_ij] == 0 || vertices->sizes[v_ij] > edge.size) {
+        DM_TRACE_AddEdge(source, length, vertices, previous, vertexIndex, &edge);
+        vertices->paths[v_ij] = DM_PATH(&edge);
+        vertices->lens[v_ij] = edge.len;
+        vertices->sizes[v_ij] = edge.size;
+        vertices->bytes[v_ij] = edge.bytes;
     } else {
-        DM_TRACE_NotAddEdge(source, length, edges, previous, vertexIndex, v_ij, &edge);
+        DM_TRACE_NotAddEdge(source, length, vertices, previous, vertexIndex, v_ij, &edge);
     }
 }
 
 /* Add edges for the various modes at a vertex */
 static void dm_addEdges(struct zint_symbol *symbol, const unsigned char source[], const int length,
-            struct dm_edge *edges, const int from, struct dm_edge *previous, const int gs1) {
+            struct dm_vertices *vertices, const int from, const struct dm_edge *previous, const int gs1) {
     int i, pos;
 
     /* Not possible to unlatch a full EDF edge to something else */
@@ -931,29 +953,29 @@ static void dm_addEdges(struct zint_symbol *symbol, const unsigned char source[]
         static const int c40text_modes[] = { DM_C40, DM_TEXT };
 
         if (z_isdigit(source[from]) && from + 1 < length && z_isdigit(source[from + 1])) {
-            dm_addEdge(symbol, source, length, edges, DM_ASCII, from, 2, previous, 0);
+            dm_addEdge(symbol, source, length, vertices, DM_ASCII, from, 2, previous, 0);
             /* If ASCII vertex, don't bother adding other edges as this will be optimal; suggested by Alex Geller */
             if (previous && previous->mode == DM_ASCII) {
                 return;
             }
         } else {
-            dm_addEdge(symbol, source, length, edges, DM_ASCII, from, 1, previous, 0);
+            dm_addEdge(symbol, source, length, vertices, DM_ASCII, from, 1, previous, 0);
         }
 
         for (i = 0; i < ARRAY_SIZE(c40text_modes); i++) {
             int len;
             int cwds = dm_getNumberOfC40Words(source, length, from, c40text_modes[i], &len);
             if (cwds) {
-                dm_addEdge(symbol, source, length, edges, c40text_modes[i], from, len, previous, cwds);
+                dm_addEdge(symbol, source, length, vertices, c40text_modes[i], from, len, previous, cwds);
             }
         }
 
         if (from + 2 < length && dm_isX12(source[from]) && dm_isX12(source[from + 1]) && dm_isX12(source[from + 2])) {
-            dm_addEdge(symbol, source, length, edges, DM_X12, from, 3, previous, 0);
+            dm_addEdge(symbol, source, length, vertices, DM_X12, from, 3, previous, 0);
         }
 
         if (gs1 != 1 || source[from] != '[') {
-            dm_addEdge(symbol, source, length, edges, DM_BASE256, from, 1, previous, 0);
+            dm_addEdge(symbol, source, length, vertices, DM_BASE256, from, 1, previous, 0);
         }
     }
 
@@ -961,7 +983,7 @@ static void dm_addEdges(struct zint_symbol *symbol, const unsigned char source[]
         /* We create 3 EDF edges, 2, 3 or 4 characters length. The 4-char normally doesn't have a latch to ASCII
            unless it is 2 characters away from the end of the input. */
         for (i = 1, pos = from + i; i < 4 && pos < length && dm_isedifact(source[pos], gs1); i++, pos++) {
-            dm_addEdge(symbol, source, length, edges, DM_EDIFACT, from, i + 1, previous, 0);
+            dm_addEdge(symbol, source, length, vertices, DM_EDIFACT, from, i + 1, previous, 0);
         }
     }
 }
@@ -972,39 +994,47 @@ static int dm_define_mode(struct zint_symbol *symbol, char modes[], const unsign
 
     int i, j, v_i;
     int minimalJ, minimalSize;
-    struct dm_edge *edge;
-    int current_mode;
-    int mode_end, mode_len;
+    struct dm_edge edge;
+    struct dm_vertices vertices;
+    const int vertices_size = (length + 1) * DM_NUM_MODES;
+    unsigned char *buf;
 
-    struct dm_edge *edges = (struct dm_edge *) calloc((length + 1) * DM_NUM_MODES, sizeof(struct dm_edge));
-    if (!edges) {
+    /* Allocate the arrays in one go, the shorts first for alignment, only the paths needing clearing */
+    if (!(buf = (unsigned char *) malloc(vertices_size * (sizeof(unsigned short) * 3 + 1)))) {
         return 0;
     }
-    dm_addEdges(symbol, source, length, edges, 0, NULL, gs1);
+    vertices.lens = (unsigned short *) buf;
+    vertices.sizes = vertices.lens + vertices_size;
+    vertices.bytes = vertices.sizes + vertices_size;
+    vertices.paths = (unsigned char *) (vertices.bytes + vertices_size);
+    memset(vertices.paths, 0, vertices_size);
+
+    dm_addEdges(symbol, source, length, &vertices, 0, NULL, gs1);
 
-    DM_TRACE_Edges("DEBUG Initial situation\n", source, length, edges, 0);
+    DM_TRACE_Edges("DEBUG Initial situation\n", source, length, &vertices, 0);
 
     for (i = 1; i < length; i++) {
         v_i = i * DM_NUM_MODES;
         for (j = 0; j < DM_NUM_MODES; j++) {
-            if (edges[v_i + j].mode) {
-                dm_addEdges(symbol, source, length, edges, i, edges + v_i + j, gs1);
+            if (vertices.paths[v_i + j]) {
+                dm_getEdge(&vertices, i, v_i + j, &edge);
+                dm_addEdges(symbol, source, length, &vertices, i, &edge, gs1);
             }
         }
-        DM_TRACE_Edges("DEBUG situation after adding edges to vertices at position %d\n", source, length, edges, i);
+        DM_TRACE_Edges("DEBUG situation after adding edges to vertices at position %d\n", source, length, &vertices,
+                        i);
     }
 
-    DM_TRACE_Edges("DEBUG Final situation\n", source, length, edges, length);
+    DM_TRACE_Edges("DEBUG Final situation\n", source, length, &vertices, length);
 
     v_i = length * DM_NUM_MODES;
     minimalJ = -1;
     minimalSize = INT_MAX;
     for (j = 0; j < DM_NUM_MODES; j++) {
-        edge = edges + v_i + j;
-        if (edge->mode) {
-            if (debug_print) printf("edges[%d][%d][0] size %d\n", length, j, edge->size);
-            if (edge->size < minimalSize) {
-                minimalSize = edge->size;
+        if (vertices.paths[v_i + j]) {
+            if (debug_print) printf("edges[%d][%d][0] size %d\n", length, j, vertices.sizes[v_i + j]);
+            if (vertices.sizes[v_i + j] < minimalSize) {
+                minimalSize = vertices.sizes[v_i + j];
                 minimalJ = j;
                 if (debug_print) printf(" set minimalJ %d\n", minimalJ);
             }
@@ -1014,29 +1044,24 @@ static int dm_define_mode(struct zint_symbol *symbol, char modes[], const unsign
     }
     assert(minimalJ >= 0);
 
-    edge = edges + v_i + minimalJ;
-    mode_len = 0;
-    mode_end = length;
-    while (edge) {
-        current_mode = edge->mode;
-        mode_len += edge->len;
-        edge = DM_PREVIOUS(edges, edge);
-        if (!edge || edge->mode != current_mode) {
-            for (i = mode_end - mode_len; i < mode_end; i++) {
-                modes[i] = current_mode;
-            }
-            mode_end = mode_end - mode_len;
-            mode_len = 0;
-        }
+    /* Follow the path back from the end */
+    for (i = length, j = minimalJ; i > 0; ) {
+        const int v_ij = i * DM_NUM_MODES + j;
+        const int mode = DM_PATH_MODE(vertices.paths[v_ij]);
+        const int from = i - vertices.lens[v_ij];
+        assert(mode && from >= 0);
+        memset(modes + from, mode, i - from);
+        j = DM_PATH_PREVIOUS(vertices.paths[v_ij]) - 1;
+        i = from;
+        assert((i == 0) == (j == -1));
     }
     if (debug_print) {
         printf("modes (%d): ", length);
         for (i = 0; i < length; i++) printf("%c", dm_smodes[(int) modes[i]][0]);
         printf("\n");
     }
-    assert(mode_end == 0);
 
-    free(edges);
+    free(buf);
 
     return 1;
 }
@@ -1053,7 +1078,7 @@ static int dm_minimalenc(struct zint_symbol *symbol, const unsigned char source[
     int i;
     char *modes = (char *) z_alloca(length);
 
-    assert(length <= 10921); /* Can only handle (10921 + 1) * 6 = 65532 < 65536 (2*16) due to sizeof(previous) */
+    assert(length <= 65535); /* Due to sizeof(from) */
 
     if (!dm_define_mode(symbol, modes, source, length, gs1, debug_print)) {
         strcpy(symbol->errtxt, "728: Insufficient memory for mode buffers");
@@ -35,27 +35,26 @@
 #define Z_DMATRIX_TRACE_H
 
 #ifndef DM_TRACE
-#define DM_TRACE_Edges(px, s, l, p, v)
-#define DM_TRACE_AddEdge(s, l, es, p, v, e)
-#define DM_TRACE_NotAddEdge(s, l, es, p, v, ij, e)
+#define DM_TRACE_Edges(px, s, l, vs, v)
+#define DM_TRACE_AddEdge(s, l, vs, p, v, e)
+#define DM_TRACE_NotAddEdge(s, l, vs, p, v, ij, e)
 #else
 
-static int DM_TRACE_getPreviousMode(struct dm_edge *edges, struct dm_edge *edge) {
-    struct dm_edge *previous = DM_PREVIOUS(edges, edge);
-    return previous == NULL ? DM_ASCII : previous->endMode;
+static int DM_TRACE_getPreviousMode(const struct dm_edge *edge) {
+    return edge->previous == 0 ? DM_ASCII : edge->previous;
 }
 
 static void DM_TRACE_VertexToString(const unsigned char *source, const int length, const int position,
-            struct dm_edge *edge) {
+            const struct dm_edge *edge) {
     if (position >= length) {
         printf("end mode %s", dm_smodes[edge->mode]);
     } else {
         printf("char '%c' at %d mode %s", source[position], position, dm_smodes[edge->mode]);
     }
 }
-static void DM_TRACE_EdgeToString(char *buf, const unsigned char *source, const int length, struct dm_edge *edges,
-            struct dm_edge *edge) {
-    int previousMode = DM_TRACE_getPreviousMode(edges, edge);
+static void DM_TRACE_EdgeToString(char *buf, const unsigned char *source, const int length,
+            const struct dm_edge *edge) {
+    int previousMode = DM_TRACE_getPreviousMode(edge);
     (void)length;
     if (buf) {
         sprintf(buf, "%d_%s %s(%.*s) (%d) --> %d_%s",
@@ -68,15 +67,16 @@ static void DM_TRACE_EdgeToString(char *buf, const unsigned char *source, const
     }
 }
 
-static void DM_TRACE_Path(const unsigned char *source, const int length, struct dm_edge *edges,
-            struct dm_edge *edge, char *result, const int result_size) {
-    DM_TRACE_EdgeToString(result, source, length, edges, edge);
-    struct dm_edge *current = DM_PREVIOUS(edges, edge);
-    while (current) {
+static void DM_TRACE_Path(const unsigned char *source, const int length, const struct dm_vertices *vertices,
+            const struct dm_edge *edge, char *result, const int result_size) {
+    struct dm_edge current = *edge;
+    DM_TRACE_EdgeToString(result, source, length, edge);
+    while (current.previous) {
         char s[256];
         char *pos;
         int len;
-        DM_TRACE_EdgeToString(s, source, length, edges, current);
+        dm_getEdge(vertices, current.from, current.from * DM_NUM_MODES + current.previous - 1, &current);
+        DM_TRACE_EdgeToString(s, source, length, &current);
         pos = strrchr(s, ' ');
         assert(pos);
         len = strlen(result);
@@ -87,40 +87,42 @@ static void DM_TRACE_Path(const unsigned char *source, const int length, struct
         }
         memmove(result + (pos - s) + 1, result, len + 1);
         memcpy(result, s, (pos - s) + 1);
-        current = DM_PREVIOUS(edges, current);
     }
     puts(result);
 }
 
 static void DM_TRACE_Edges(const char *prefix, const unsigned char *source, const int length,
-            struct dm_edge *edges, const int vertexIndex) {
-    int i, j, e_i;
+            const struct dm_vertices *vertices, const int vertexIndex) {
+    int i, j, v_i;
     char result[1024 * 2];
+    struct dm_edge edge;
     if (vertexIndex) {
         printf(prefix, vertexIndex);
     } else {
         fputs(prefix, stdout);
     }
     for (i = vertexIndex; i <= length; i++) {
-        e_i = i * DM_NUM_MODES;
+        v_i = i * DM_NUM_MODES;
         for (j = 0; j < DM_NUM_MODES; j++) {
-            if (edges[e_i + j].mode) {
+            if (vertices->paths[v_i + j]) {
                 fputs("DEBUG ", stdout);
-                DM_TRACE_Path(source, length, edges, edges + e_i + j, result, (int) ARRAY_SIZE(result));
+                dm_getEdge(vertices, i, v_i + j, &edge);
+                DM_TRACE_Path(source, length, vertices, &edge, result, (int) ARRAY_SIZE(result));
             }
         }
     }
 }
 
-static void DM_TRACE_AddEdge(const unsigned char *source, const int length, struct dm_edge *edges,
-            struct dm_edge *previous, const int vertexIndex, struct dm_edge *edge) {
+static void DM_TRACE_AddEdge(const unsigned char *source, const int length, const struct dm_vertices *vertices,
+            const struct dm_edge *previous, const int vertexIndex, const struct dm_edge *edge) {
+    (void)vertices;
     if (previous == NULL) {
         fputs("DEBUG add ", stdout);
-        DM_TRACE_EdgeToString(NULL, source, length, edges, edge);
+        DM_TRACE_EdgeToString(NULL, source, length, edge);
         printf(" from %d to %d size %d\n", edge->from, vertexIndex, edge->size);
     } else {
         fputs("DEBUG add ", stdout);
-        DM_TRACE_EdgeToString(NULL, source, length, edges, edge);
+        DM_TRACE_EdgeToString(NULL, source, length, edge);
         fputs(" from ", stdout);
         DM_TRACE_VertexToString(source, length, previous->from, previous);
         fputs(" to ", stdout);
@@ -129,24 +131,26 @@ static void DM_TRACE_AddEdge(const unsigned char *source, const int length, stru
     }
 }
 
-static void DM_TRACE_NotAddEdge(const unsigned char *source, const int length, struct dm_edge *edges,
-            struct dm_edge *previous, const int vertexIndex, const int e_ij, struct dm_edge *edge) {
+static void DM_TRACE_NotAddEdge(const unsigned char *source, const int length, const struct dm_vertices *vertices,
+            const struct dm_edge *previous, const int vertexIndex, const int v_ij, const struct dm_edge *edge) {
+    struct dm_edge kept;
+    dm_getEdge(vertices, vertexIndex, v_ij, &kept);
     if (previous == NULL) {
         fputs("DEBUG not add ", stdout);
-        DM_TRACE_EdgeToString(NULL, source, length, edges, edge);
+        DM_TRACE_EdgeToString(NULL, source, length, edge);
         printf(" from %d to %d size %d since ", edge->from, vertexIndex, edge->size);
-        DM_TRACE_EdgeToString(NULL, source, length, edges, edges + e_ij);
-        printf(" < size %d\n", edges[e_ij].size);
+        DM_TRACE_EdgeToString(NULL, source, length, &kept);
+        printf(" < size %d\n", kept.size);
     } else {
         fputs("DEBUG not add ", stdout);
-        DM_TRACE_EdgeToString(NULL, source, length, edges, edge);
+        DM_TRACE_EdgeToString(NULL, source, length, edge);
         fputs(" from ", stdout);
         DM_TRACE_VertexToString(source, length, previous->from, previous);
         fputs(" to ", stdout);
         DM_TRACE_VertexToString(source, length, vertexIndex, edge);
         printf(" size %d since ", edge->size);
-        DM_TRACE_EdgeToString(NULL, source, length, edges, edges + e_ij);
-        printf(" < size %d\n", edges[e_ij].size);
+        DM_TRACE_EdgeToString(NULL, source, length, &kept);
+        printf(" < size %d\n", kept.size);
     }
 }
 
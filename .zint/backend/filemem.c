@@ -0,0 +1,545 @@
+/*  filemem.c - write to file/memory abstraction
+
+    libzint - the open source barcode library
+    Copyright (C) 2022 Robin Stuart <rstuart114@gmail.com>
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+
+    1. Redistributions of source code must retain the above copyright
+       notice, this list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+    3. Neither the name of the project nor the names of its contributors
+       may be used to endorse or promote products derived from this software
+       without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+    OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+    HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+    OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+ */
+/* SPDX-License-Identifier: BSD-3-Clause */
+
+#include <assert.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _MSC_VER
+#include <io.h>
+#include <fcntl.h>
+#endif
+#include "filemem.h"
+
+#define FM_PAGE_SIZE 0x1000 /* Initial size of memory buffer, doubled as needed */
+
+/* Set `fmp->err` if not already set (the first error is the one reported) */
+static void fm_seterr(struct filemem *const fmp, const int err) {
+    if (!fmp->err) {
+        fmp->err = err ? err : EIO;
+    }
+}
+
+/* Ensure there is room to write `size` bytes at the current position of the memory buffer */
+static int fm_mem_expand(struct filemem *const fmp, const size_t size) {
+    size_t new_size = fmp->memsize;
+    unsigned char *new_mem;
+
+    if (fmp->err) {
+        return 0;
+    }
+    if (size > (size_t) INT_MAX - fmp->mempos) { /* `symbol->memfile_size` is an int */
+        fm_seterr(fmp, EFBIG);
+        return 0;
+    }
+    if (fmp->mempos + size <= fmp->memsize) {
+        return 1;
+    }
+    while (new_size < fmp->mempos + size) {
+        new_size = new_size > (size_t) INT_MAX / 2 ? (size_t) INT_MAX + 1 : new_size * 2;
+    }
+    if (!(new_mem = (unsigned char *) realloc(fmp->mem, new_size))) {
+        fm_seterr(fmp, ENOMEM);
+        return 0;
+    }
+    fmp->mem = new_mem;
+    fmp->memsize = new_size;
+
+    return 1;
+}
+
+/* Advance the memory buffer position by `size` bytes (already written) */
+static void fm_mem_advance(struct filemem *const fmp, const size_t size) {
+    fmp->mempos += size;
+    if (fmp->mempos > fmp->memend) {
+        fmp->memend = fmp->mempos;
+    }
+}
+
+/* Set `fmp->decimal` to the decimal point of the current locale, if it is not "." (`localeconv()` and
+   `setlocale()` are not thread-safe, so it is found by formatting a number, which is) */
+static void fm_set_decimal(struct filemem *const fmp) {
+    char buf[16];
+    int len = snprintf(buf, sizeof(buf), "%.1f", 0.5);
+
+    if (len >= 3 && len < (int) sizeof(buf) && (len != 3 || buf[1] != '.')) {
+        /* Strip the leading "0" and trailing "5" */
+        len -= 2;
+        if (len < (int) sizeof(fmp->decimal)) {
+            memcpy(fmp->decimal, buf + 1, len);
+            fmp->decimal[len] = '\0';
+        }
+    }
+}
+
+/* `fopen()` equivalent. Returns 1 on success, 0 on failure (with `fmp->err` set) */
+INTERNAL int fm_open(struct filemem *const fmp, struct zint_symbol *symbol, const char *mode) {
+    assert(fmp && symbol && mode);
+
+    memset(fmp, 0, sizeof(*fmp));
+    fm_set_decimal(fmp);
+
+    if (symbol->output_options & BARCODE_MEMORY_FILE) {
+        if (!(fmp->mem = (unsigned char *) malloc(FM_PAGE_SIZE))) {
+            fm_seterr(fmp, ENOMEM);
+            return 0;
+        }
+        fmp->memsize = FM_PAGE_SIZE;
+        fmp->flags = BARCODE_MEMORY_FILE;
+        return 1;
+    }
+    if (symbol->output_options & BARCODE_STDOUT) {
+#ifdef _MSC_VER
+        if (strchr(mode, 'b') && _setmode(_fileno(stdout), _O_BINARY) == -1) {
+            fm_seterr(fmp, errno);
+            return 0;
+        }
+#endif
+        fmp->fp = stdout;
+        fmp->flags = BARCODE_STDOUT;
+        return 1;
+    }
+    if (!(fmp->fp = fopen(symbol->outfile, mode))) {
+        fm_seterr(fmp, errno);
+        return 0;
+    }
+    return 1;
+}
+
+/* `fwrite()` equivalent. Returns number of items written */
+INTERNAL size_t fm_write(const void *ptr, size_t size, size_t nitems, struct filemem *const fmp) {
+    size_t ret;
+
+    assert(fmp && ptr);
+
+    if (size == 0 || nitems == 0) {
+        return 0;
+    }
+    if (fmp->mem) {
+        if (nitems > (size_t) INT_MAX / size) {
+            fm_seterr(fmp, EFBIG);
+            return 0;
+        }
+        if (!fm_mem_expand(fmp, size * nitems)) {
+            return 0;
+        }
+        memcpy(fmp->mem + fmp->mempos, ptr, size * nitems);
+        fm_mem_advance(fmp, size * nitems);
+        return nitems;
+    }
+    if ((ret = fwrite(ptr, size, nitems, fmp->fp)) != nitems) {
+        fm_seterr(fmp, errno);
+    }
+    return ret;
+}
+
+/* `fputc()` equivalent. Returns `ch` on success, EOF on failure */
+INTERNAL int fm_putc(const int ch, struct filemem *const fmp) {
+    assert(fmp);
+
+    if (fmp->mem) {
+        if (!fm_mem_expand(fmp, 1)) {
+            return EOF;
+        }
+        fmp->mem[fmp->mempos] = (unsigned char) ch;
+        fm_mem_advance(fmp, 1);
+        return ch;
+    }
+    if (fputc(ch, fmp->fp) == EOF) {
+        fm_seterr(fmp, errno);
+        return EOF;
+    }
+    return ch;
+}
+
+/* `fputs()` equivalent. Returns non-negative on success, EOF on failure */
+INTERNAL int fm_puts(const char *str, struct filemem *const fmp) {
+    assert(fmp && str);
+
+    if (fmp->mem) {
+        const size_t len = strlen(str);
+
+        if (len == 0) {
+            return 0;
+        }
+        return fm_write(str, 1, len, fmp) == len ? 0 : EOF;
+    }
+    if (fputs(str, fmp->fp) == EOF) {
+        fm_seterr(fmp, errno);
+        return EOF;
+    }
+    return 0;
+}
+
+/* Format a single conversion `spec` of `value`, preceded by the `nstars` width/precision args `stars` */
+#define FM_FORMAT(buf, size, value) \
+    (nstars == 0 ? snprintf(buf, size, spec, value) \
+        : nstars == 1 ? snprintf(buf, size, spec, stars[0], value) \
+        : snprintf(buf, size, spec, stars[0], stars[1], value))
+
+/* `fm_printf()` for locales whose decimal point is not ".": formats each conversion on its own, replacing the
+   decimal point of floating-point ones by ".", so that the output doesn't depend on the locale (as required by
+   SVG and EPS). Only the conversions of the C90 `printf()` (with the "l" length modifier) are supported */
+static int fm_vprintf_c(struct filemem *const fmp, const char *format, va_list ap) {
+    const size_t decimal_len = strlen(fmp->decimal);
+    const char *s = format;
+    char spec[32];
+    char local[128];
+    int total = 0;
+
+    while (*s) {
+        const char *start = s;
+        char *buf = local;
+        int stars[2];
+        int nstars = 0;
+        int is_long = 0;
+        int is_float = 0;
+        size_t spec_len;
+        int ret;
+
+        if (*s != '%') {
+            while (*s && *s != '%') {
+                s++;
+            }
+            if (fm_write(start, 1, s - start, fmp) != (size_t) (s - start)) {
+                return -1;
+            }
+            total += (int) (s - start);
+            continue;
+        }
+        if (s[1] == '%') {
+            if (fm_putc('%', fmp) == EOF) {
+                return -1;
+            }
+            total++;
+            s += 2;
+            continue;
+        }
+
+        /* Flags, width, precision and length modifier */
+        for (s++; *s && strchr("-+ #0", *s); s++);
+        for (; *s == '*' || (*s >= '0' && *s <= '9') || *s == '.'; s++) {
+            if (*s == '*' && nstars < 2) {
+                stars[nstars++] = va_arg(ap, int);
+            }
+        }
+        if (*s == 'l') {
+            is_long = 1;
+            s++;
+        }
+        assert(*s && strchr("diouxXcsfFeEgGp", *s));
+        if (!*s) {
+            break;
+        }
+        spec_len = s + 1 - start;
+        assert(spec_len < sizeof(spec));
+        if (spec_len >= sizeof(spec)) {
+            fm_seterr(fmp, EINVAL);
+            return -1;
+        }
+        memcpy(spec, start, spec_len);
+        spec[spec_len] = '\0';
+
+        /* Format into `local`, or if it doesn't fit, into an allocated buffer (as with `vsnprintf()`, `ap` can
+           only be read once, so the value is fetched before formatting) */
+        switch (*s) {
+            case 'd': case 'i': case 'c':
+                if (is_long) {
+                    const long value = va_arg(ap, long);
+                    if ((ret = FM_FORMAT(local, sizeof(local), value)) >= (int) sizeof(local)
+                            && (buf = (char *) malloc(ret + 1))) {
+                        ret = FM_FORMAT(buf, ret + 1, value);
+                    }
+                } else {
+                    const int value = va_arg(ap, int);
+                    if ((ret = FM_FORMAT(local, sizeof(local), value)) >= (int) sizeof(local)
+                            && (buf = (char *) malloc(ret + 1))) {
+                        ret = FM_FORMAT(buf, ret + 1, value);
+                    }
+                }
+                break;
+            case 'o': case 'u': case 'x': case 'X':
+                if (is_long) {
+                    const unsigned long value = va_arg(ap, unsigned long);
+                    if ((ret = FM_FORMAT(local, sizeof(local), value)) >= (int) sizeof(local)
+                            && (buf = (char *) malloc(ret + 1))) {
+                        ret = FM_FORMAT(buf, ret + 1, value);
+                    }
+                } else {
+                    const unsigned int value = va_arg(ap, unsigned int);
+                    if ((ret = FM_FORMAT(local, sizeof(local), value)) >= (int) sizeof(local)
+                            && (buf = (char *) malloc(ret + 1))) {
+                        ret = FM_FORMAT(buf, ret + 1, value);
+                    }
+                }
+                break;
+            case 's': {
+                const char *const value = va_arg(ap, const char *);
+                if ((ret = FM_FORMAT(local, sizeof(local), value)) >= (int) sizeof(local)
+                        && (buf = (char *) malloc(ret + 1))) {
+                    ret = FM_FORMAT(buf, ret + 1, value);
+                }
+                break;
+            }
+            case 'p': {
+                void *const value = va_arg(ap, void *);
+                if ((ret = FM_FORMAT(local, sizeof(local), value)) >= (int) sizeof(local)
+                        && (buf = (char *) malloc(ret + 1))) {
+                    ret = FM_FORMAT(buf, ret + 1, value);
+                }
+                break;
+            }
+            default: {
+                const double value = va_arg(ap, double);
+                if ((ret = FM_FORMAT(local, sizeof(local), value)) >= (int) sizeof(local)
+                        && (buf = (char *) malloc(ret + 1))) {
+                    ret = FM_FORMAT(buf, ret + 1, value);
+                }
+                is_float = 1;
+                break;
+            }
+        }
+        s++;
+
+        if (!buf) {
+            fm_seterr(fmp, ENOMEM);
+            return -1;
+        }
+        if (ret < 0) {
+            fm_seterr(fmp, errno);
+        } else {
+            if (is_float) {
+                char *const point = strstr(buf, fmp->decimal);
+                if (point) {
+                    *point = '.';
+                    memmove(point + 1, point + decimal_len, ret - (point + decimal_len - buf) + 1);
+                    ret -= (int) decimal_len - 1;
+                }
+            }
+            if (fm_write(buf, 1, ret, fmp) != (size_t) ret && ret) {
+                ret = -1;
+            }
+        }
+        if (buf != local) {
+            free(buf);
+        }
+        if (ret < 0) {
+            return -1;
+        }
+        total += ret;
+    }
+
+    return fm_error(fmp) ? -1 : total;
+}
+
+#undef FM_FORMAT
+
+/* `fprintf()` equivalent. Returns number of characters written, or negative on failure. Floating-point
+   conversions always use "." as decimal point, whatever the locale */
+INTERNAL int fm_printf(struct filemem *const fmp, const char *format, ...) {
+    va_list ap;
+    size_t avail;
+    int ret;
+
+    assert(fmp && format);
+
+    if (fmp->decimal[0]) {
+        va_start(ap, format);
+        ret = fm_vprintf_c(fmp, format, ap);
+        va_end(ap);
+        return ret;
+    }
+
+    if (!fmp->mem) {
+        va_start(ap, format);
+        ret = vfprintf(fmp->fp, format, ap);
+        va_end(ap);
+        if (ret < 0) {
+            fm_seterr(fmp, errno);
+        }
+        return ret;
+    }
+
+    if (fmp->err) {
+        return -1;
+    }
+
+    if (fmp->mempos < fmp->memend) {
+        /* After an `fm_seek()` back, the terminating NUL written by `vsnprintf()` could overwrite a byte of the
+           previous output, so format into a scratch buffer instead */
+        char local[256];
+        char *buf = local;
+
+        va_start(ap, format);
+        ret = vsnprintf(local, sizeof(local), format, ap);
+        va_end(ap);
+        if (ret >= (int) sizeof(local)) {
+            if (!(buf = (char *) malloc((size_t) ret + 1))) {
+                fm_seterr(fmp, ENOMEM);
+                return -1;
+            }
+            va_start(ap, format);
+            ret = vsnprintf(buf, (size_t) ret + 1, format, ap);
+            va_end(ap);
+        }
+        if (ret < 0) {
+            fm_seterr(fmp, errno);
+        } else if (fm_write(buf, 1, (size_t) ret, fmp) != (size_t) ret) {
+            ret = -1;
+        }
+        if (buf != local) {
+            free(buf);
+        }
+        return ret;
+    }
+
+    /* Format straight into the buffer, expanding and formatting again only if it doesn't fit */
+    avail = fmp->memsize - fmp->mempos;
+    va_start(ap, format);
+    ret = vsnprintf((char *) fmp->mem + fmp->mempos, avail, format, ap);
+    va_end(ap);
+    if (ret < 0) {
+        fm_seterr(fmp, errno);
+        return ret;
+    }
+    if ((size_t) ret >= avail) {
+        if (!fm_mem_expand(fmp, (size_t) ret + 1)) {
+            return -1;
+        }
+        va_start(ap, format);
+        ret = vsnprintf((char *) fmp->mem + fmp->mempos, fmp->memsize - fmp->mempos, format, ap);
+        va_end(ap);
+        if (ret < 0) {
+            fm_seterr(fmp, errno);
+            return ret;
+        }
+    }
+    fm_mem_advance(fmp, (size_t) ret);
+
+    return ret;
+}
+
+/* `ftell()` equivalent. Returns -1 on failure */
+INTERNAL long fm_tell(struct filemem *const fmp) {
+    assert(fmp);
+
+    if (fmp->mem) {
+        return (long) fmp->mempos;
+    }
+    return ftell(fmp->fp);
+}
+
+/* `fseek()` equivalent. Returns 0 on success, -1 on failure. For memory, `SEEK_SET`, `SEEK_CUR` and `SEEK_END` are
+   all supported, but not seeking past the end of the data. Seeking is not supported for stdout */
+INTERNAL int fm_seek(struct filemem *const fmp, const long offset, const int whence) {
+    long pos;
+
+    assert(fmp);
+
+    if (fmp->mem) {
+        if (whence == SEEK_SET) {
+            pos = offset;
+        } else if (whence == SEEK_CUR) {
+            pos = (long) fmp->mempos + offset;
+        } else {
+            pos = (long) fmp->memend + offset;
+        }
+        if (pos < 0 || (size_t) pos > fmp->memend) {
+            return -1;
+        }
+        fmp->mempos = (size_t) pos;
+        return 0;
+    }
+    if (fmp->flags & BARCODE_STDOUT) {
+        return -1;
+    }
+    if (fseek(fmp->fp, offset, whence) != 0) {
+        fm_seterr(fmp, errno);
+        return -1;
+    }
+    return 0;
+}
+
+/* `ferror()` equivalent. Returns non-zero if an error has occurred */
+INTERNAL int fm_error(const struct filemem *const fmp) {
+    assert(fmp);
+
+    return fmp->err != 0 || (fmp->fp && ferror(fmp->fp));
+}
+
+/* `fclose()` equivalent. For memory, hands the buffer over to `symbol->memfile` (replacing any previous
+   contents), with its length in `symbol->memfile_size`. Returns 1 on success, 0 on failure (with `fmp->err`
+   set) */
+INTERNAL int fm_close(struct filemem *const fmp, struct zint_symbol *symbol) {
+    assert(fmp && symbol);
+
+    if (fmp->mem) {
+        /* NUL-terminate so that text output can be used as a C string (not counted in `memfile_size`) */
+        fmp->mempos = fmp->memend;
+        if (!fm_mem_expand(fmp, 1)) {
+            free(fmp->mem);
+            fmp->mem = NULL;
+            return 0;
+        }
+        fmp->mem[fmp->memend] = '\0';
+
+        if (symbol->memfile) {
+            free(symbol->memfile);
+        }
+        symbol->memfile = fmp->mem;
+        symbol->memfile_size = (int) fmp->memend;
+        fmp->mem = NULL;
+        fmp->memsize = fmp->mempos = fmp->memend = 0;
+        return 1;
+    }
+    if (fmp->fp) {
+        if (fmp->flags & BARCODE_STDOUT) {
+            if (fflush(fmp->fp) != 0) {
+                fm_seterr(fmp, errno);
+            }
+        } else {
+            if (ferror(fmp->fp)) {
+                fm_seterr(fmp, EIO);
+            }
+            if (fclose(fmp->fp) != 0) {
+                fm_seterr(fmp, errno);
+            }
+        }
+        fmp->fp = NULL;
+    }
+    return fmp->err == 0;
+}
+
+/* vim: set ts=4 sw=4 et : */
@@ -0,0 +1,92 @@
+/*  filemem.h - write to file/memory abstraction
+
+    libzint - the open source barcode library
+    Copyright (C) 2022 Robin Stuart <rstuart114@gmail.com>
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+
+    1. Redistributions of source code must retain the above copyright
+       notice, this list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+    3. Neither the name of the project nor the names of its contributors
+       may be used to endorse or promote products derived from this software
+       without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+    OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+    HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+    OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+ */
+/* SPDX-License-Identifier: BSD-3-Clause */
+/* vim: set ts=4 sw=4 et : */
+
+#ifndef Z_FILEMEM_H
+#define Z_FILEMEM_H
+
+#include <stdio.h>
+#include "common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* Output sink used by the file writers (SVG, EPS, EMF, BMP, GIF, PCX, PNG, TIF). Depending on
+   `symbol->output_options`, writes go to an in-memory buffer (`BARCODE_MEMORY_FILE`), to stdout
+   (`BARCODE_STDOUT`) or to the file `symbol->outfile` */
+struct filemem {
+    FILE *fp;           /* File or stdout (NULL if writing to memory) */
+    unsigned char *mem; /* Memory buffer (NULL if writing to file or stdout) */
+    size_t memsize;     /* Allocated size of `mem` */
+    size_t mempos;      /* Current position in `mem` */
+    size_t memend;      /* End of data written to `mem` (may be beyond `mempos` after `fm_seek()`) */
+    int flags;          /* `BARCODE_MEMORY_FILE` or `BARCODE_STDOUT` if set, else 0 */
+    int err;            /* First `errno` value encountered (sticky), 0 if none */
+    char decimal[8];    /* Decimal point of the current locale if not ".", else empty */
+};
+
+/* `fopen()` equivalent. Returns 1 on success, 0 on failure (with `fmp->err` set) */
+INTERNAL int fm_open(struct filemem *const fmp, struct zint_symbol *symbol, const char *mode);
+
+/* `fwrite()` equivalent. Returns number of items written */
+INTERNAL size_t fm_write(const void *ptr, size_t size, size_t nitems, struct filemem *const fmp);
+
+/* `fputc()` equivalent. Returns `ch` on success, EOF on failure */
+INTERNAL int fm_putc(const int ch, struct filemem *const fmp);
+
+/* `fputs()` equivalent. Returns non-negative on success, EOF on failure */
+INTERNAL int fm_puts(const char *str, struct filemem *const fmp);
+
+/* `fprintf()` equivalent. Returns number of characters written, or negative on failure */
+INTERNAL int fm_printf(struct filemem *const fmp, const char *format, ...);
+
+/* `ftell()` equivalent. Returns -1 on failure */
+INTERNAL long fm_tell(struct filemem *const fmp);
+
+/* `fseek()` equivalent. Returns 0 on success, -1 on failure. For memory, `SEEK_SET`, `SEEK_CUR` and `SEEK_END` are
+   all supported, but not seeking past the end of the data. Seeking is not supported for stdout */
+INTERNAL int fm_seek(struct filemem *const fmp, const long offset, const int whence);
+
+/* `ferror()` equivalent. Returns non-zero if an error has occurred */
+INTERNAL int fm_error(const struct filemem *const fmp);
+
+/* `fclose()` equivalent. For memory, hands the buffer over to `symbol->memfile` (replacing any previous
+   contents), with its length in `symbol->memfile_size`. Returns 1 on success, 0 on failure (with `fmp->err`
+   set) */
+INTERNAL int fm_close(struct filemem *const fmp, struct zint_symbol *symbol);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* Z_FILEMEM_H */
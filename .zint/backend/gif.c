@@ -33,10 +33,7 @@
 #include <errno.h>
 #include <stdio.h>
 #include "common.h"
-#ifdef _MSC_VER
-#include <io.h>
-#include <fcntl.h>
-#endif
+#include "filemem.h"
 
 /* Limit initial LZW buffer size to this in expectation that compressed data will fit for typical scalings */
 #define GIF_LZW_PAGE_SIZE   0x100000 /* Megabyte */
@@ -279,7 +276,8 @@ static int gif_lzw(statestruct *pState, int paletteBitSize) {
  */
 INTERNAL int gif_pixel_plot(struct zint_symbol *symbol, unsigned char *pixelbuf) {
     unsigned char outbuf[10];
-    FILE *gif_file;
+    struct filemem fm;
+    struct filemem *const fmp = &fm;
     unsigned short usTemp;
     int byte_out;
     int colourCount;
@@ -291,7 +289,6 @@ INTERNAL int gif_pixel_plot(struct zint_symbol *symbol, unsigned char *pixelbuf)
     statestruct State;
     int transparent_index;
     int bgindex = -1, fgindex = -1;
-    const int output_to_stdout = symbol->output_options & BARCODE_STDOUT;
 
     unsigned char backgroundColourIndex;
     unsigned char RGBCur[3];
@@ -465,19 +462,9 @@ INTERNAL int gif_pixel_plot(struct zint_symbol *symbol, unsigned char *pixelbuf)
     paletteSize = 1 << paletteBitSize;
 
     /* Open output file in binary mode */
-    if (output_to_stdout) {
-#ifdef _MSC_VER
-        if (-1 == _setmode(_fileno(stdout), _O_BINARY)) {
-            sprintf(symbol->errtxt, "610: Could not set stdout to binary (%d: %.30s)", errno, strerror(errno));
-            return ZINT_ERROR_FILE_ACCESS;
-        }
-#endif
-        gif_file = stdout;
-    } else {
-        if (!(gif_file = fopen(symbol->outfile, "wb"))) {
-            sprintf(symbol->errtxt, "611: Could not open output file (%d: %.30s)", errno, strerror(errno));
-            return ZINT_ERROR_FILE_ACCESS;
-        }
+    if (!fm_open(fmp, symbol, "wb")) {
+        sprintf(symbol->errtxt, "611: Could not open output file (%d: %.30s)", fmp->err, strerror(fmp->err));
+        return ZINT_ERROR_FILE_ACCESS;
     }
 
     /* GIF signature (6) */
@@ -485,7 +472,7 @@ INTERNAL int gif_pixel_plot(struct zint_symbol *symbol, unsigned char *pixelbuf)
     if (transparent_index != -1)
         outbuf[4] = '9';
 
-    fwrite(outbuf, 6, 1, gif_file);
+    fm_write(outbuf, 6, 1, fmp);
     /* Screen Descriptor (7) */
     /* Screen Width */
     usTemp = (unsigned short) symbol->bitmap_width;
@@ -520,12 +507,12 @@ INTERNAL int gif_pixel_plot(struct zint_symbol *symbol, unsigned char *pixelbuf)
     outbuf[5] = backgroundColourIndex;
     /* Byte 7 must be 0x00  */
     outbuf[6] = 0x00;
-    fwrite(outbuf, 7, 1, gif_file);
+    fm_write(outbuf, 7, 1, fmp);
     /* Global Color Table (paletteSize*3) */
-    fwrite(paletteRGB, 3*paletteCount, 1, gif_file);
+    fm_write(paletteRGB, 3*paletteCount, 1, fmp);
     /* add unused palette items to fill palette size */
     for (paletteIndex = paletteCount; paletteIndex < paletteSize; paletteIndex++) {
-        fwrite(RGBUnused, 3, 1, gif_file);
+        fm_write(RGBUnused, 3, 1, fmp);
     }
 
     /* Graphic control extension (8) */
@@ -553,7 +540,7 @@ INTERNAL int gif_pixel_plot(struct zint_symbol *symbol, unsigned char *pixelbuf)
         outbuf[6] = (unsigned char) transparent_index;
         /* Block Terminator */
         outbuf[7] = 0;
-        fwrite(outbuf, 8, 1, gif_file);
+        fm_write(outbuf, 8, 1, fmp);
     }
     /* Image Descriptor */
     /* Image separator character = ',' */
@@ -576,15 +563,13 @@ INTERNAL int gif_pixel_plot(struct zint_symbol *symbol, unsigned char *pixelbuf)
      * There is no local color table if its most significant bit is reset.
      */
     outbuf[9] = 0x00;
-    fwrite(outbuf, 10, 1, gif_file);
+    fm_write(outbuf, 10, 1, fmp);
 
     /* prepare state array */
     State.pIn = pixelbuf;
     State.InLen = bitmapSize;
     if (!(State.pOut = (unsigned char *) malloc(lzoutbufSize))) {
-        if (!output_to_stdout) {
-            fclose(gif_file);
-        }
+        (void) fm_close(fmp, symbol);
         strcpy(symbol->errtxt, "614: Insufficient memory for LZW buffer");
         return ZINT_ERROR_MEMORY;
     }
@@ -594,21 +579,19 @@ INTERNAL int gif_pixel_plot(struct zint_symbol *symbol, unsigned char *pixelbuf)
     byte_out = gif_lzw(&State, paletteBitSize);
     if (byte_out <= 0) {
         free(State.pOut);
-        if (!output_to_stdout) {
-            fclose(gif_file);
-        }
+        (void) fm_close(fmp, symbol);
         strcpy(symbol->errtxt, "613: Insufficient memory for LZW buffer");
         return ZINT_ERROR_MEMORY;
     }
-    fwrite((const char *) State.pOut, byte_out, 1, gif_file);
+    fm_write((const char *) State.pOut, byte_out, 1, fmp);
     free(State.pOut);
 
     /* GIF terminator */
-    fputc('\x3b', gif_file);
-    if (output_to_stdout) {
-        fflush(gif_file);
-    } else {
-        fclose(gif_file);
+    fm_putc('\x3b', fmp);
+
+    if (!fm_close(fmp, symbol)) {
+        sprintf(symbol->errtxt, "615: Failure on closing output file (%d: %.30s)", fmp->err, strerror(fmp->err));
+        return ZINT_ERROR_FILE_WRITE;
     }
 
     return 0;
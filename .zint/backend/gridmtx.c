@@ -822,6 +822,7 @@ static void gm_add_ecc(const char binary[], const int data_posn, const int layer
     unsigned char data[1320], block[130];
     unsigned char data_block[115], ecc_block[70];
     rs_t rs;
+    const rs_t *p_rs;
 
     data_cw = gm_data_codewords[((layers - 1) * 5) + (ecc_level - 1)];
 
@@ -857,8 +858,6 @@ static void gm_add_ecc(const char binary[], const int data_posn, const int layer
     b3 = gm_ebeb[((layers - 1) * 20) + ((ecc_level - 1) * 4) + 1];
     e2 = gm_ebeb[((layers - 1) * 20) + ((ecc_level - 1) * 4) + 2];
 
-    rs_init_gf(&rs, 0x89);
-
     /* Split the data into blocks */
     wp = 0;
     for (i = 0; i < (b1 + b2); i++) {
@@ -883,8 +882,8 @@ static void gm_add_ecc(const char binary[], const int data_posn, const int layer
         }
 
         /* Calculate ECC data for this block */
-        rs_init_code(&rs, ecc_size, 1);
-        rs_encode(&rs, data_size, data_block, ecc_block);
+        p_rs = rs_init_cached(&rs, 0x89, ecc_size, 1);
+        rs_encode(p_rs, data_size, data_block, ecc_block);
 
         /* Correct error correction data but in reverse order */
         for (j = 0; j < data_size; j++) {
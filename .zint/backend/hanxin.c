@@ -1120,15 +1120,14 @@ static void hx_add_ecc(unsigned char fullstream[], const unsigned char datastrea
     int output_position = -1;
     const int table_d1_pos = ((version - 1) * 36) + ((ecc_level - 1) * 9);
     rs_t rs;
-
-    rs_init_gf(&rs, 0x163); /* x^8 + x^6 + x^5 + x + 1 = 0 */
+    const rs_t *p_rs;
 
     for (i = 0; i < 3; i++) {
         const int batch_size = hx_table_d1[table_d1_pos + (3 * i)];
         const int data_length = hx_table_d1[table_d1_pos + (3 * i) + 1];
         const int ecc_length = hx_table_d1[table_d1_pos + (3 * i) + 2];
 
-        rs_init_code(&rs, ecc_length, 1);
+        p_rs = rs_init_cached(&rs, 0x163, ecc_length, 1); /* x^8 + x^6 + x^5 + x + 1 = 0 */
 
         for (block = 0; block < batch_size; block++) {
             for (j = 0; j < data_length; j++) {
@@ -1138,7 +1137,7 @@ static void hx_add_ecc(unsigned char fullstream[], const unsigned char datastrea
                 fullstream[output_position] = data_block[j];
             }
 
-            rs_encode(&rs, data_length, data_block, ecc_block);
+            rs_encode(p_rs, data_length, data_block, ecc_block);
 
             for (j = 0; j < ecc_length; j++) {
                 output_position++;
@@ -1156,6 +1155,7 @@ static void hx_set_function_info(unsigned char *grid, const int size, const int
     unsigned char fi_ecc[4];
     int bp = 0;
     rs_t rs;
+    const rs_t *p_rs;
 
     /* Form function information string */
 
@@ -1171,9 +1171,8 @@ static void hx_set_function_info(unsigned char *grid, const int size, const int
         }
     }
 
-    rs_init_gf(&rs, 0x13);
-    rs_init_code(&rs, 4, 1);
-    rs_encode(&rs, 3, fi_cw, fi_ecc);
+    p_rs = rs_init_cached(&rs, 0x13, 4, 1);
+    rs_encode(p_rs, 3, fi_cw, fi_ecc);
 
     for (i = 3; i >= 0; i--) {
         bp = bin_append_posn(fi_ecc[i], 4, function_information, bp);
@@ -36,6 +36,7 @@
 #include <stdio.h>
 #include "common.h"
 #include "eci.h"
+#include "filemem.h"
 #include "gs1.h"
 #include "zfiletypes.h"
 
@@ -77,6 +78,7 @@ struct zint_symbol *ZBarcode_Create(void) {
     symbol->bitmap = NULL;
     symbol->alphamap = NULL;
     symbol->vector = NULL;
+    symbol->memfile = NULL;
 
     return symbol;
 }
@@ -108,6 +110,12 @@ void ZBarcode_Clear(struct zint_symbol *symbol) {
     symbol->bitmap_width = 0;
     symbol->bitmap_height = 0;
     symbol->bitmap_byte_length = 0;
+    if (symbol->memfile != NULL) {
+        free(symbol->memfile);
+        symbol->memfile = NULL;
+    }
+    symbol->memfile_size = 0;
+    memset(&symbol->timings, 0, sizeof(symbol->timings));
 
     /* If there is a rendered version, ensure its memory is released */
     vector_free(symbol);
@@ -121,6 +129,8 @@ void ZBarcode_Delete(struct zint_symbol *symbol) {
         free(symbol->bitmap);
     if (symbol->alphamap != NULL)
         free(symbol->alphamap);
+    if (symbol->memfile != NULL)
+        free(symbol->memfile);
 
     /* If there is a rendered version, ensure its memory is released */
     vector_free(symbol);
@@ -241,20 +251,16 @@ INTERNAL int error_tag_test(struct zint_symbol *symbol, int error_number, const
 
 /* Output a hexadecimal representation of the rendered symbol */
 static int dump_plot(struct zint_symbol *symbol) {
-    FILE *f;
+    struct filemem fm;
+    struct filemem *const fmp = &fm;
     int i, r;
     char hex[] = {'0', '1', '2', '3', '4', '5', '6', '7', '8',
         '9', 'A', 'B', 'C', 'D', 'E', 'F'};
     int space = 0;
 
-    if (symbol->output_options & BARCODE_STDOUT) {
-        f = stdout;
-    } else {
-        f = fopen(symbol->outfile, "w");
-        if (!f) {
-            strcpy(symbol->errtxt, "201: Could not open output file");
-            return ZINT_ERROR_FILE_ACCESS;
-        }
+    if (!fm_open(fmp, symbol, "w")) {
+        strcpy(symbol->errtxt, "201: Could not open output file");
+        return ZINT_ERROR_FILE_ACCESS;
     }
 
     for (r = 0; r < symbol->rows; r++) {
@@ -271,28 +277,27 @@ static int dump_plot(struct zint_symbol *symbol) {
                 }
             }
             if (((i + 1) % 4) == 0) {
-                fputc(hex[byt], f);
+                fm_putc(hex[byt], fmp);
                 space++;
                 byt = 0;
             }
             if (space == 2 && i + 1 < symbol->width) {
-                fputc(' ', f);
+                fm_putc(' ', fmp);
                 space = 0;
             }
         }
 
         if ((symbol->width % 4) != 0) {
             byt = byt << (4 - (symbol->width % 4));
-            fputc(hex[byt], f);
+            fm_putc(hex[byt], fmp);
         }
-        fputs("\n", f);
+        fm_putc('\n', fmp);
         space = 0;
     }
 
-    if (symbol->output_options & BARCODE_STDOUT) {
-        fflush(f);
-    } else {
-        fclose(f);
+    if (!fm_close(fmp, symbol)) {
+        sprintf(symbol->errtxt, "247: Failure on closing output file (%d: %.30s)", fmp->err, strerror(fmp->err));
+        return ZINT_ERROR_FILE_WRITE;
     }
 
     return 0;
@@ -833,6 +838,8 @@ int ZBarcode_Encode_Segs(struct zint_symbol *symbol, const struct zint_seg segs[
     int total_len = 0;
     int have_zero_eci = 0;
     int i;
+    int timed;
+    double start = 0.0, encode_start = 0.0;
     unsigned char *local_source;
     struct zint_seg *local_segs;
     unsigned char *local_sources;
@@ -840,6 +847,12 @@ int ZBarcode_Encode_Segs(struct zint_symbol *symbol, const struct zint_seg segs[
 
     if (!symbol) return ZINT_ERROR_INVALID_DATA;
 
+    timed = symbol->output_options & BARCODE_TIMINGS;
+    if (timed) {
+        memset(&symbol->timings, 0, sizeof(symbol->timings));
+        start = monotonic_ms();
+    }
+
     if (segs == NULL) {
         return error_tag(symbol, ZINT_ERROR_INVALID_DATA, "200: Input segments NULL");
     }
@@ -1144,6 +1157,11 @@ int ZBarcode_Encode_Segs(struct zint_symbol *symbol, const struct zint_seg segs[
         }
     }
 
+    if (timed) {
+        encode_start = monotonic_ms();
+        symbol->timings.convert = encode_start - start;
+    }
+
     error_number = extended_or_reduced_charset(symbol, local_segs, seg_count);
 
     if ((error_number == ZINT_ERROR_INVALID_DATA) && have_zero_eci && supports_eci(symbol->symbology)
@@ -1163,6 +1181,10 @@ int ZBarcode_Encode_Segs(struct zint_symbol *symbol, const struct zint_seg segs[
         }
     }
 
+    if (timed) {
+        symbol->timings.encode = monotonic_ms() - encode_start;
+    }
+
     if (error_number == 0) {
         error_number = warn_number; /* Already tagged */
     } else {
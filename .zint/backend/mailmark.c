@@ -144,6 +144,7 @@ INTERNAL int mailmark(struct zint_symbol *symbol, unsigned char source[], int le
     int check_count;
     int i, j, len;
     rs_t rs;
+    const rs_t *p_rs;
     int error_number = 0;
 
     if (length > 26) {
@@ -402,9 +403,8 @@ INTERNAL int mailmark(struct zint_symbol *symbol, unsigned char source[], int le
     }
 
     /* Generation of Reed-Solomon Check Numbers */
-    rs_init_gf(&rs, 0x25);
-    rs_init_code(&rs, check_count, 1);
-    rs_encode(&rs, (data_top + 1), data, check);
+    p_rs = rs_init_cached(&rs, 0x25, check_count, 1);
+    rs_encode(p_rs, (data_top + 1), data, check);
 
     /* Append check digits to data */
     for (i = 1; i <= check_count; i++) {
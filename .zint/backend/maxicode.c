@@ -43,11 +43,11 @@ static void maxi_do_primary_check(unsigned char maxi_codeword[144]) {
     int datalen = 10;
     int ecclen = 10;
     rs_t rs;
+    const rs_t *p_rs;
 
-    rs_init_gf(&rs, 0x43);
-    rs_init_code(&rs, ecclen, 1);
+    p_rs = rs_init_cached(&rs, 0x43, ecclen, 1);
 
-    rs_encode(&rs, datalen, maxi_codeword, results);
+    rs_encode(p_rs, datalen, maxi_codeword, results);
 
     for (j = 0; j < ecclen; j += 1)
         maxi_codeword[ datalen + j] = results[ecclen - 1 - j];
@@ -60,9 +60,9 @@ static void maxi_do_secondary_chk_odd(unsigned char maxi_codeword[144], const in
     int j;
     int datalen = 68;
     rs_t rs;
+    const rs_t *p_rs;
 
-    rs_init_gf(&rs, 0x43);
-    rs_init_code(&rs, ecclen, 1);
+    p_rs = rs_init_cached(&rs, 0x43, ecclen, 1);
 
     if (ecclen == 20)
         datalen = 84;
@@ -70,7 +70,7 @@ static void maxi_do_secondary_chk_odd(unsigned char maxi_codeword[144], const in
     for (j = 1; j < datalen; j += 2)
         data[(j - 1) / 2] = maxi_codeword[j + 20];
 
-    rs_encode(&rs, datalen / 2, data, results);
+    rs_encode(p_rs, datalen / 2, data, results);
 
     for (j = 0; j < (ecclen); j += 1)
         maxi_codeword[ datalen + (2 * j) + 1 + 20 ] = results[ecclen - 1 - j];
@@ -83,17 +83,17 @@ static void maxi_do_secondary_chk_even(unsigned char maxi_codeword[144], const i
     int j;
     int datalen = 68;
     rs_t rs;
+    const rs_t *p_rs;
 
     if (ecclen == 20)
         datalen = 84;
 
-    rs_init_gf(&rs, 0x43);
-    rs_init_code(&rs, ecclen, 1);
+    p_rs = rs_init_cached(&rs, 0x43, ecclen, 1);
 
     for (j = 0; j < datalen + 1; j += 2)
         data[j / 2] = maxi_codeword[j + 20];
 
-    rs_encode(&rs, datalen / 2, data, results);
+    rs_encode(p_rs, datalen / 2, data, results);
 
     for (j = 0; j < (ecclen); j += 1)
         maxi_codeword[ datalen + (2 * j) + 20] = results[ecclen - 1 - j];
@@ -31,10 +31,10 @@
 /* SPDX-License-Identifier: BSD-3-Clause */
 
 #include <errno.h>
-#include <locale.h>
 #include <math.h>
 #include <stdio.h>
 #include "common.h"
+#include "filemem.h"
 
 static void colour_to_pscolor(int option, int colour, char *output) {
     *output = '\0';
@@ -134,15 +134,9 @@ INTERNAL void ps_convert_test(const unsigned char *string, unsigned char *ps_str
 }
 #endif
 
-
-int pipe(int fd[2]);
-int close(int fildes);
-int read(int fildes, void *buf, unsigned nbytes);
-
 INTERNAL int ps_plot(struct zint_symbol *symbol) {
-  char *buf = malloc(sizeof(symbol->rendered_data));
-  int p[2];
-    FILE *feps;
+    struct filemem fm;
+    struct filemem *const fmp = &fm;
     int fgred, fggrn, fgblu, bgred, bggrn, bgblu;
     float red_ink, green_ink, blue_ink, red_paper, green_paper, blue_paper;
     float cyan_ink, magenta_ink, yellow_ink, black_ink;
@@ -158,13 +152,11 @@ INTERNAL int ps_plot(struct zint_symbol *symbol) {
     struct zint_vector_hexagon *hex;
     struct zint_vector_circle *circle;
     struct zint_vector_string *string;
-    const char *locale = NULL;
     const char *font;
     int i, len;
     int ps_len = 0;
     int iso_latin1 = 0;
     int have_circles_with_width = 0, have_circles_without_width = 0;
-    const int output_to_stdout = symbol->output_options & BARCODE_STDOUT;
     unsigned char *ps_string;
 
     if (symbol->vector == NULL) {
@@ -178,25 +170,11 @@ INTERNAL int ps_plot(struct zint_symbol *symbol) {
         }
     }
 
-    if (output_to_stdout) {
-        
-#ifndef _MSC_VER
-  pipe(p);
-  feps = fdopen(p[1], "w");
-#else
-  feps = fopen("NUL", "w");
-  setvbuf(feps, buf, _IOLBF, sizeof(symbol->rendered_data));
-#endif
-
-    } else {
-        if (!(feps = fopen(symbol->outfile, "w"))) {
-            sprintf(symbol->errtxt, "645: Could not open output file (%d: %.30s)", errno, strerror(errno));
-            return ZINT_ERROR_FILE_ACCESS;
-        }
+    if (!fm_open(fmp, symbol, "w")) {
+        sprintf(symbol->errtxt, "645: Could not open output file (%d: %.30s)", fmp->err, strerror(fmp->err));
+        return ZINT_ERROR_FILE_ACCESS;
     }
 
-    locale = setlocale(LC_ALL, "C");
-
     fgred = (16 * ctoi(symbol->fgcolour[0])) + ctoi(symbol->fgcolour[1]);
     fggrn = (16 * ctoi(symbol->fgcolour[2])) + ctoi(symbol->fgcolour[3]);
     fgblu = (16 * ctoi(symbol->fgcolour[4])) + ctoi(symbol->fgcolour[5]);
@@ -285,58 +263,58 @@ INTERNAL int ps_plot(struct zint_symbol *symbol) {
     }
 
     /* Start writing the header */
-    fprintf(feps, "%%!PS-Adobe-3.0 EPSF-3.0\n");
+    fm_printf(fmp, "%%!PS-Adobe-3.0 EPSF-3.0\n");
     if (ZINT_VERSION_BUILD) {
-        fprintf(feps, "%%%%Creator: Zint %d.%d.%d.%d\n",
+        fm_printf(fmp, "%%%%Creator: Zint %d.%d.%d.%d\n",
                 ZINT_VERSION_MAJOR, ZINT_VERSION_MINOR, ZINT_VERSION_RELEASE, ZINT_VERSION_BUILD);
     } else {
-        fprintf(feps, "%%%%Creator: Zint %d.%d.%d\n", ZINT_VERSION_MAJOR, ZINT_VERSION_MINOR, ZINT_VERSION_RELEASE);
+        fm_printf(fmp, "%%%%Creator: Zint %d.%d.%d\n", ZINT_VERSION_MAJOR, ZINT_VERSION_MINOR, ZINT_VERSION_RELEASE);
     }
-    fprintf(feps, "%%%%Title: Zint Generated Symbol\n");
-    fprintf(feps, "%%%%Pages: 0\n");
-    fprintf(feps, "%%%%BoundingBox: 0 0 %d %d\n",
+    fm_printf(fmp, "%%%%Title: Zint Generated Symbol\n");
+    fm_printf(fmp, "%%%%Pages: 0\n");
+    fm_printf(fmp, "%%%%BoundingBox: 0 0 %d %d\n",
             (int) ceilf(symbol->vector->width), (int) ceilf(symbol->vector->height));
-    fprintf(feps, "%%%%EndComments\n");
+    fm_printf(fmp, "%%%%EndComments\n");
 
     /* Definitions */
     if (have_circles_without_width) {
         /* Disc: x y radius TD */
-        fprintf(feps, "/TD { newpath 0 360 arc fill } bind def\n");
+        fm_printf(fmp, "/TD { newpath 0 360 arc fill } bind def\n");
     }
     if (have_circles_with_width) {
         /* Circle (ring): x y radius width TC (adapted from BWIPP renmaxicode.ps) */
-        fprintf(feps, "/TC { newpath 4 1 roll 3 copy 0 360 arc closepath 4 -1 roll add 360 0 arcn closepath fill }"
+        fm_printf(fmp, "/TC { newpath 4 1 roll 3 copy 0 360 arc closepath 4 -1 roll add 360 0 arcn closepath fill }"
                         " bind def\n");
     }
     if (symbol->vector->hexagons) {
-        fprintf(feps, "/TH { 0 setlinewidth moveto lineto lineto lineto lineto lineto closepath fill } bind def\n");
+        fm_printf(fmp, "/TH { 0 setlinewidth moveto lineto lineto lineto lineto lineto closepath fill } bind def\n");
     }
-    fprintf(feps, "/TB { 2 copy } bind def\n");
-    fprintf(feps, "/TR { newpath 4 1 roll exch moveto 1 index 0 rlineto 0 exch rlineto neg 0 rlineto closepath fill }"
+    fm_printf(fmp, "/TB { 2 copy } bind def\n");
+    fm_printf(fmp, "/TR { newpath 4 1 roll exch moveto 1 index 0 rlineto 0 exch rlineto neg 0 rlineto closepath fill }"
                     " bind def\n");
-    fprintf(feps, "/TE { pop pop } bind def\n");
+    fm_printf(fmp, "/TE { pop pop } bind def\n");
 
-    fprintf(feps, "newpath\n");
+    fm_printf(fmp, "newpath\n");
 
     /* Now the actual representation */
 
     /* Background */
     if (draw_background) {
         if ((symbol->output_options & CMYK_COLOUR) == 0) {
-            fprintf(feps, "%.2f %.2f %.2f setrgbcolor\n", red_paper, green_paper, blue_paper);
+            fm_printf(fmp, "%.2f %.2f %.2f setrgbcolor\n", red_paper, green_paper, blue_paper);
         } else {
-            fprintf(feps, "%.2f %.2f %.2f %.2f setcmykcolor\n", cyan_paper, magenta_paper, yellow_paper, black_paper);
+            fm_printf(fmp, "%.2f %.2f %.2f %.2f setcmykcolor\n", cyan_paper, magenta_paper, yellow_paper, black_paper);
         }
 
-        fprintf(feps, "%.2f 0.00 TB 0.00 %.2f TR\n", symbol->vector->height, symbol->vector->width);
-        fprintf(feps, "TE\n");
+        fm_printf(fmp, "%.2f 0.00 TB 0.00 %.2f TR\n", symbol->vector->height, symbol->vector->width);
+        fm_printf(fmp, "TE\n");
     }
 
     if (symbol->symbology != BARCODE_ULTRA) {
         if ((symbol->output_options & CMYK_COLOUR) == 0) {
-            fprintf(feps, "%.2f %.2f %.2f setrgbcolor\n", red_ink, green_ink, blue_ink);
+            fm_printf(fmp, "%.2f %.2f %.2f setrgbcolor\n", red_ink, green_ink, blue_ink);
         } else {
-            fprintf(feps, "%.2f %.2f %.2f %.2f setcmykcolor\n", cyan_ink, magenta_ink, yellow_ink, black_ink);
+            fm_printf(fmp, "%.2f %.2f %.2f %.2f setcmykcolor\n", cyan_ink, magenta_ink, yellow_ink, black_ink);
         }
     }
 
@@ -349,16 +327,16 @@ INTERNAL int ps_plot(struct zint_symbol *symbol) {
                 if (colour_rect_flag == 0) {
                     /* Set foreground colour */
                     if ((symbol->output_options & CMYK_COLOUR) == 0) {
-                        fprintf(feps, "%.2f %.2f %.2f setrgbcolor\n", red_ink, green_ink, blue_ink);
+                        fm_printf(fmp, "%.2f %.2f %.2f setrgbcolor\n", red_ink, green_ink, blue_ink);
                     } else {
-                        fprintf(feps, "%.2f %.2f %.2f %.2f setcmykcolor\n",
+                        fm_printf(fmp, "%.2f %.2f %.2f %.2f setcmykcolor\n",
                                 cyan_ink, magenta_ink, yellow_ink, black_ink);
                     }
                     colour_rect_flag = 1;
                 }
-                fprintf(feps, "%.2f %.2f TB %.2f %.2f TR\n",
+                fm_printf(fmp, "%.2f %.2f TB %.2f %.2f TR\n",
                         rect->height, (symbol->vector->height - rect->y) - rect->height, rect->x, rect->width);
-                fprintf(feps, "TE\n");
+                fm_printf(fmp, "TE\n");
             }
             rect = rect->next;
         }
@@ -370,12 +348,12 @@ INTERNAL int ps_plot(struct zint_symbol *symbol) {
                     if (colour_rect_flag == 0) {
                         /* Set new colour */
                         colour_to_pscolor(symbol->output_options, colour_index, ps_color);
-                        fprintf(feps, "%s\n", ps_color);
+                        fm_printf(fmp, "%s\n", ps_color);
                         colour_rect_flag = 1;
                     }
-                    fprintf(feps, "%.2f %.2f TB %.2f %.2f TR\n",
+                    fm_printf(fmp, "%.2f %.2f TB %.2f %.2f TR\n",
                             rect->height, (symbol->vector->height - rect->y) - rect->height, rect->x, rect->width);
-                    fprintf(feps, "TE\n");
+                    fm_printf(fmp, "TE\n");
                 }
                 rect = rect->next;
             }
@@ -383,9 +361,9 @@ INTERNAL int ps_plot(struct zint_symbol *symbol) {
     } else {
         rect = symbol->vector->rectangles;
         while (rect) {
-            fprintf(feps, "%.2f %.2f TB %.2f %.2f TR\n",
+            fm_printf(fmp, "%.2f %.2f TB %.2f %.2f TR\n",
                     rect->height, (symbol->vector->height - rect->y) - rect->height, rect->x, rect->width);
-            fprintf(feps, "TE\n");
+            fm_printf(fmp, "TE\n");
             rect = rect->next;
         }
     }
@@ -427,7 +405,7 @@ INTERNAL int ps_plot(struct zint_symbol *symbol) {
             ex = hex->x + half_radius;
             fx = hex->x - half_radius;
         }
-        fprintf(feps, "%.2f %.2f %.2f %.2f %.2f %.2f %.2f %.2f %.2f %.2f %.2f %.2f TH\n",
+        fm_printf(fmp, "%.2f %.2f %.2f %.2f %.2f %.2f %.2f %.2f %.2f %.2f %.2f %.2f TH\n",
                 ax, ay, bx, by, cx, cy, dx, dy, ex, ey, fx, fy);
         hex = hex->next;
     }
@@ -443,31 +421,31 @@ INTERNAL int ps_plot(struct zint_symbol *symbol) {
         if (circle->colour) {
             /* A 'white' circle */
             if ((symbol->output_options & CMYK_COLOUR) == 0) {
-                fprintf(feps, "%.2f %.2f %.2f setrgbcolor\n", red_paper, green_paper, blue_paper);
+                fm_printf(fmp, "%.2f %.2f %.2f setrgbcolor\n", red_paper, green_paper, blue_paper);
             } else {
-                fprintf(feps, "%.2f %.2f %.2f %.2f setcmykcolor\n",
+                fm_printf(fmp, "%.2f %.2f %.2f %.2f setcmykcolor\n",
                         cyan_paper, magenta_paper, yellow_paper, black_paper);
             }
             if (circle->width) {
-                fprintf(feps, "%.2f %.2f %.3f %.3f TC\n",
+                fm_printf(fmp, "%.2f %.2f %.3f %.3f TC\n",
                         circle->x, (symbol->vector->height - circle->y), radius, circle->width);
             } else {
-                fprintf(feps, "%.2f %.2f %.2f TD\n", circle->x, (symbol->vector->height - circle->y), radius);
+                fm_printf(fmp, "%.2f %.2f %.2f TD\n", circle->x, (symbol->vector->height - circle->y), radius);
             }
             if (circle->next) {
                 if ((symbol->output_options & CMYK_COLOUR) == 0) {
-                    fprintf(feps, "%.2f %.2f %.2f setrgbcolor\n", red_ink, green_ink, blue_ink);
+                    fm_printf(fmp, "%.2f %.2f %.2f setrgbcolor\n", red_ink, green_ink, blue_ink);
                 } else {
-                    fprintf(feps, "%.2f %.2f %.2f %.2f setcmykcolor\n", cyan_ink, magenta_ink, yellow_ink, black_ink);
+                    fm_printf(fmp, "%.2f %.2f %.2f %.2f setcmykcolor\n", cyan_ink, magenta_ink, yellow_ink, black_ink);
                 }
             }
         } else {
             /* A 'black' circle */
             if (circle->width) {
-                fprintf(feps, "%.2f %.2f %.3f %.3f TC\n",
+                fm_printf(fmp, "%.2f %.2f %.3f %.3f TC\n",
                         circle->x, (symbol->vector->height - circle->y), radius, circle->width);
             } else {
-                fprintf(feps, "%.2f %.2f %.2f TD\n", circle->x, (symbol->vector->height - circle->y), radius);
+                fm_printf(fmp, "%.2f %.2f %.2f TD\n", circle->x, (symbol->vector->height - circle->y), radius);
             }
         }
         circle = circle->next;
@@ -486,60 +464,47 @@ INTERNAL int ps_plot(struct zint_symbol *symbol) {
         }
         if (iso_latin1) {
             /* Change encoding to ISO 8859-1, see Postscript Language Reference Manual 2nd Edition Example 5.6 */
-            fprintf(feps, "/%s findfont\n", font);
-            fprintf(feps, "dup length dict begin\n");
-            fprintf(feps, "{1 index /FID ne {def} {pop pop} ifelse} forall\n");
-            fprintf(feps, "/Encoding ISOLatin1Encoding def\n");
-            fprintf(feps, "currentdict\n");
-            fprintf(feps, "end\n");
-            fprintf(feps, "/Helvetica-ISOLatin1 exch definefont pop\n");
+            fm_printf(fmp, "/%s findfont\n", font);
+            fm_printf(fmp, "dup length dict begin\n");
+            fm_printf(fmp, "{1 index /FID ne {def} {pop pop} ifelse} forall\n");
+            fm_printf(fmp, "/Encoding ISOLatin1Encoding def\n");
+            fm_printf(fmp, "currentdict\n");
+            fm_printf(fmp, "end\n");
+            fm_printf(fmp, "/Helvetica-ISOLatin1 exch definefont pop\n");
             font = "Helvetica-ISOLatin1";
         }
         do {
             ps_convert(string->text, ps_string);
-            fprintf(feps, "matrix currentmatrix\n");
-            fprintf(feps, "/%s findfont\n", font);
-            fprintf(feps, "%.2f scalefont setfont\n", string->fsize);
-            fprintf(feps, " 0 0 moveto %.2f %.2f translate 0.00 rotate 0 0 moveto\n",
+            fm_printf(fmp, "matrix currentmatrix\n");
+            fm_printf(fmp, "/%s findfont\n", font);
+            fm_printf(fmp, "%.2f scalefont setfont\n", string->fsize);
+            fm_printf(fmp, " 0 0 moveto %.2f %.2f translate 0.00 rotate 0 0 moveto\n",
                     string->x, (symbol->vector->height - string->y));
             if (string->halign == 0 || string->halign == 2) { /* Need width for middle or right align */
-                fprintf(feps, " (%s) stringwidth\n", ps_string);
+                fm_printf(fmp, " (%s) stringwidth\n", ps_string);
             }
             if (string->rotation != 0) {
-                fprintf(feps, "gsave\n");
-                fprintf(feps, "%d rotate\n", 360 - string->rotation);
+                fm_printf(fmp, "gsave\n");
+                fm_printf(fmp, "%d rotate\n", 360 - string->rotation);
             }
             if (string->halign == 0 || string->halign == 2) {
-                fprintf(feps, "pop\n");
-                fprintf(feps, "%s 0 rmoveto\n", string->halign == 2 ? "neg" : "-2 div");
+                fm_printf(fmp, "pop\n");
+                fm_printf(fmp, "%s 0 rmoveto\n", string->halign == 2 ? "neg" : "-2 div");
             }
-            fprintf(feps, " (%s) show\n", ps_string);
+            fm_printf(fmp, " (%s) show\n", ps_string);
             if (string->rotation != 0) {
-                fprintf(feps, "grestore\n");
+                fm_printf(fmp, "grestore\n");
             }
-            fprintf(feps, "setmatrix\n");
+            fm_printf(fmp, "setmatrix\n");
             string = string->next;
         } while (string);
     }
 
-    if (output_to_stdout) {
-        
-fprintf(feps, "<<< EOF >>>");
-#ifndef _MSC_VER
-  fflush(feps);
-  close(p[1]);
-  read(p[0], symbol->rendered_data, sizeof(symbol->rendered_data));
-#else
-  strcpy(symbol->rendered_data, buf);
-#endif
-
-    } else {
-        fclose(feps);
+    if (!fm_close(fmp, symbol)) {
+        sprintf(symbol->errtxt, "647: Failure on closing output file (%d: %.30s)", fmp->err, strerror(fmp->err));
+        error_number = ZINT_ERROR_FILE_WRITE;
     }
 
-    if (locale)
-        setlocale(LC_ALL, locale);
-
     return error_number;
 }
 
@@ -742,6 +742,7 @@ static void qr_add_ecc(unsigned char fullstream[], const unsigned char datastrea
     int ecc_block_length;
     int i, j, length_this_block, in_posn;
     rs_t rs;
+    const rs_t *p_rs;
     unsigned char *data_block;
     unsigned char *ecc_block;
     unsigned char *interleaved_data;
@@ -769,8 +770,7 @@ static void qr_add_ecc(unsigned char fullstream[], const unsigned char datastrea
     interleaved_data = (unsigned char *) z_alloca(data_cw);
     interleaved_ecc = (unsigned char *) z_alloca(ecc_cw);
 
-    rs_init_gf(&rs, 0x11d);
-    rs_init_code(&rs, ecc_block_length, 0);
+    p_rs = rs_init_cached(&rs, 0x11d, ecc_block_length, 0);
 
     in_posn = 0;
 
@@ -789,7 +789,7 @@ static void qr_add_ecc(unsigned char fullstream[], const unsigned char datastrea
             data_block[j] = datastream[in_posn + j]; /* NOLINT false-positive popped up with clang-tidy 14.0.1 */
         }
 
-        rs_encode(&rs, length_this_block, data_block, ecc_block);
+        rs_encode(p_rs, length_this_block, data_block, ecc_block);
 
         if (debug_print) {
             printf("Block %d: ", i + 1);
@@ -1006,248 +1006,165 @@ static void qr_populate_grid(unsigned char *grid, const int h_size, const int v_
     }
 }
 
-#ifdef ZINTLOG
-
-static int append_log(char log) {
-    FILE *file;
-
-    file = fopen("zintlog.txt", "a+");
-    fprintf(file, "%c", log);
-    fclose(file);
-    return 0;
+/* Mask evaluation works on bit-packed rows and columns of modules (dark = 1), in `QR_WORDS` 64-bit words each,
+   bit `i` of word `i / 64` being module `i`, and any bits beyond the symbol's size zero (i.e. light) */
+#define QR_WORDS    3 /* Enough for 192 modules (version 40 is 177 wide) */
+
+/* Shift a packed line `k` modules (1 to 63) up or down, taking the bits coming in from the previous or next word */
+#define QR_UP(w, prev, k)   (((w) << (k)) | ((prev) >> (64 - (k))))
+#define QR_DN(w, next, k)   (((w) >> (k)) | ((next) << (64 - (k))))
+
+/* Number of bits set in a 64-bit word */
+static int qr_popcount(const uint64_t w) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(w);
+#else
+    unsigned int lo = (unsigned int) (w & 0xFFFFFFFF), hi = (unsigned int) (w >> 32);
+
+    lo = lo - ((lo >> 1) & 0x55555555);
+    hi = hi - ((hi >> 1) & 0x55555555);
+    lo = (lo & 0x33333333) + ((lo >> 2) & 0x33333333);
+    hi = (hi & 0x33333333) + ((hi >> 2) & 0x33333333);
+    lo = (lo + (lo >> 4)) & 0x0F0F0F0F;
+    hi = (hi + (hi >> 4)) & 0x0F0F0F0F;
+    return (int) (((lo + hi) * 0x01010101) >> 24);
+#endif
 }
 
-static int write_log(char log[]) {
-    FILE *file;
-
-    file = fopen("zintlog.txt", "a+");
-    fprintf(file, log); /*writes*/
-    fprintf(file, "\r\n"); /*writes*/
-    fclose(file);
-    return 0;
+/* Whether mask `pattern` flips the module at `x`, `y` (if maskable) */
+static int qr_mask_bit(const int pattern, const int y, const int x) {
+    switch (pattern) {
+        case 0: return ((y + x) & 1) == 0;
+        case 1: return (y & 1) == 0;
+        case 2: return (x % 3) == 0;
+        case 3: return ((y + x) % 3) == 0;
+        case 4: return (((y / 2) + (x / 3)) & 1) == 0;
+        case 5: return (y * x) % 6 == 0; /* Equivalent to (y * x) % 2 + (y * x) % 3 == 0 */
+        case 6: return ((((y * x) & 1) + ((y * x) % 3)) & 1) == 0;
+    }
+    return ((((y + x) & 1) + ((y * x) % 3)) & 1) == 0;
 }
-#endif
-
-static int qr_evaluate(unsigned char *local, const int size) {
-    static const unsigned char h1011101[7] = { 1, 0, 1, 1, 1, 0, 1 };
 
-    int x, y, r, k, block;
+/* Penalty of a packed row or column for Test 1 (runs of 5 or more modules of the same colour) and Test 3
+   (1:1:3:1:1 finder-like patterns preceded or followed by 4 light modules) */
+static int qr_evaluate_line(const uint64_t line[QR_WORDS], const int words, const uint64_t last_mask) {
+    uint64_t same[QR_WORDS], run5[QR_WORDS];
+    int w;
     int result = 0;
-    char state;
-    int dark_mods;
-    double percentage;
-    int a, b, afterCount, beforeCount;
-#ifdef ZINTLOG
-    int result_b = 0;
-    char str[15];
-#endif
-
-    /* Suppresses clang-tidy clang-analyzer-core.UndefinedBinaryOperatorResult warnings */
-    assert(size > 0);
 
-#ifdef ZINTLOG
-    /* bitmask output */
-    for (y = 0; y < size; y++) {
-        strcpy(str, "");
-        for (x = 0; x < size; x++) {
-            state = local[(y * size) + x];
-            append_log(state);
-        }
-        write_log("");
+    /* Test 1: Adjacent modules in same colour. A run of `n` >= 5 scores `n - 2`, i.e. 1 for each of its `n - 4`
+       windows of 5 same modules, plus 2 for the first one */
+    for (w = 0; w < words; w++) {
+        const uint64_t prev = w ? line[w - 1] : 0;
+        same[w] = ~(line[w] ^ QR_UP(line[w], prev, 1)); /* Same colour as the previous module */
     }
-    write_log("");
-#endif
-
-    /* Test 1: Adjacent modules in row/column in same colour */
-    /* Vertical */
-    for (x = 0; x < size; x++) {
-        block = 0;
-        state = 0;
-        for (y = 0; y < size; y++) {
-            if (local[(y * size) + x] == state) {
-                block++;
-            } else {
-                if (block >= 5) {
-                    result += block - 2;
-                }
-                block = 1;
-                state = local[(y * size) + x];
-            }
-        }
-        if (block >= 5) {
-            result += block - 2;
-        }
+    same[0] &= ~((uint64_t) 1);
+    same[words - 1] &= last_mask;
+    for (w = 0; w < words; w++) {
+        const uint64_t prev = w ? same[w - 1] : 0;
+        run5[w] = same[w] & QR_UP(same[w], prev, 1) & QR_UP(same[w], prev, 2) & QR_UP(same[w], prev, 3);
+    }
+    for (w = 0; w < words; w++) {
+        const uint64_t prev = w ? run5[w - 1] : 0;
+        result += qr_popcount(run5[w]) + 2 * qr_popcount(run5[w] & ~QR_UP(run5[w], prev, 1));
     }
 
-    /* Horizontal */
-    dark_mods = 0; /* Count dark mods simultaneously (see Test 4 below) */
-    for (y = 0; y < size; y++) {
-        r = y * size;
-        block = 0;
-        state = 0;
-        for (x = 0; x < size; x++) {
-            if (local[r + x] == state) {
-                block++;
-            } else {
-                if (block >= 5) {
-                    result += block - 2;
-                }
-                block = 1;
-                state = local[r + x];
-            }
-            if (state) {
-                dark_mods++;
-            }
-        }
-        if (block >= 5) {
-            result += block - 2;
+    /* Test 3: 1:1:3:1:1 ratio pattern, counting modules beyond the edges as light */
+    for (w = 0; w < words; w++) {
+        const uint64_t cur = line[w];
+        const uint64_t prev = w ? line[w - 1] : 0;
+        const uint64_t next = w + 1 < words ? line[w + 1] : 0;
+        const uint64_t found = cur & ~QR_DN(cur, next, 1) & QR_DN(cur, next, 2) & QR_DN(cur, next, 3)
+                                & QR_DN(cur, next, 4) & ~QR_DN(cur, next, 5) & QR_DN(cur, next, 6);
+        if (found) {
+            const uint64_t light_before = ~(QR_UP(cur, prev, 1) | QR_UP(cur, prev, 2) | QR_UP(cur, prev, 3)
+                                            | QR_UP(cur, prev, 4));
+            const uint64_t light_after = ~(QR_DN(cur, next, 7) | QR_DN(cur, next, 8) | QR_DN(cur, next, 9)
+                                            | QR_DN(cur, next, 10));
+            result += 40 * qr_popcount(found & (light_before | light_after));
         }
     }
 
-#ifdef ZINTLOG
-    /* output Test 1 */
-    sprintf(str, "%d", result);
-    result_b = result;
-    write_log(str);
-#endif
+    return result;
+}
 
-    /* Test 2: Block of modules in same color */
-    for (x = 0; x < size - 1; x++) {
-        for (y = 0; y < size - 1; y++) {
-            k = local[(y * size) + x];
-            if (((k == local[((y + 1) * size) + x]) &&
-                    (k == local[(y * size) + (x + 1)])) &&
-                    (k == local[((y + 1) * size) + (x + 1)])) {
-                result += 3;
-            }
-        }
-    }
+/* Evaluate the penalty of a masked symbol, given as packed `rows` and `cols` */
+static int qr_evaluate(const uint64_t *rows, const uint64_t *cols, const int size) {
+    const int words = (size + 63) >> 6;
+    const uint64_t last_mask = (size & 63) ? (((uint64_t) 1) << (size & 63)) - 1 : ~((uint64_t) 0);
+    int x, y, w, k;
+    int result = 0;
+    int dark_mods = 0;
+    double percentage;
 
-#ifdef ZINTLOG
-    /* output Test 2 */
-    sprintf(str, "%d", result - result_b);
-    result_b = result;
-    write_log(str);
-#endif
+    /* Suppresses clang-tidy clang-analyzer-core.UndefinedBinaryOperatorResult warnings */
+    assert(size > 0);
 
-    /* Test 3: 1:1:3:1:1 ratio pattern in row/column */
-    /* Vertical */
+    /* Tests 1 and 3, vertical and horizontal */
     for (x = 0; x < size; x++) {
-        for (y = 0; y <= (size - 7); y++) {
-            if (local[y * size + x] && !local[(y + 1) * size + x] && local[(y + 2) * size + x] &&
-                    local[(y + 3) * size + x] && local[(y + 4) * size + x] &&
-                    !local[(y + 5) * size + x] && local[(y + 6) * size + x]) {
-                /* Pattern found, check before and after */
-                beforeCount = 0;
-                for (b = (y - 1); b >= (y - 4); b--) {
-                    if (b < 0) { /* Count < edge as whitespace */
-                        beforeCount = 4;
-                        break;
-                    }
-                    if (local[(b * size) + x]) {
-                        break;
-                    }
-                    beforeCount++;
-                }
-                if (beforeCount == 4) {
-                    /* Pattern is preceded by light area 4 modules wide */
-                    result += 40;
-                } else {
-                    afterCount = 0;
-                    for (a = (y + 7); a <= (y + 10); a++) {
-                        if (a >= size) { /* Count > edge as whitespace */
-                            afterCount = 4;
-                            break;
-                        }
-                        if (local[(a * size) + x]) {
-                            break;
-                        }
-                        afterCount++;
-                    }
-                    if (afterCount == 4) {
-                        /* Pattern is followed by light area 4 modules wide */
-                        result += 40;
-                    }
-                }
-                y += 3; /* Skip to next possible match */
-            }
-        }
+        result += qr_evaluate_line(cols + x * QR_WORDS, words, last_mask);
     }
-
-    /* Horizontal */
     for (y = 0; y < size; y++) {
-        r = y * size;
-        for (x = 0; x <= (size - 7); x++) {
-            if (memcmp(local + r + x, h1011101, 7) == 0) {
-                /* Pattern found, check before and after */
-                beforeCount = 0;
-                for (b = (x - 1); b >= (x - 4); b--) {
-                    if (b < 0) { /* Count < edge as whitespace */
-                        beforeCount = 4;
-                        break;
-                    }
-                    if (local[r + b]) {
-                        break;
-                    }
-                    beforeCount++;
-                }
+        const uint64_t *row = rows + y * QR_WORDS;
+        result += qr_evaluate_line(row, words, last_mask);
+        for (w = 0; w < words; w++) {
+            dark_mods += qr_popcount(row[w]); /* See Test 4 below */
+        }
+    }
 
-                if (beforeCount == 4) {
-                    /* Pattern is preceded by light area 4 modules wide */
-                    result += 40;
-                } else {
-                    afterCount = 0;
-                    for (a = (x + 7); a <= (x + 10); a++) {
-                        if (a >= size) { /* Count > edge as whitespace */
-                            afterCount = 4;
-                            break;
-                        }
-                        if (local[r + a]) {
-                            break;
-                        }
-                        afterCount++;
-                    }
-                    if (afterCount == 4) {
-                        /* Pattern is followed by light area 4 modules wide */
-                        result += 40;
-                    }
-                }
-                x += 3; /* Skip to next possible match */
+    /* Test 2: Block of modules in same color, i.e. same as the one above, as the one to the left, and as the one
+       above that */
+    for (y = 0; y < size - 1; y++) {
+        const uint64_t *row = rows + y * QR_WORDS;
+        const uint64_t *below = row + QR_WORDS;
+        for (w = 0; w < words; w++) {
+            const uint64_t prev = w ? row[w - 1] : 0;
+            const uint64_t vert = ~(row[w] ^ below[w]);
+            const uint64_t vert_prev = w ? ~(row[w - 1] ^ below[w - 1]) : 0;
+            uint64_t block = vert & QR_UP(vert, vert_prev, 1) & ~(row[w] ^ QR_UP(row[w], prev, 1));
+            if (w == 0) {
+                block &= ~((uint64_t) 1);
+            }
+            if (w == words - 1) {
+                block &= last_mask;
             }
+            result += 3 * qr_popcount(block);
         }
     }
 
-#ifdef ZINTLOG
-    /* output Test 3 */
-    sprintf(str, "%d", result - result_b);
-    result_b = result;
-    write_log(str);
-#endif
-
     /* Test 4: Proportion of dark modules in entire symbol */
     percentage = (100.0 * dark_mods) / (size * size);
     k = (int) (fabs(percentage - 50.0) / 5.0);
 
     result += 10 * k;
 
-#ifdef ZINTLOG
-    /* output Test 4+summary */
-    sprintf(str, "%d", result - result_b);
-    write_log(str);
-    write_log("==========");
-    sprintf(str, "%d", result);
-    write_log(str);
-#endif
-
     return result;
 }
 
-/* Add format information to grid */
-static void qr_add_format_info(unsigned char *grid, const int size, const int ecc_level, const int pattern) {
-    int format = pattern;
-    unsigned int seq;
+/* Positions (`y * size + x`) of the 2 modules of each of the 15 bits of format information */
+static void qr_format_info_posns(const int size, int posns[15][2]) {
     int i;
 
+    for (i = 0; i < 6; i++) {
+        posns[i][0] = (i * size) + 8;
+        posns[i][1] = (8 * size) + (size - i - 1);
+    }
+    posns[6][0] = (7 * size) + 8;
+    posns[6][1] = (8 * size) + (size - 7);
+    posns[7][0] = (8 * size) + 8;
+    posns[7][1] = (8 * size) + (size - 8);
+    posns[8][0] = (8 * size) + 7;
+    posns[8][1] = ((size - 7) * size) + 8;
+    for (i = 9; i < 15; i++) {
+        posns[i][0] = (8 * size) + (14 - i);
+        posns[i][1] = ((size - 15 + i) * size) + 8;
+    }
+}
+
+/* Format information sequence of `ecc_level` and mask `pattern` */
+static unsigned int qr_format_info(const int ecc_level, const int pattern) {
+    int format = pattern;
+
     switch (ecc_level) {
         case QR_LEVEL_L: format |= 0x08;
             break;
@@ -1257,96 +1174,104 @@ static void qr_add_format_info(unsigned char *grid, const int size, const int ec
             break;
     }
 
-    seq = qr_annex_c[format];
-
-    for (i = 0; i < 6; i++) {
-        grid[(i * size) + 8] |= (seq >> i) & 0x01;
-    }
+    return qr_annex_c[format];
+}
 
-    for (i = 0; i < 8; i++) {
-        grid[(8 * size) + (size - i - 1)] |= (seq >> i) & 0x01;
-    }
+/* Add format information to grid */
+static void qr_add_format_info(unsigned char *grid, const int size, const int ecc_level, const int pattern) {
+    const unsigned int seq = qr_format_info(ecc_level, pattern);
+    int posns[15][2];
+    int i;
 
-    for (i = 0; i < 6; i++) {
-        grid[(8 * size) + (5 - i)] |= (seq >> (i + 9)) & 0x01;
-    }
+    qr_format_info_posns(size, posns);
 
-    for (i = 0; i < 7; i++) {
-        grid[(((size - 7) + i) * size) + 8] |= (seq >> (i + 8)) & 0x01;
+    for (i = 0; i < 15; i++) {
+        grid[posns[i][0]] |= (seq >> i) & 0x01;
+        grid[posns[i][1]] |= (seq >> i) & 0x01;
     }
-
-    grid[(7 * size) + 8] |= (seq >> 6) & 0x01;
-    grid[(8 * size) + 8] |= (seq >> 7) & 0x01;
-    grid[(8 * size) + 7] |= (seq >> 8) & 0x01;
 }
 
 static int qr_apply_bitmask(unsigned char *grid, const int size, const int ecc_level, const int user_mask,
             const int debug_print) {
     int x, y;
-    int r, k;
-    int bit;
+    int r, w, i;
     int pattern, penalty[8];
     int best_pattern;
-    int size_squared = size * size;
-    unsigned char *mask = (unsigned char *) z_alloca(size_squared);
-    unsigned char *local = (unsigned char *) z_alloca(size_squared);
-
-    /* Perform data masking */
-    memset(mask, 0, size_squared);
-    for (y = 0; y < size; y++) {
-        r = y * size;
-        for (x = 0; x < size; x++) {
+    const int line_size = size * QR_WORDS;
 
-            /* all eight bitmask variants are encoded in the 8 bits of the bytes that make up the mask array. */
-            if (!(grid[r + x] & 0xf0)) { /* exclude areas not to be masked. */
-                if (((y + x) & 1) == 0) {
-                    mask[r + x] |= 0x01;
-                }
-                if ((y & 1) == 0) {
-                    mask[r + x] |= 0x02;
-                }
-                if ((x % 3) == 0) {
-                    mask[r + x] |= 0x04;
-                }
-                if (((y + x) % 3) == 0) {
-                    mask[r + x] |= 0x08;
-                }
-                if ((((y / 2) + (x / 3)) & 1) == 0) {
-                    mask[r + x] |= 0x10;
-                }
-                if ((y * x) % 6 == 0) { /* Equivalent to (y * x) % 2 + (y * x) % 3 == 0 */
-                    mask[r + x] |= 0x20;
-                }
-                if (((((y * x) & 1) + ((y * x) % 3)) & 1) == 0) {
-                    mask[r + x] |= 0x40;
+    if (user_mask) {
+        best_pattern = user_mask - 1;
+    } else {
+        /* Pack the unmasked modules and the maskable ones into rows and columns, which are then masked with the
+           rows and columns of each pattern (which repeat every 12 rows and every 6 columns) */
+        uint64_t *dark_rows = (uint64_t *) z_alloca(sizeof(uint64_t) * line_size * 6);
+        uint64_t *dark_cols = dark_rows + line_size;
+        uint64_t *maskable_rows = dark_cols + line_size;
+        uint64_t *maskable_cols = maskable_rows + line_size;
+        uint64_t *rows = maskable_cols + line_size;
+        uint64_t *cols = rows + line_size;
+        uint64_t pattern_rows[12][QR_WORDS], pattern_cols[6][QR_WORDS];
+        int posns[15][2];
+
+        memset(dark_rows, 0, sizeof(uint64_t) * line_size * 4);
+        for (y = 0; y < size; y++) {
+            r = y * size;
+            for (x = 0; x < size; x++) {
+                const uint64_t row_bit = ((uint64_t) 1) << (x & 63), col_bit = ((uint64_t) 1) << (y & 63);
+                if (grid[r + x] & 0x01) {
+                    dark_rows[y * QR_WORDS + (x >> 6)] |= row_bit;
+                    dark_cols[x * QR_WORDS + (y >> 6)] |= col_bit;
                 }
-                if (((((y + x) & 1) + ((y * x) % 3)) & 1) == 0) {
-                    mask[r + x] |= 0x80;
+                if (!(grid[r + x] & 0xf0)) { /* exclude areas not to be masked. */
+                    maskable_rows[y * QR_WORDS + (x >> 6)] |= row_bit;
+                    maskable_cols[x * QR_WORDS + (y >> 6)] |= col_bit;
                 }
             }
         }
-    }
+        qr_format_info_posns(size, posns);
 
-    if (user_mask) {
-        best_pattern = user_mask - 1;
-    } else {
-        /* all eight bitmask variants have been encoded in the 8 bits of the bytes
-         * that make up the mask array. select them for evaluation according to the
-         * desired pattern.*/
         best_pattern = 0;
         for (pattern = 0; pattern < 8; pattern++) {
+            const unsigned int seq = qr_format_info(ecc_level, pattern);
+
+            memset(pattern_rows, 0, sizeof(pattern_rows));
+            memset(pattern_cols, 0, sizeof(pattern_cols));
+            for (y = 0; y < 12 && y < size; y++) {
+                for (x = 0; x < size; x++) {
+                    if (qr_mask_bit(pattern, y, x)) {
+                        pattern_rows[y][x >> 6] |= ((uint64_t) 1) << (x & 63);
+                    }
+                }
+            }
+            for (x = 0; x < 6 && x < size; x++) {
+                for (y = 0; y < size; y++) {
+                    if (qr_mask_bit(pattern, y, x)) {
+                        pattern_cols[x][y >> 6] |= ((uint64_t) 1) << (y & 63);
+                    }
+                }
+            }
 
-            bit = 1 << pattern;
-            for (k = 0; k < size_squared; k++) {
-                if (mask[k] & bit) {
-                    local[k] = grid[k] ^ 0x01;
-                } else {
-                    local[k] = grid[k] & 0x0f;
+            for (i = 0; i < size; i++) {
+                for (w = 0; w < QR_WORDS; w++) {
+                    r = i * QR_WORDS + w;
+                    rows[r] = dark_rows[r] ^ (maskable_rows[r] & pattern_rows[i % 12][w]);
+                    cols[r] = dark_cols[r] ^ (maskable_cols[r] & pattern_cols[i % 6][w]);
+                }
+            }
+
+            /* Add format information */
+            for (i = 0; i < 15; i++) {
+                if ((seq >> i) & 0x01) {
+                    for (r = 0; r < 2; r++) {
+                        y = posns[i][r] / size;
+                        x = posns[i][r] % size;
+                        rows[y * QR_WORDS + (x >> 6)] |= ((uint64_t) 1) << (x & 63);
+                        cols[x * QR_WORDS + (y >> 6)] |= ((uint64_t) 1) << (y & 63);
+                    }
                 }
             }
-            qr_add_format_info(local, size, ecc_level, pattern);
 
-            penalty[pattern] = qr_evaluate(local, size);
+            penalty[pattern] = qr_evaluate(rows, cols, size);
 
             if (penalty[pattern] < penalty[best_pattern]) {
                 best_pattern = pattern;
@@ -1362,21 +1287,12 @@ static int qr_apply_bitmask(unsigned char *grid, const int size, const int ecc_l
         printf("\n");
     }
 
-#ifdef ZINTLOG
-    char str[15];
-    sprintf(str, "%d", best_val);
-    write_log("choosed pattern:");
-    write_log(str);
-#endif
-
     /* Apply mask */
-    if (!user_mask && best_pattern == 7) { /* Reuse last */
-        memcpy(grid, local, size_squared);
-    } else {
-        bit = 1 << best_pattern;
-        for (y = 0; y < size_squared; y++) {
-            if (mask[y] & bit) {
-                grid[y] ^= 0x01;
+    for (y = 0; y < size; y++) {
+        r = y * size;
+        for (x = 0; x < size; x++) {
+            if (!(grid[r + x] & 0xf0) && qr_mask_bit(best_pattern, y, x)) { /* exclude areas not to be masked. */
+                grid[r + x] ^= 0x01;
             }
         }
     }
@@ -1534,6 +1450,26 @@ static int qr_calc_binlen_segs(const int version, char mode[], const unsigned in
     return count;
 }
 
+/* Versions 1-9, 10-26 and 27-40 each have the same character count indicator widths, and so the same optimal modes
+   and binary length */
+static int qr_version_class(const int version) {
+    return version < 10 ? 0 : version < 27 ? 1 : 2;
+}
+
+/* `qr_calc_binlen_segs()` for the version class of `version`, only run once per class: the modes of each class are
+   kept in `class_modes` (3 * `length`), and their binary lengths in `class_binlens` (-1 until run) */
+static int qr_calc_binlen_class(const int version, char class_modes[], int class_binlens[3], const int length,
+            const unsigned int ddata[], const struct zint_seg segs[], const int seg_count,
+            const struct zint_structapp *p_structapp, const int gs1, const int debug_print) {
+    const int vclass = qr_version_class(version);
+
+    if (class_binlens[vclass] == -1) {
+        class_binlens[vclass] = qr_calc_binlen_segs(version, class_modes + vclass * length, ddata, segs, seg_count,
+                                    p_structapp, 0 /*mode_preset*/, gs1, debug_print);
+    }
+    return class_binlens[vclass];
+}
+
 /* Helper to process source data into `ddata` array */
 static int qr_prep_data(struct zint_symbol *symbol, struct zint_seg segs[], const int seg_count,
             unsigned int ddata[]) {
@@ -1577,20 +1513,24 @@ static int qr_prep_data(struct zint_symbol *symbol, struct zint_seg segs[], cons
 }
 
 INTERNAL int qrcode(struct zint_symbol *symbol, struct zint_seg segs[], const int seg_count) {
+    static const unsigned short *const data_codewords_levels[4] = {
+        qr_data_codewords_L, qr_data_codewords_M, qr_data_codewords_Q, qr_data_codewords_H
+    };
     int warn_number;
-    int i, j, est_binlen, prev_est_binlen;
+    int i, j, est_binlen;
     int ecc_level, autosize, version, max_cw, target_codewords, blocks, size;
     int bitmask, gs1;
     int user_mask;
-    int canShrink;
     int size_squared;
+    int class_binlens[3] = { -1, -1, -1 };
+    const unsigned short *data_codewords;
     const struct zint_structapp *p_structapp = NULL;
     const int debug_print = symbol->debug & ZINT_DEBUG_PRINT;
     const int eci_length_segs = get_eci_length_segs(segs, seg_count);
     struct zint_seg *local_segs = (struct zint_seg *) z_alloca(sizeof(struct zint_seg) * seg_count);
     unsigned int *ddata = (unsigned int *) z_alloca(sizeof(unsigned int) * eci_length_segs);
-    char *mode = (char *) z_alloca(eci_length_segs);
-    char *prev_mode = (char *) z_alloca(eci_length_segs);
+    char *class_modes = (char *) z_alloca(eci_length_segs * 3);
+    char *mode;
     unsigned char *datastream;
     unsigned char *fullstream;
     unsigned char *grid;
@@ -1644,8 +1584,8 @@ INTERNAL int qrcode(struct zint_symbol *symbol, struct zint_seg segs[], const in
     /* TODO: GS1 General Specifications 22.0 section 5.7.3 says Structured Append and ECIs not supported
        for GS1 QR Code so should check and return ZINT_WARN_NONCOMPLIANT if either true */
 
-    est_binlen = qr_calc_binlen_segs(40, mode, ddata, local_segs, seg_count, p_structapp, 0 /*mode_preset*/, gs1,
-                    debug_print);
+    est_binlen = qr_calc_binlen_class(40, class_modes, class_binlens, eci_length_segs, ddata, local_segs, seg_count,
+                    p_structapp, gs1, debug_print);
 
     ecc_level = QR_LEVEL_L;
     max_cw = 2956;
@@ -1670,81 +1610,28 @@ INTERNAL int qrcode(struct zint_symbol *symbol, struct zint_seg segs[], const in
         return ZINT_ERROR_TOO_LONG;
     }
 
-    autosize = 40;
-    for (i = 39; i >= 0; i--) {
-        switch (ecc_level) {
-            case QR_LEVEL_L:
-                if ((8 * qr_data_codewords_L[i]) >= est_binlen) {
-                    autosize = i + 1;
-                }
-                break;
-            case QR_LEVEL_M:
-                if ((8 * qr_data_codewords_M[i]) >= est_binlen) {
-                    autosize = i + 1;
-                }
-                break;
-            case QR_LEVEL_Q:
-                if ((8 * qr_data_codewords_Q[i]) >= est_binlen) {
-                    autosize = i + 1;
-                }
-                break;
-            case QR_LEVEL_H:
-                if ((8 * qr_data_codewords_H[i]) >= est_binlen) {
-                    autosize = i + 1;
-                }
-                break;
-        }
-    }
+    /* Smallest version that fits the binary length of versions 27-40 */
+    data_codewords = data_codewords_levels[ecc_level - 1];
+    for (autosize = 1; autosize < 40 && (8 * data_codewords[autosize - 1]) < est_binlen; autosize++);
+
     if (autosize != 40) {
-        est_binlen = qr_calc_binlen_segs(autosize, mode, ddata, local_segs, seg_count, p_structapp, 0 /*mode_preset*/,
-                        gs1, debug_print);
+        est_binlen = qr_calc_binlen_class(autosize, class_modes, class_binlens, eci_length_segs, ddata, local_segs,
+                        seg_count, p_structapp, gs1, debug_print);
     }
 
-    /* Now see if the optimised binary will fit in a smaller symbol. */
-    canShrink = 1;
-
-    do {
-        if (autosize == 1) {
-            canShrink = 0;
-        } else {
-            prev_est_binlen = est_binlen;
-            memcpy(prev_mode, mode, eci_length_segs);
-            est_binlen = qr_calc_binlen_segs(autosize - 1, mode, ddata, local_segs, seg_count, p_structapp,
-                            0 /*mode_preset*/, gs1, debug_print);
-
-            switch (ecc_level) {
-                case QR_LEVEL_L:
-                    if ((8 * qr_data_codewords_L[autosize - 2]) < est_binlen) {
-                        canShrink = 0;
-                    }
-                    break;
-                case QR_LEVEL_M:
-                    if ((8 * qr_data_codewords_M[autosize - 2]) < est_binlen) {
-                        canShrink = 0;
-                    }
-                    break;
-                case QR_LEVEL_Q:
-                    if ((8 * qr_data_codewords_Q[autosize - 2]) < est_binlen) {
-                        canShrink = 0;
-                    }
-                    break;
-                case QR_LEVEL_H:
-                    if ((8 * qr_data_codewords_H[autosize - 2]) < est_binlen) {
-                        canShrink = 0;
-                    }
-                    break;
-            }
-
-            if (canShrink == 1) {
-                /* Optimisation worked - data will fit in a smaller symbol */
-                autosize--;
-            } else {
-                /* Data did not fit in the smaller symbol, revert to original size */
-                est_binlen = prev_est_binlen;
-                memcpy(mode, prev_mode, eci_length_segs);
-            }
+    /* Now see if the optimised binary will fit in a smaller symbol (the binary lengths of each version class being
+       only calculated once, this is a lookup unless a smaller class is reached) */
+    while (autosize > 1) {
+        const int binlen = qr_calc_binlen_class(autosize - 1, class_modes, class_binlens, eci_length_segs, ddata,
+                            local_segs, seg_count, p_structapp, gs1, debug_print);
+        if ((8 * data_codewords[autosize - 2]) < binlen) {
+            /* Data did not fit in the smaller symbol */
+            break;
         }
-    } while (canShrink == 1);
+        /* Optimisation worked - data will fit in a smaller symbol */
+        autosize--;
+        est_binlen = binlen;
+    }
 
     version = autosize;
 
@@ -1755,8 +1642,8 @@ INTERNAL int qrcode(struct zint_symbol *symbol, struct zint_seg segs[], const in
          */
         if (symbol->option_2 > version) {
             version = symbol->option_2;
-            est_binlen = qr_calc_binlen_segs(symbol->option_2, mode, ddata, local_segs, seg_count, p_structapp,
-                            0 /*mode_preset*/, gs1, debug_print);
+            est_binlen = qr_calc_binlen_class(version, class_modes, class_binlens, eci_length_segs, ddata, local_segs,
+                            seg_count, p_structapp, gs1, debug_print);
         }
 
         if (symbol->option_2 < version) {
@@ -1765,6 +1652,8 @@ INTERNAL int qrcode(struct zint_symbol *symbol, struct zint_seg segs[], const in
         }
     }
 
+    mode = class_modes + qr_version_class(version) * eci_length_segs;
+
     /* Ensure maxium error correction capacity unless user-specified */
     if (symbol->option_1 == -1 || symbol->option_1 != ecc_level) {
         if (est_binlen <= qr_data_codewords_M[version - 1] * 8) {
@@ -1850,6 +1739,7 @@ static int micro_qr_m1(struct zint_symbol *symbol, char binary_data[], int bp) {
     int data_codewords, ecc_codewords;
     unsigned char data_blocks[4], ecc_blocks[3];
     rs_t rs;
+    const rs_t *p_rs;
 
     bits_total = 20;
     latch = 0;
@@ -1921,9 +1811,8 @@ static int micro_qr_m1(struct zint_symbol *symbol, char binary_data[], int bp) {
 #endif
 
     /* Calculate Reed-Solomon error codewords */
-    rs_init_gf(&rs, 0x11d);
-    rs_init_code(&rs, ecc_codewords, 0);
-    rs_encode(&rs, data_codewords, data_blocks, ecc_blocks);
+    p_rs = rs_init_cached(&rs, 0x11d, ecc_codewords, 0);
+    rs_encode(p_rs, data_codewords, data_blocks, ecc_blocks);
 
     /* Add Reed-Solomon codewords to binary data */
     for (i = 0; i < ecc_codewords; i++) {
@@ -1939,6 +1828,7 @@ static int micro_qr_m2(struct zint_symbol *symbol, char binary_data[], int bp, c
     int data_codewords = 0, ecc_codewords = 0;
     unsigned char data_blocks[6], ecc_blocks[7];
     rs_t rs;
+    const rs_t *p_rs;
 
     latch = 0;
 
@@ -2005,9 +1895,8 @@ static int micro_qr_m2(struct zint_symbol *symbol, char binary_data[], int bp, c
 #endif
 
     /* Calculate Reed-Solomon error codewords */
-    rs_init_gf(&rs, 0x11d);
-    rs_init_code(&rs, ecc_codewords, 0);
-    rs_encode(&rs, data_codewords, data_blocks, ecc_blocks);
+    p_rs = rs_init_cached(&rs, 0x11d, ecc_codewords, 0);
+    rs_encode(p_rs, data_codewords, data_blocks, ecc_blocks);
 
     /* Add Reed-Solomon codewords to binary data */
     for (i = 0; i < ecc_codewords; i++) {
@@ -2023,6 +1912,7 @@ static int micro_qr_m3(struct zint_symbol *symbol, char binary_data[], int bp, c
     int data_codewords = 0, ecc_codewords = 0;
     unsigned char data_blocks[12], ecc_blocks[9];
     rs_t rs;
+    const rs_t *p_rs;
 
     latch = 0;
 
@@ -2121,9 +2011,8 @@ static int micro_qr_m3(struct zint_symbol *symbol, char binary_data[], int bp, c
 #endif
 
     /* Calculate Reed-Solomon error codewords */
-    rs_init_gf(&rs, 0x11d);
-    rs_init_code(&rs, ecc_codewords, 0);
-    rs_encode(&rs, data_codewords, data_blocks, ecc_blocks);
+    p_rs = rs_init_cached(&rs, 0x11d, ecc_codewords, 0);
+    rs_encode(p_rs, data_codewords, data_blocks, ecc_blocks);
 
     /* Add Reed-Solomon codewords to binary data */
     for (i = 0; i < ecc_codewords; i++) {
@@ -2139,6 +2028,7 @@ static int micro_qr_m4(struct zint_symbol *symbol, char binary_data[], int bp, c
     int data_codewords = 0, ecc_codewords = 0;
     unsigned char data_blocks[17], ecc_blocks[15];
     rs_t rs;
+    const rs_t *p_rs;
 
     latch = 0;
 
@@ -2212,9 +2102,8 @@ static int micro_qr_m4(struct zint_symbol *symbol, char binary_data[], int bp, c
 #endif
 
     /* Calculate Reed-Solomon error codewords */
-    rs_init_gf(&rs, 0x11d);
-    rs_init_code(&rs, ecc_codewords, 0);
-    rs_encode(&rs, data_codewords, data_blocks, ecc_blocks);
+    p_rs = rs_init_cached(&rs, 0x11d, ecc_codewords, 0);
+    rs_encode(p_rs, data_codewords, data_blocks, ecc_blocks);
 
     /* Add Reed-Solomon codewords to binary data */
     for (i = 0; i < ecc_codewords; i++) {
@@ -2250,7 +2139,6 @@ static void micro_setup_grid(unsigned char *grid, const int size) {
     }
     grid[(7 * size) + 7] = 0x10;
 
-
     /* Reserve space for format information */
     for (i = 0; i < 8; i++) {
         grid[(8 * size) + i] |= 0x20;
@@ -2391,7 +2279,6 @@ static int micro_apply_bitmask(unsigned char *grid, const int size, const int us
             }
         }
 
-
         /* Evaluate result */
         best_pattern = 0;
         for (pattern = 0; pattern < 4; pattern++) {
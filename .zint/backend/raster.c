@@ -158,6 +158,7 @@ static int save_raster_image_to_file(struct zint_symbol *symbol, const int image
             unsigned char *pixelbuf, int rotate_angle, const int file_type) {
     int error_number;
     int row, column;
+    const double start = symbol->output_options & BARCODE_TIMINGS ? monotonic_ms() : 0.0;
 
     unsigned char *rotated_pixbuf = pixelbuf;
 
@@ -259,6 +260,10 @@ static int save_raster_image_to_file(struct zint_symbol *symbol, const int image
     if (rotate_angle) {
         free(rotated_pixbuf);
     }
+
+    if (symbol->output_options & BARCODE_TIMINGS) {
+        symbol->timings.output = monotonic_ms() - start;
+    }
     return error_number;
 }
 
@@ -1329,6 +1334,13 @@ static int plot_raster_default(struct zint_symbol *symbol, const int rotate_angl
 
 INTERNAL int plot_raster(struct zint_symbol *symbol, int rotate_angle, int file_type) {
     int error;
+    const int timed = symbol->output_options & BARCODE_TIMINGS;
+    double start = 0.0;
+
+    if (timed) {
+        symbol->timings.plot = symbol->timings.output = 0.0;
+        start = monotonic_ms();
+    }
 
 #ifdef NO_PNG
     if (file_type == OUT_PNG_FILE) {
@@ -1350,6 +1362,11 @@ INTERNAL int plot_raster(struct zint_symbol *symbol, int rotate_angle, int file_
         error = plot_raster_default(symbol, rotate_angle, file_type);
     }
 
+    if (timed) {
+        /* The output is timed by `save_raster_image_to_file()` */
+        symbol->timings.plot = monotonic_ms() - start - symbol->timings.output;
+    }
+
     return error;
 }
 
@@ -43,6 +43,9 @@
 // These can be called repeatedly as required - but note that
 // rs_init_code must be called following any rs_init_gf call.
 //
+// Or call p_rs = rs_init_cached(&rs, prime_poly, nsym, index) instead of the first two
+// to reuse the process-wide copy, and rs_encode(p_rs, datalen, data, out).
+//
 // If the parameters are fixed, some of the statics below can be
 // replaced with constants in the obvious way, and additionally
 // malloc/free can be avoided by using static arrays of a suitable
@@ -54,6 +57,47 @@
 #include "reedsol.h"
 #include "reedsol_logs.h"
 
+/* The codes of `rs_init_cached()` and `rs_uint_init_cached()` are set up once per process, lazily, and never change
+   after being published with an atomic compare-and-swap, so can be shared by any number of threads without a lock.
+   Without atomics each encode sets up its own */
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define RS_CACHE
+static void *rs_load_ptr(void *volatile *p) {
+    return _InterlockedCompareExchangePointer(p, NULL, NULL);
+}
+static int rs_cas_ptr(void *volatile *p, void *v) {
+    return _InterlockedCompareExchangePointer(p, v, NULL) == NULL;
+}
+#elif defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7))
+#define RS_CACHE
+static void *rs_load_ptr(void *volatile *p) {
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+static int rs_cas_ptr(void *volatile *p, void *v) {
+    void *expected = NULL;
+    return __atomic_compare_exchange_n(p, &expected, v, 0 /*weak*/, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+#endif
+
+#ifdef RS_CACHE
+/* Return slot `i` of the `size` slots `*p_slots`, allocating them on first use, or NULL if can't */
+static void *volatile *rs_cache_slot(void *volatile *p_slots, const int size, const int i) {
+    void *volatile *slots = (void *volatile *) rs_load_ptr(p_slots);
+
+    if (!slots) {
+        if (!(slots = (void *volatile *) calloc(size, sizeof(void *)))) {
+            return NULL;
+        }
+        if (!rs_cas_ptr(p_slots, (void *) slots)) { /* Lost the race, use the winner's */
+            free((void *) slots);
+            slots = (void *volatile *) rs_load_ptr(p_slots);
+        }
+    }
+    return slots + i;
+}
+#endif
+
 /* rs_init_gf(&rs, prime_poly) initialises the parameters for the Galois Field.
 // The symbol size is determined from the highest bit set in poly
 // This implementation will support sizes up to 8 bits (see rs_uint_init_gf()
@@ -93,6 +137,32 @@ INTERNAL void rs_init_gf(rs_t *rs, const unsigned int prime_poly) {
 
     rs->logt = data[hash].logt;
     rs->alog = data[hash].alog;
+    /* Field size / 16 */
+    for (rs->hi_cnt = 1; ((unsigned int) rs->hi_cnt << 5) <= prime_poly; rs->hi_cnt <<= 1);
+}
+
+/* Set the product of each poly coeff, highest first, with `v << shift` in `rows[v]`, where `rows` holds the products
+   of the smaller values. Single bit values are multiplied using logs, the others are the sum (XOR) of two smaller
+   ones */
+static void rs_init_mul_row(const rs_t *rs, const unsigned int v, const int shift, unsigned char rows[][256]) {
+    int k;
+    const unsigned int rest = v & (v - 1);
+    const int nsym = rs->nsym;
+    unsigned char *row = rows[v];
+
+    if (rest == 0) {
+        const unsigned int log_v = rs->logt[v << shift];
+        for (k = 0; k < nsym; k++) {
+            const int j = nsym - 1 - k;
+            row[k] = rs->rspoly[j] ? rs->alog[log_v + rs->log_rspoly[j]] : 0;
+        }
+    } else {
+        const unsigned char *const row1 = rows[rest];
+        const unsigned char *const row2 = rows[v ^ rest];
+        for (k = 0; k < nsym; k++) {
+            row[k] = row1[k] ^ row2[k];
+        }
+    }
 }
 
 /* rs_init_code(&rs, nsym, index) initialises the Reed-Solomon encoder
@@ -124,102 +194,127 @@ INTERNAL void rs_init_code(rs_t *rs, const int nsym, int index) {
         index++;
     }
 
-    /* Set logs of poly and check if have zero coeffs */
-    rs->zero = 0;
+    /* Set logs of poly */
     for (i = 0; i <= nsym; i++) {
         log_rspoly[i] = logt[rspoly[i]]; /* For simplicity allow log of 0 */
-        rs->zero |= rspoly[i] == 0;
+    }
+
+    /* Set products of poly with each low and high nibble, so that multiplying coeff `nsym - 1 - k` by `m` is
+       `mul_lo[m & 0xF][k] ^ mul_hi[m >> 4][k]` */
+    memset(rs->mul_lo[0], 0, nsym);
+    for (i = 1; i < 16; i++) {
+        rs_init_mul_row(rs, i, 0, rs->mul_lo);
+    }
+    memset(rs->mul_hi[0], 0, nsym);
+    for (i = 1; i < rs->hi_cnt; i++) {
+        rs_init_mul_row(rs, i, 4, rs->mul_hi);
+    }
+}
+
+/* rs_init_cached(&rs, prime_poly, nsym, index) returns the process-wide code for the params, setting it up on
+// first use, or if it can't be cached, initialises rs as rs_init_gf() and rs_init_code() and returns &rs.
+// index must be 0 or 1 for the code to be cached.
+*/
+INTERNAL const rs_t *rs_init_cached(rs_t *rs, const unsigned int prime_poly, const int nsym, const int index) {
+#ifdef RS_CACHE
+    static void *volatile codes[12][2]; /* Slots by field (see `rs_init_gf()`), index and nsym */
+
+    if ((prime_poly >> 5) < ARRAY_SIZE(codes) && (index == 0 || index == 1) && nsym >= 0 && nsym <= 256) {
+        void *volatile *const slot = rs_cache_slot(&codes[prime_poly >> 5][index], 257, nsym);
+        if (slot) {
+            rs_t *code = (rs_t *) rs_load_ptr(slot);
+            if (!code && (code = (rs_t *) malloc(sizeof(rs_t)))) {
+                rs_init_gf(code, prime_poly);
+                rs_init_code(code, nsym, index);
+                if (!rs_cas_ptr(slot, code)) {
+                    free(code);
+                    code = (rs_t *) rs_load_ptr(slot);
+                }
+            }
+            if (code) {
+                return code;
+            }
+        }
+    }
+#endif
+    rs_init_gf(rs, prime_poly);
+    rs_init_code(rs, nsym, index);
+    return rs;
+}
+
+/* Reverse the `len` elements of `a` */
+static void rs_reverse(unsigned char *a, const int len) {
+    int i, j;
+    for (i = 0, j = len - 1; i < j; i++, j--) {
+        const unsigned char t = a[i];
+        a[i] = a[j];
+        a[j] = t;
+    }
+}
+
+static void rs_reverse_uint(unsigned int *a, const int len) {
+    int i, j;
+    for (i = 0, j = len - 1; i < j; i++, j--) {
+        const unsigned int t = a[i];
+        a[i] = a[j];
+        a[j] = t;
     }
 }
 
 /* rs_encode(&rs, datalen, data, res) generates nsym Reed-Solomon codes (nsym as given in rs_init_code())
  * and places them in reverse order in res */
 INTERNAL void rs_encode(const rs_t *rs, const int datalen, const unsigned char *data, unsigned char *res) {
-    int i, k;
-    const unsigned char *const logt = rs->logt;
-    const unsigned char *const alog = rs->alog;
-    const unsigned char *const rspoly = rs->rspoly;
-    const unsigned char *const log_rspoly = rs->log_rspoly;
+    int i, k, h = 0, split;
     const int nsym = rs->nsym;
 
     memset(res, 0, nsym);
-    if (rs->zero) { /* Poly has a zero coeff so need to check in inner loop */
-        for (i = 0; i < datalen; i++) {
-            const unsigned int m = res[nsym - 1] ^ data[i];
-            if (m) {
-                const unsigned int log_m = logt[m];
-                for (k = nsym - 1; k > 0; k--) {
-                    if (rspoly[k])
-                        res[k] = (unsigned char) (res[k - 1] ^ alog[log_m + log_rspoly[k]]);
-                    else
-                        res[k] = res[k - 1];
-                }
-                res[0] = alog[log_m + log_rspoly[0]];
-            } else {
-                memmove(res + 1, res, nsym - 1);
-                res[0] = 0;
-            }
+    /* `res` is used as a ring of the remainder coeffs, highest first from `h`, so that it needn't be shifted */
+    for (i = 0; i < datalen; i++) {
+        const unsigned int m = res[h] ^ data[i];
+        const unsigned char *const mul_lo = rs->mul_lo[m & 0xF];
+        const unsigned char *const mul_hi = rs->mul_hi[m >> 4];
+        res[h] = 0;
+        if (++h == nsym) {
+            h = 0;
         }
-    } else { /* Avoid a branch in inner loop */
-        for (i = 0; i < datalen; i++) {
-            const unsigned int m = res[nsym - 1] ^ data[i];
-            if (m) {
-                const unsigned int log_m = logt[m];
-                for (k = nsym - 1; k > 0; k--) {
-                    res[k] = (unsigned char) (res[k - 1] ^ alog[log_m + log_rspoly[k]]);
-                }
-                res[0] = alog[log_m + log_rspoly[0]];
-            } else {
-                memmove(res + 1, res, nsym - 1);
-                res[0] = 0;
-            }
+        split = nsym - h;
+        for (k = 0; k < split; k++) {
+            res[h + k] ^= mul_lo[k] ^ mul_hi[k];
+        }
+        for (k = split; k < nsym; k++) {
+            res[k - split] ^= mul_lo[k] ^ mul_hi[k];
         }
     }
+    /* Unwind the ring into reverse order */
+    rs_reverse(res, h);
+    rs_reverse(res + h, nsym - h);
 }
 
 /* The same as above but for unsigned int data and result - Aztec code compatible */
 
 INTERNAL void rs_encode_uint(const rs_t *rs, const int datalen, const unsigned int *data, unsigned int *res) {
-    int i, k;
-    const unsigned char *const logt = rs->logt;
-    const unsigned char *const alog = rs->alog;
-    const unsigned char *const rspoly = rs->rspoly;
-    const unsigned char *const log_rspoly = rs->log_rspoly;
+    int i, k, h = 0, split;
     const int nsym = rs->nsym;
 
     memset(res, 0, sizeof(unsigned int) * nsym);
-    if (rs->zero) { /* Poly has a zero coeff so need to check in inner loop */
-        for (i = 0; i < datalen; i++) {
-            const unsigned int m = res[nsym - 1] ^ data[i];
-            if (m) {
-                const unsigned int log_m = logt[m];
-                for (k = nsym - 1; k > 0; k--) {
-                    if (rspoly[k])
-                        res[k] = res[k - 1] ^ alog[log_m + log_rspoly[k]];
-                    else
-                        res[k] = res[k - 1];
-                }
-                res[0] = alog[log_m + log_rspoly[0]];
-            } else {
-                memmove(res + 1, res, sizeof(unsigned int) * (nsym - 1));
-                res[0] = 0;
-            }
+    for (i = 0; i < datalen; i++) {
+        const unsigned int m = res[h] ^ data[i];
+        const unsigned char *const mul_lo = rs->mul_lo[m & 0xF];
+        const unsigned char *const mul_hi = rs->mul_hi[m >> 4];
+        res[h] = 0;
+        if (++h == nsym) {
+            h = 0;
         }
-    } else { /* Avoid a branch in inner loop */
-        for (i = 0; i < datalen; i++) {
-            const unsigned int m = res[nsym - 1] ^ data[i];
-            if (m) {
-                const unsigned int log_m = logt[m];
-                for (k = nsym - 1; k > 0; k--) {
-                    res[k] = res[k - 1] ^ alog[log_m + log_rspoly[k]];
-                }
-                res[0] = alog[log_m + log_rspoly[0]];
-            } else {
-                memmove(res + 1, res, sizeof(unsigned int) * (nsym - 1));
-                res[0] = 0;
-            }
+        split = nsym - h;
+        for (k = 0; k < split; k++) {
+            res[h + k] ^= mul_lo[k] ^ mul_hi[k];
+        }
+        for (k = split; k < nsym; k++) {
+            res[k - split] ^= mul_lo[k] ^ mul_hi[k];
         }
     }
+    rs_reverse_uint(res, h);
+    rs_reverse_uint(res + h, nsym - h);
 }
 
 /* Versions of the above for bitlengths > 8 and <= 30 and unsigned int data and results - Aztec code compatible */
@@ -233,13 +328,15 @@ INTERNAL void rs_encode_uint(const rs_t *rs, const int datalen, const unsigned i
 
 /* `logmod` (field characteristic) will be 2**bitlength - 1, eg 1023 for bitlength 10, 4095 for bitlength 12 */
 INTERNAL int rs_uint_init_gf(rs_uint_t *rs_uint, const unsigned int prime_poly, const int logmod) {
-    int b, p, v;
+    int b, p, v, period = 0;
     unsigned int *logt, *alog;
 
     b = logmod + 1;
 
     rs_uint->logt = NULL;
     rs_uint->alog = NULL;
+    rs_uint->mul = NULL;
+    rs_uint->logmod = 0;
 
     if (!(logt = (unsigned int *) calloc(b, sizeof(unsigned int)))) {
         return 0;
@@ -257,14 +354,21 @@ INTERNAL int rs_uint_init_gf(rs_uint_t *rs_uint, const unsigned int prime_poly,
         p <<= 1;
         if (p & b) /* If overflow */
             p ^= prime_poly; /* Subtract prime poly */
+        if (p == 1 && !period)
+            period = v + 1;
     }
     rs_uint->logt = logt;
     rs_uint->alog = alog;
+    /* Only a primitive poly gives a field, in which products can be tabled (see `rs_uint_init_code()`) */
+    if (period == logmod) {
+        rs_uint->logmod = logmod;
+    }
     return 1;
 }
 
 INTERNAL void rs_uint_init_code(rs_uint_t *rs_uint, const int nsym, int index) {
-    int i, k;
+    int i, k, n;
+    unsigned int v;
     const unsigned int *const logt = rs_uint->logt;
     const unsigned int *const alog = rs_uint->alog;
     unsigned short *rspoly = rs_uint->rspoly;
@@ -293,6 +397,34 @@ INTERNAL void rs_uint_init_code(rs_uint_t *rs_uint, const int nsym, int index) {
         log_rspoly[i] = logt[rspoly[i]]; /* For simplicity allow log of 0 */
         rs_uint->zero |= rspoly[i] == 0;
     }
+
+    /* Set products of poly with each of the 3 nibbles, as for `rs_init_code()`, if can (else encode using logs) */
+    free(rs_uint->mul);
+    rs_uint->mul = NULL;
+    if (rs_uint->logmod && (rs_uint->mul = (unsigned short *) malloc(sizeof(unsigned short) * 3 * 16 * (nsym ? nsym : 1)))) {
+        for (n = 0; n < 3; n++) {
+            unsigned short *const rows = rs_uint->mul + n * 16 * nsym;
+            const unsigned int row_cnt = (rs_uint->logmod + 1) >> (n * 4) < 16 ? (rs_uint->logmod + 1) >> (n * 4) : 16;
+            memset(rows, 0, sizeof(unsigned short) * nsym);
+            for (v = 1; v < row_cnt; v++) {
+                const unsigned int rest = v & (v - 1);
+                unsigned short *const row = rows + v * nsym;
+                if (rest == 0) {
+                    const unsigned int log_v = logt[v << (n * 4)];
+                    for (k = 0; k < nsym; k++) {
+                        const int j = nsym - 1 - k;
+                        row[k] = rspoly[j] ? (unsigned short) alog[log_v + log_rspoly[j]] : 0;
+                    }
+                } else {
+                    const unsigned short *const row1 = rows + rest * nsym;
+                    const unsigned short *const row2 = rows + (v ^ rest) * nsym;
+                    for (k = 0; k < nsym; k++) {
+                        row[k] = row1[k] ^ row2[k];
+                    }
+                }
+            }
+        }
+    }
 }
 
 INTERNAL void rs_uint_encode(const rs_uint_t *rs_uint, const int datalen, const unsigned int *data,
@@ -308,7 +440,30 @@ INTERNAL void rs_uint_encode(const rs_uint_t *rs_uint, const int datalen, const
     if (logt == NULL || alog == NULL) {
         return;
     }
-    if (rs_uint->zero) { /* Poly has a zero coeff so need to check in inner loop */
+    if (rs_uint->mul) {
+        const unsigned short *const mul = rs_uint->mul;
+        int h = 0, split;
+        /* As `rs_encode()` */
+        for (i = 0; i < datalen; i++) {
+            const unsigned int m = res[h] ^ data[i];
+            const unsigned short *const mul0 = mul + (m & 0xF) * nsym;
+            const unsigned short *const mul1 = mul + (16 + ((m >> 4) & 0xF)) * nsym;
+            const unsigned short *const mul2 = mul + (32 + (m >> 8)) * nsym;
+            res[h] = 0;
+            if (++h == nsym) {
+                h = 0;
+            }
+            split = nsym - h;
+            for (k = 0; k < split; k++) {
+                res[h + k] ^= mul0[k] ^ mul1[k] ^ mul2[k];
+            }
+            for (k = split; k < nsym; k++) {
+                res[k - split] ^= mul0[k] ^ mul1[k] ^ mul2[k];
+            }
+        }
+        rs_reverse_uint(res, h);
+        rs_reverse_uint(res + h, nsym - h);
+    } else if (rs_uint->zero) { /* Poly has a zero coeff so need to check in inner loop */
         for (i = 0; i < datalen; i++) {
             const unsigned int m = res[nsym - 1] ^ data[i];
             if (m) {
@@ -342,6 +497,65 @@ INTERNAL void rs_uint_encode(const rs_uint_t *rs_uint, const int datalen, const
     }
 }
 
+/* rs_uint_init_cached(&rs_uint, prime_poly, logmod, nsym, index) returns the process-wide code for the params as
+// rs_init_cached(), the log tables being shared by the codes of a field. If it can't be cached, initialises rs_uint
+// as rs_uint_init_gf() and rs_uint_init_code() and returns &rs_uint, or NULL if rs_uint_init_gf() fails.
+// Either way rs_uint_free(&rs_uint) must be called after.
+// Only the Aztec fields 0x409 (logmod 1023) and 0x1069 (logmod 4095) are cached.
+*/
+INTERNAL const rs_uint_t *rs_uint_init_cached(rs_uint_t *rs_uint, const unsigned int prime_poly, const int logmod,
+                const int nsym, const int index) {
+#ifdef RS_CACHE
+    static void *volatile gfs[2]; /* Log tables by field */
+    static void *volatile codes[2][2]; /* Slots by field, index and nsym */
+    const int field = prime_poly == 0x409 && logmod == 1023 ? 0 : prime_poly == 0x1069 && logmod == 4095 ? 1 : -1;
+#endif
+
+    rs_uint->logt = NULL;
+    rs_uint->alog = NULL;
+    rs_uint->mul = NULL;
+
+#ifdef RS_CACHE
+    if (field != -1 && (index == 0 || index == 1) && nsym >= 0 && nsym <= logmod) {
+        rs_uint_t *gf = (rs_uint_t *) rs_load_ptr(&gfs[field]);
+        void *volatile *slot;
+        if (!gf && (gf = (rs_uint_t *) malloc(sizeof(rs_uint_t)))) {
+            if (!rs_uint_init_gf(gf, prime_poly, logmod)) {
+                free(gf);
+                gf = NULL;
+            } else if (!rs_cas_ptr(&gfs[field], gf)) {
+                rs_uint_free(gf);
+                free(gf);
+                gf = (rs_uint_t *) rs_load_ptr(&gfs[field]);
+            }
+        }
+        if (gf && (slot = rs_cache_slot(&codes[field][index], logmod + 1, nsym))) {
+            rs_uint_t *code = (rs_uint_t *) rs_load_ptr(slot);
+            if (!code && (code = (rs_uint_t *) malloc(sizeof(rs_uint_t)))) {
+                code->logt = gf->logt;
+                code->alog = gf->alog;
+                code->logmod = gf->logmod;
+                code->mul = NULL;
+                rs_uint_init_code(code, nsym, index);
+                if (!rs_cas_ptr(slot, code)) {
+                    free(code->mul);
+                    free(code);
+                    code = (rs_uint_t *) rs_load_ptr(slot);
+                }
+            }
+            if (code) {
+                return code;
+            }
+        }
+    }
+#endif
+    if (!rs_uint_init_gf(rs_uint, prime_poly, logmod)) {
+        return NULL;
+    }
+    rs_uint_init_code(rs_uint, nsym, index);
+    return rs_uint;
+}
+
 INTERNAL void rs_uint_free(rs_uint_t *rs_uint) {
     if (rs_uint->logt) {
         free(rs_uint->logt);
@@ -351,6 +565,10 @@ INTERNAL void rs_uint_free(rs_uint_t *rs_uint) {
         free(rs_uint->alog);
         rs_uint->alog = NULL;
     }
+    if (rs_uint->mul) {
+        free(rs_uint->mul);
+        rs_uint->mul = NULL;
+    }
 }
 
 /* vim: set ts=4 sw=4 et : */
@@ -43,8 +43,10 @@ typedef struct {
     const unsigned char *alog;
     unsigned char rspoly[256]; /* Generated poly */
     unsigned char log_rspoly[256]; /* Logs of poly */
+    unsigned char mul_lo[16][256]; /* Products of the poly coeffs with each low nibble */
+    unsigned char mul_hi[16][256]; /* Products of the poly coeffs with each high nibble */
+    int hi_cnt; /* Number of high nibbles in the field */
     int nsym; /* Degree of poly */
-    int zero; /* Set if poly has a zero coeff */
 } rs_t;
 
 typedef struct {
@@ -52,6 +54,8 @@ typedef struct {
     unsigned int *alog;
     unsigned short rspoly[4096]; /* Generated poly, 12-bit max - needs to be enlarged if > 12-bit used */
     unsigned int log_rspoly[4096]; /* Logs of poly */
+    unsigned short *mul; /* Products of the poly coeffs with each nibble, malloced, NULL if not available */
+    int logmod; /* Field characteristic, 0 if poly not primitive */
     int nsym; /* Degree of poly */
     int zero; /* Set if poly has a zero coeff */
 } rs_uint_t;
@@ -61,12 +65,15 @@ INTERNAL void rs_init_code(rs_t *rs, const int nsym, int index);
 INTERNAL void rs_encode(const rs_t *rs, const int datalen, const unsigned char *data, unsigned char *res);
 INTERNAL void rs_encode_uint(const rs_t *rs, const int datalen, const unsigned int *data, unsigned int *res);
 /* No free needed as log tables static */
+INTERNAL const rs_t *rs_init_cached(rs_t *rs, const unsigned int prime_poly, const int nsym, const int index);
 
 INTERNAL int rs_uint_init_gf(rs_uint_t *rs_uint, const unsigned int prime_poly, const int logmod);
 INTERNAL void rs_uint_init_code(rs_uint_t *rs_uint, const int nsym, int index);
 INTERNAL void rs_uint_encode(const rs_uint_t *rs_uint, const int datalen, const unsigned int *data,
                 unsigned int *res);
 INTERNAL void rs_uint_free(rs_uint_t *rs_uint);
+INTERNAL const rs_uint_t *rs_uint_init_cached(rs_uint_t *rs_uint, const unsigned int prime_poly, const int logmod,
+                const int nsym, const int index);
 
 #ifdef __cplusplus
 }
@@ -31,11 +31,10 @@
 /* SPDX-License-Identifier: BSD-3-Clause */
 
 #include <errno.h>
-#include <locale.h>
 #include <math.h>
 #include <stdio.h>
-
 #include "common.h"
+#include "filemem.h"
 
 static void pick_colour(int colour, char colour_code[]) {
     switch (colour) {
@@ -111,17 +110,10 @@ static void make_html_friendly(unsigned char *string, char *html_version) {
     }
 }
 
-
-int pipe(int fd[2]);
-int close(int fildes);
-int read(int fildes, void *buf, unsigned nbytes);
-
 INTERNAL int svg_plot(struct zint_symbol *symbol) {
-  char *buf = malloc(sizeof(symbol->rendered_data));
-  int p[2];
-    FILE *fsvg;
+    struct filemem fm;
+    struct filemem *const fmp = &fm;
     int error_number = 0;
-    const char *locale = NULL;
     float ax, ay, bx, by, cx, cy, dx, dy, ex, ey, fx, fy;
     float previous_diameter;
     float radius, half_radius, half_sqrt3_radius;
@@ -187,57 +179,43 @@ INTERNAL int svg_plot(struct zint_symbol *symbol) {
         strcpy(symbol->errtxt, "681: Vector header NULL");
         return ZINT_ERROR_INVALID_DATA;
     }
-    if (symbol->output_options & BARCODE_STDOUT) {
-        
-#ifndef _MSC_VER
-  pipe(p);
-  fsvg = fdopen(p[1], "w");
-#else
-  fsvg = fopen("NUL", "w");
-  setvbuf(fsvg, buf, _IOLBF, sizeof(symbol->rendered_data));
-#endif
-
-    } else {
-        if (!(fsvg = fopen(symbol->outfile, "w"))) {
-            sprintf(symbol->errtxt, "680: Could not open output file (%d: %.30s)", errno, strerror(errno));
-            return ZINT_ERROR_FILE_ACCESS;
-        }
+    if (!fm_open(fmp, symbol, "w")) {
+        sprintf(symbol->errtxt, "680: Could not open output file (%d: %.30s)", fmp->err, strerror(fmp->err));
+        return ZINT_ERROR_FILE_ACCESS;
     }
 
-    locale = setlocale(LC_ALL, "C");
-
     /* Start writing the header */
-    fprintf(fsvg, "<?xml version=\"1.0\" standalone=\"no\"?>\n");
-    fprintf(fsvg, "<!DOCTYPE svg PUBLIC \"-//W3C//DTD SVG 1.1//EN\"\n");
-    fprintf(fsvg, "   \"http://www.w3.org/Graphics/SVG/1.1/DTD/svg11.dtd\">\n");
-    fprintf(fsvg, "<svg width=\"%d\" height=\"%d\" version=\"1.1\"\n",
+    fm_printf(fmp, "<?xml version=\"1.0\" standalone=\"no\"?>\n");
+    fm_printf(fmp, "<!DOCTYPE svg PUBLIC \"-//W3C//DTD SVG 1.1//EN\"\n");
+    fm_printf(fmp, "   \"http://www.w3.org/Graphics/SVG/1.1/DTD/svg11.dtd\">\n");
+    fm_printf(fmp, "<svg width=\"%d\" height=\"%d\" version=\"1.1\"\n",
             (int) ceilf(symbol->vector->width), (int) ceilf(symbol->vector->height));
-    fprintf(fsvg, "   xmlns=\"http://www.w3.org/2000/svg\">\n");
-    fprintf(fsvg, "   <desc>Zint Generated Symbol\n");
-    fprintf(fsvg, "   </desc>\n");
-    fprintf(fsvg, "\n   <g id=\"barcode\" fill=\"#%s\">\n", fgcolour_string);
+    fm_printf(fmp, "   xmlns=\"http://www.w3.org/2000/svg\">\n");
+    fm_printf(fmp, "   <desc>Zint Generated Symbol\n");
+    fm_printf(fmp, "   </desc>\n");
+    fm_printf(fmp, "\n   <g id=\"barcode\" fill=\"#%s\">\n", fgcolour_string);
 
     if (bg_alpha != 0) {
-        fprintf(fsvg, "      <rect x=\"0\" y=\"0\" width=\"%d\" height=\"%d\" fill=\"#%s\"",
+        fm_printf(fmp, "      <rect x=\"0\" y=\"0\" width=\"%d\" height=\"%d\" fill=\"#%s\"",
                 (int) ceilf(symbol->vector->width), (int) ceilf(symbol->vector->height), bgcolour_string);
         if (bg_alpha != 0xff) {
-            fprintf(fsvg, " opacity=\"%.3f\"", bg_alpha_opacity);
+            fm_printf(fmp, " opacity=\"%.3f\"", bg_alpha_opacity);
         }
-        fprintf(fsvg, " />\n");
+        fm_printf(fmp, " />\n");
     }
 
     rect = symbol->vector->rectangles;
     while (rect) {
-        fprintf(fsvg, "      <rect x=\"%.2f\" y=\"%.2f\" width=\"%.2f\" height=\"%.2f\"",
+        fm_printf(fmp, "      <rect x=\"%.2f\" y=\"%.2f\" width=\"%.2f\" height=\"%.2f\"",
                 rect->x, rect->y, rect->width, rect->height);
         if (rect->colour != -1) {
             pick_colour(rect->colour, colour_code);
-            fprintf(fsvg, " fill=\"#%s\"", colour_code);
+            fm_printf(fmp, " fill=\"#%s\"", colour_code);
         }
         if (fg_alpha != 0xff) {
-            fprintf(fsvg, " opacity=\"%.3f\"", fg_alpha_opacity);
+            fm_printf(fmp, " opacity=\"%.3f\"", fg_alpha_opacity);
         }
-        fprintf(fsvg, " />\n");
+        fm_printf(fmp, " />\n");
         rect = rect->next;
     }
 
@@ -277,12 +255,12 @@ INTERNAL int svg_plot(struct zint_symbol *symbol) {
             ex = hex->x + half_radius;
             fx = hex->x - half_radius;
         }
-        fprintf(fsvg, "      <path d=\"M %.2f %.2f L %.2f %.2f L %.2f %.2f L %.2f %.2f L %.2f %.2f L %.2f %.2f Z\"",
+        fm_printf(fmp, "      <path d=\"M %.2f %.2f L %.2f %.2f L %.2f %.2f L %.2f %.2f L %.2f %.2f L %.2f %.2f Z\"",
                 ax, ay, bx, by, cx, cy, dx, dy, ex, ey, fx, fy);
         if (fg_alpha != 0xff) {
-            fprintf(fsvg, " opacity=\"%.3f\"", fg_alpha_opacity);
+            fm_printf(fmp, " opacity=\"%.3f\"", fg_alpha_opacity);
         }
-        fprintf(fsvg, " />\n");
+        fm_printf(fmp, " />\n");
         hex = hex->next;
     }
 
@@ -293,28 +271,28 @@ INTERNAL int svg_plot(struct zint_symbol *symbol) {
             previous_diameter = circle->diameter;
             radius = (float) (0.5 * previous_diameter);
         }
-        fprintf(fsvg, "      <circle cx=\"%.2f\" cy=\"%.2f\" r=\"%.*f\"",
+        fm_printf(fmp, "      <circle cx=\"%.2f\" cy=\"%.2f\" r=\"%.*f\"",
                 circle->x, circle->y, circle->width ? 3 : 2, radius);
 
         if (circle->colour) {
             if (circle->width) {
-                fprintf(fsvg, " stroke=\"#%s\" stroke-width=\"%.3f\" fill=\"none\"", bgcolour_string, circle->width);
+                fm_printf(fmp, " stroke=\"#%s\" stroke-width=\"%.3f\" fill=\"none\"", bgcolour_string, circle->width);
             } else {
-                fprintf(fsvg, " fill=\"#%s\"", bgcolour_string);
+                fm_printf(fmp, " fill=\"#%s\"", bgcolour_string);
             }
             if (bg_alpha != 0xff) {
                 /* This doesn't work how the user is likely to expect - more work needed! */
-                fprintf(fsvg, " opacity=\"%.3f\"", bg_alpha_opacity);
+                fm_printf(fmp, " opacity=\"%.3f\"", bg_alpha_opacity);
             }
         } else {
             if (circle->width) {
-                fprintf(fsvg, " stroke=\"#%s\" stroke-width=\"%.3f\" fill=\"none\"", fgcolour_string, circle->width);
+                fm_printf(fmp, " stroke=\"#%s\" stroke-width=\"%.3f\" fill=\"none\"", fgcolour_string, circle->width);
             }
             if (fg_alpha != 0xff) {
-                fprintf(fsvg, " opacity=\"%.3f\"", fg_alpha_opacity);
+                fm_printf(fmp, " opacity=\"%.3f\"", fg_alpha_opacity);
             }
         }
-        fprintf(fsvg, " />\n");
+        fm_printf(fmp, " />\n");
         circle = circle->next;
     }
 
@@ -323,44 +301,31 @@ INTERNAL int svg_plot(struct zint_symbol *symbol) {
     string = symbol->vector->strings;
     while (string) {
         const char *const halign = string->halign == 2 ? "end" : string->halign == 1 ? "start" : "middle";
-        fprintf(fsvg, "      <text x=\"%.2f\" y=\"%.2f\" text-anchor=\"%s\"\n", string->x, string->y, halign);
-        fprintf(fsvg, "         font-family=\"%s\" font-size=\"%.1f\"", font_family, string->fsize);
+        fm_printf(fmp, "      <text x=\"%.2f\" y=\"%.2f\" text-anchor=\"%s\"\n", string->x, string->y, halign);
+        fm_printf(fmp, "         font-family=\"%s\" font-size=\"%.1f\"", font_family, string->fsize);
         if (bold) {
-            fprintf(fsvg, " font-weight=\"bold\"");
+            fm_printf(fmp, " font-weight=\"bold\"");
         }
         if (fg_alpha != 0xff) {
-            fprintf(fsvg, " opacity=\"%.3f\"", fg_alpha_opacity);
+            fm_printf(fmp, " opacity=\"%.3f\"", fg_alpha_opacity);
         }
         if (string->rotation != 0) {
-            fprintf(fsvg, " transform=\"rotate(%d,%.2f,%.2f)\"", string->rotation, string->x, string->y);
+            fm_printf(fmp, " transform=\"rotate(%d,%.2f,%.2f)\"", string->rotation, string->x, string->y);
         }
-        fprintf(fsvg, " >\n");
+        fm_printf(fmp, " >\n");
         make_html_friendly(string->text, html_string);
-        fprintf(fsvg, "         %s\n", html_string);
-        fprintf(fsvg, "      </text>\n");
+        fm_printf(fmp, "         %s\n", html_string);
+        fm_printf(fmp, "      </text>\n");
         string = string->next;
     }
 
-    fprintf(fsvg, "   </g>\n");
-    fprintf(fsvg, "</svg>\n");
-
-    if (symbol->output_options & BARCODE_STDOUT) {
-        
-fprintf(fsvg, "<<< EOF >>>");
-#ifndef _MSC_VER
-  fflush(fsvg);
-  close(p[1]);
-  read(p[0], symbol->rendered_data, sizeof(symbol->rendered_data));
-#else
-  strcpy(symbol->rendered_data, buf);
-#endif
-
-    } else {
-        fclose(fsvg);
-    }
+    fm_printf(fmp, "   </g>\n");
+    fm_printf(fmp, "</svg>\n");
 
-    if (locale)
-        setlocale(LC_ALL, locale);
+    if (!fm_close(fmp, symbol)) {
+        sprintf(symbol->errtxt, "682: Failure on closing output file (%d: %.30s)", fmp->err, strerror(fmp->err));
+        error_number = ZINT_ERROR_FILE_WRITE;
+    }
 
     return error_number;
 }
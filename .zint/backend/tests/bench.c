@@ -0,0 +1,430 @@
+/*
+    libzint - the open source barcode library
+    Copyright (C) 2026 Robin Stuart <rstuart114@gmail.com>
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+
+    1. Redistributions of source code must retain the above copyright
+       notice, this list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+    3. Neither the name of the project nor the names of its contributors
+       may be used to endorse or promote products derived from this software
+       without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+    OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+    HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+    OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+ */
+/* SPDX-License-Identifier: BSD-3-Clause */
+
+/*
+ * Benchmark harness (not a test): runs a corpus of representative payloads through the encode, raster, vector and
+ * file output paths, and reports ops/s, p50/p99 latency and bytes allocated per op, as a table or as JSON (`-j`).
+ * The corpus is the same as that of `scripts/bench.js`, so that both report comparable results.
+ *
+ *   bench [-c case] [-p path[,path...]] [-n iterations] [-t ms] [-w warmups] [-j]
+ */
+
+#include "testcommon.h"
+#include <getopt.h>
+#include <limits.h>
+
+#if defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__)
+/* Count the allocations of each op by interposing the allocator (glibc only) */
+#define BENCH_COUNT_ALLOCS
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t nmemb, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+
+static int bench_counting;
+static size_t bench_alloc_bytes;
+static size_t bench_allocs;
+
+void *malloc(size_t size) {
+    if (bench_counting) {
+        bench_alloc_bytes += size;
+        bench_allocs++;
+    }
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t nmemb, size_t size) {
+    if (bench_counting) {
+        bench_alloc_bytes += nmemb * size;
+        bench_allocs++;
+    }
+    return __libc_calloc(nmemb, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+    if (bench_counting) {
+        bench_alloc_bytes += size;
+        bench_allocs++;
+    }
+    return __libc_realloc(ptr, size);
+}
+#endif
+
+#define BENCH_MIN_ITERATIONS    10
+
+/* Characters of the generated payloads (URL-like text, so that every symbology picks a mix of modes) */
+static const char bench_text[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789 -./:";
+static const char bench_digits[] = "0123456789";
+
+/* Error message of the last op that failed */
+static char bench_errtxt[sizeof(((struct zint_symbol *) 0)->errtxt)];
+
+struct bench_case {
+    const char *name;
+    int symbology;
+    int option_1;
+    int option_2;
+    const char *data;       /* Fixed data, or NULL to generate `length` characters of `charset` */
+    int length;
+    const char *charset;
+    const char *primary;    /* Linear component of composites */
+};
+
+/* Keep in sync with `cases` of `scripts/bench.js` */
+static const struct bench_case bench_cases[] = {
+    { "ean13", BARCODE_EANX, -1, -1, "5901234123457", 0, NULL, NULL },
+    { "code128-100", BARCODE_CODE128, -1, -1, NULL, 100, bench_digits, NULL },
+    { "qr-1k", BARCODE_QRCODE, -1, -1, NULL, 1024, bench_text, NULL },
+    { "qr-3k", BARCODE_QRCODE, -1, -1, NULL, 2900, bench_text, NULL },
+    { "datamatrix-1k", BARCODE_DATAMATRIX, -1, -1, NULL, 1024, bench_text, NULL },
+    { "pdf417-1k", BARCODE_PDF417, -1, -1, NULL, 1024, bench_text, NULL },
+    { "aztec-1k", BARCODE_AZTEC, -1, -1, NULL, 1024, bench_text, NULL },
+    { "dotcode-1k", BARCODE_DOTCODE, -1, 150 /* columns, as too wide otherwise */, NULL, 1024, bench_text, NULL },
+    { "ean13-cc", BARCODE_EANX_CC, 1, -1, "[99]1234-abcd", 0, NULL, "331234567890" },
+    { "gs1-128-cc", BARCODE_GS1_128_CC, 3, -1, "[10]ABC123[21]SN0123456789[17]251231", 0, NULL,
+        "[01]12345678901231" },
+};
+
+enum bench_path_type { BENCH_ENCODE, BENCH_RASTER, BENCH_VECTOR, BENCH_FILE };
+
+struct bench_path {
+    const char *name;
+    enum bench_path_type type;
+    const char *outfile;    /* Rendered in memory (`BARCODE_MEMORY_FILE`) */
+};
+
+static const struct bench_path bench_paths[] = {
+    { "encode", BENCH_ENCODE, NULL },
+    { "raster", BENCH_RASTER, NULL },
+    { "vector", BENCH_VECTOR, NULL },
+#ifndef NO_PNG
+    { "png", BENCH_FILE, "out.png" },
+#endif
+    { "svg", BENCH_FILE, "out.svg" },
+    { "eps", BENCH_FILE, "out.eps" },
+    { "emf", BENCH_FILE, "out.emf" },
+    { "gif", BENCH_FILE, "out.gif" },
+    { "bmp", BENCH_FILE, "out.bmp" },
+    { "pcx", BENCH_FILE, "out.pcx" },
+    { "tif", BENCH_FILE, "out.tif" },
+};
+
+struct bench_result {
+    int iterations;
+    double total_ms;
+    double p50_ms;
+    double p99_ms;
+    size_t alloc_bytes;
+    size_t allocs;
+};
+
+/* Generates `length` characters of payload, the same for every run (LCG of `scripts/bench.js`) */
+static void bench_generate(unsigned char *data, const int length, const char *charset) {
+    const unsigned int charset_len = (unsigned int) strlen(charset);
+    unsigned int seed = 1;
+    int i;
+
+    for (i = 0; i < length; i++) {
+        seed = (seed * 1103515245u + 12345u) & 0x7FFFFFFF;
+        data[i] = charset[(seed >> 16) % charset_len];
+    }
+    data[length] = '\0';
+}
+
+/* Creates, encodes, renders (if the path does) and deletes one symbol. Returns the zint status */
+static int bench_op(const struct bench_case *bcase, const struct bench_path *path, const unsigned char *data,
+            const int length) {
+    struct zint_symbol *symbol = ZBarcode_Create();
+    int ret;
+
+    if (symbol == NULL) {
+        return ZINT_ERROR_MEMORY;
+    }
+    symbol->symbology = bcase->symbology;
+    if (bcase->option_1 != -1) {
+        symbol->option_1 = bcase->option_1;
+    }
+    if (bcase->option_2 != -1) {
+        symbol->option_2 = bcase->option_2;
+    }
+    if (bcase->primary) {
+        strcpy(symbol->primary, bcase->primary);
+    }
+
+    switch (path->type) {
+        case BENCH_ENCODE:
+            ret = ZBarcode_Encode(symbol, data, length);
+            break;
+        case BENCH_RASTER:
+            ret = ZBarcode_Encode_and_Buffer(symbol, data, length, 0);
+            break;
+        case BENCH_VECTOR:
+            ret = ZBarcode_Encode_and_Buffer_Vector(symbol, data, length, 0);
+            break;
+        default:
+            symbol->output_options |= BARCODE_MEMORY_FILE;
+            strcpy(symbol->outfile, path->outfile);
+            ret = ZBarcode_Encode_and_Print(symbol, data, length, 0);
+            break;
+    }
+
+    if (ret >= ZINT_ERROR) {
+        strcpy(bench_errtxt, symbol->errtxt);
+    }
+    ZBarcode_Delete(symbol);
+
+    return ret;
+}
+
+static int bench_compare(const void *a, const void *b) {
+    const double da = *(const double *) a, db = *(const double *) b;
+    return da < db ? -1 : da > db;
+}
+
+/* Nearest-rank percentile of sorted latencies */
+static double bench_percentile(const double *sorted, const int count, const double percentile) {
+    int rank = (int) (percentile * count + 0.999999);
+
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+/* Runs `iterations` ops, or if 0, as many as fit in `min_ms` (at least `BENCH_MIN_ITERATIONS`).
+   Returns 0, or the zint error of the first op that failed */
+static int bench_measure(const struct bench_case *bcase, const struct bench_path *path, const unsigned char *data,
+            const int length, const int iterations, const double min_ms, const int warmups,
+            struct bench_result *result) {
+    int capacity = iterations ? iterations : 1024;
+    double *latencies = (double *) malloc(sizeof(double) * capacity);
+    double start;
+    int i, ret;
+
+    memset(result, 0, sizeof(*result));
+
+    if (latencies == NULL) {
+        return ZINT_ERROR_MEMORY;
+    }
+
+    for (i = 0; i < warmups; i++) {
+        if ((ret = bench_op(bcase, path, data, length)) >= ZINT_ERROR) {
+            free(latencies);
+            return ret;
+        }
+    }
+
+    while (iterations ? result->iterations < iterations
+            : result->total_ms < min_ms || result->iterations < BENCH_MIN_ITERATIONS) {
+        if (result->iterations == capacity) {
+            double *grown = (double *) realloc(latencies, sizeof(double) * capacity * 2);
+            if (grown == NULL) {
+                free(latencies);
+                return ZINT_ERROR_MEMORY;
+            }
+            latencies = grown;
+            capacity *= 2;
+        }
+
+        start = monotonic_ms();
+#ifdef BENCH_COUNT_ALLOCS
+        bench_counting = 1;
+#endif
+        ret = bench_op(bcase, path, data, length);
+#ifdef BENCH_COUNT_ALLOCS
+        bench_counting = 0;
+#endif
+        latencies[result->iterations] = monotonic_ms() - start;
+
+        if (ret >= ZINT_ERROR) {
+            free(latencies);
+            return ret;
+        }
+        result->total_ms += latencies[result->iterations++];
+    }
+
+#ifdef BENCH_COUNT_ALLOCS
+    result->alloc_bytes = bench_alloc_bytes;
+    result->allocs = bench_allocs;
+    bench_alloc_bytes = bench_allocs = 0;
+#endif
+
+    qsort(latencies, result->iterations, sizeof(double), bench_compare);
+    result->p50_ms = bench_percentile(latencies, result->iterations, 0.50);
+    result->p99_ms = bench_percentile(latencies, result->iterations, 0.99);
+
+    free(latencies);
+
+    return 0;
+}
+
+/* Whether `name` is one of the comma-separated `list` (or `list` is NULL) */
+static int bench_selected(const char *list, const char *name) {
+    const size_t len = strlen(name);
+    const char *s = list;
+
+    if (list == NULL) {
+        return 1;
+    }
+    while ((s = strstr(s, name)) != NULL) {
+        if ((s == list || s[-1] == ',') && (s[len] == '\0' || s[len] == ',')) {
+            return 1;
+        }
+        s += len;
+    }
+    return 0;
+}
+
+static void bench_print(const int json, const int first, const struct bench_case *bcase,
+            const struct bench_path *path, const int length, const struct bench_result *result) {
+    const double ops_per_sec = result->total_ms > 0.0 ? result->iterations * 1000.0 / result->total_ms : 0.0;
+
+    if (!json) {
+        if (first) {
+            printf("%-16s %-8s %10s %12s %10s %10s %12s %10s\n", "case", "path", "iterations", "ops/s", "p50 (us)",
+                    "p99 (us)", "bytes/op", "allocs/op");
+        }
+#ifdef BENCH_COUNT_ALLOCS
+        printf("%-16s %-8s %10d %12.1f %10.1f %10.1f %12.0f %10.1f\n", bcase->name, path->name, result->iterations,
+                ops_per_sec, result->p50_ms * 1000.0, result->p99_ms * 1000.0,
+                (double) result->alloc_bytes / result->iterations, (double) result->allocs / result->iterations);
+#else
+        printf("%-16s %-8s %10d %12.1f %10.1f %10.1f %12s %10s\n", bcase->name, path->name, result->iterations,
+                ops_per_sec, result->p50_ms * 1000.0, result->p99_ms * 1000.0, "-", "-");
+#endif
+        return;
+    }
+
+    printf("%s\n    {\"case\": \"%s\", \"path\": \"%s\", \"symbology\": %d, \"length\": %d, \"iterations\": %d,"
+            " \"ops_per_sec\": %.3f, \"p50_us\": %.3f, \"p99_us\": %.3f,", first ? "" : ",", bcase->name, path->name,
+            bcase->symbology, length, result->iterations, ops_per_sec, result->p50_ms * 1000.0,
+            result->p99_ms * 1000.0);
+#ifdef BENCH_COUNT_ALLOCS
+    printf(" \"bytes_per_op\": %.1f, \"allocs_per_op\": %.2f}", (double) result->alloc_bytes / result->iterations,
+            (double) result->allocs / result->iterations);
+#else
+    printf(" \"bytes_per_op\": null, \"allocs_per_op\": null}");
+#endif
+}
+
+static int bench_int_opt(const char *opt, const char *name, int *value) {
+    char *endptr = NULL;
+    long long_opt;
+
+    errno = 0;
+    long_opt = strtol(opt, &endptr, 10);
+    if (errno || endptr == opt || long_opt < 0 || long_opt > INT_MAX) {
+        fprintf(stderr, "bench: -%s value invalid\n", name);
+        return 0;
+    }
+    *value = (int) long_opt;
+    return 1;
+}
+
+int main(int argc, char *argv[]) {
+    const char *case_list = NULL, *path_list = NULL;
+    int iterations = 0, min_ms = 200, warmups = 3, json = 0;
+    int opt, i, j, length, ret, first = 1, failed = 0;
+    unsigned char data[4096];
+    struct bench_result result;
+
+    while ((opt = getopt(argc, argv, "c:p:n:t:w:jh")) != -1) {
+        switch (opt) {
+            case 'c':
+                case_list = optarg;
+                break;
+            case 'p':
+                path_list = optarg;
+                break;
+            case 'n':
+                if (!bench_int_opt(optarg, "n", &iterations)) return 1;
+                break;
+            case 't':
+                if (!bench_int_opt(optarg, "t", &min_ms)) return 1;
+                break;
+            case 'w':
+                if (!bench_int_opt(optarg, "w", &warmups)) return 1;
+                break;
+            case 'j':
+                json = 1;
+                break;
+            default:
+                printf("Usage: bench [-c case[,case...]] [-p path[,path...]] [-n iterations] [-t ms] [-w warmups] [-j]\n");
+                printf("  -n  fixed number of iterations per case and path (default: as many as fit in -t)\n");
+                printf("  -t  minimum time per case and path, in milliseconds (default 200)\n");
+                printf("  -w  unmeasured warm-up iterations (default 3)\n");
+                printf("  -j  JSON output\n");
+                return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    if (json) {
+        printf("{\"harness\": \"zint\", \"version\": %d, \"results\": [", ZBarcode_Version());
+    }
+
+    for (i = 0; i < ARRAY_SIZE(bench_cases); i++) {
+        const struct bench_case *bcase = &bench_cases[i];
+
+        if (!bench_selected(case_list, bcase->name)) {
+            continue;
+        }
+        if (bcase->data) {
+            length = (int) strlen(bcase->data);
+            memcpy(data, bcase->data, length + 1);
+        } else {
+            length = bcase->length;
+            bench_generate(data, length, bcase->charset);
+        }
+
+        for (j = 0; j < ARRAY_SIZE(bench_paths); j++) {
+            const struct bench_path *path = &bench_paths[j];
+
+            if (!bench_selected(path_list, path->name)) {
+                continue;
+            }
+
+            ret = bench_measure(bcase, path, data, length, iterations, min_ms, warmups, &result);
+            if (ret) {
+                fprintf(stderr, "bench: %s %s failed with error %d (%s)\n", bcase->name, path->name, ret, bench_errtxt);
+                failed = 1;
+                continue;
+            }
+
+            bench_print(json, first, bcase, path, length, &result);
+            first = 0;
+        }
+    }
+
+    if (json) {
+        printf("\n]}\n");
+    }
+
+    return failed;
+}
+
+/* vim: set ts=4 sw=4 et : */
@@ -1348,6 +1348,57 @@ static void test_clear(void) {
     testFinish();
 }
 
+static void test_timings(void) {
+
+    int ret;
+    struct zint_symbol *symbol;
+    char *data = "1234";
+
+    testStart("test_timings");
+
+    symbol = ZBarcode_Create();
+    assert_nonnull(symbol, "Symbol not created\n");
+
+    symbol->symbology = BARCODE_QRCODE;
+
+    /* Not recorded unless asked for */
+
+    ret = ZBarcode_Encode_and_Buffer(symbol, TU(data), 0, 0);
+    assert_zero(ret, "ZBarcode_Encode_and_Buffer() ret %d != 0 (%s)\n", ret, symbol->errtxt);
+
+    assert_zero(symbol->timings.convert + symbol->timings.encode + symbol->timings.plot + symbol->timings.output != 0,
+                "timings recorded without BARCODE_TIMINGS\n");
+
+    /* Raster */
+
+    symbol->output_options |= BARCODE_TIMINGS;
+
+    ret = ZBarcode_Encode_and_Buffer(symbol, TU(data), 0, 90);
+    assert_zero(ret, "ZBarcode_Encode_and_Buffer() ret %d != 0 (%s)\n", ret, symbol->errtxt);
+
+    assert_nonzero(symbol->timings.convert >= 0.0, "raster timings.convert %g < 0\n", symbol->timings.convert);
+    assert_nonzero(symbol->timings.encode > 0.0, "raster timings.encode %g <= 0\n", symbol->timings.encode);
+    assert_nonzero(symbol->timings.plot > 0.0, "raster timings.plot %g <= 0\n", symbol->timings.plot);
+    assert_nonzero(symbol->timings.output > 0.0, "raster timings.output %g <= 0\n", symbol->timings.output);
+
+    /* Vector */
+
+    ret = ZBarcode_Encode_and_Buffer_Vector(symbol, TU(data), 0, 0);
+    assert_zero(ret, "ZBarcode_Encode_and_Buffer_Vector() ret %d != 0 (%s)\n", ret, symbol->errtxt);
+
+    assert_nonzero(symbol->timings.encode > 0.0, "vector timings.encode %g <= 0\n", symbol->timings.encode);
+    assert_nonzero(symbol->timings.plot > 0.0, "vector timings.plot %g <= 0\n", symbol->timings.plot);
+    assert_nonzero(symbol->timings.output >= 0.0, "vector timings.output %g < 0\n", symbol->timings.output);
+
+    ZBarcode_Clear(symbol);
+
+    assert_zero(symbol->timings.encode != 0.0, "ZBarcode_Clear() timings.encode %g != 0\n", symbol->timings.encode);
+
+    ZBarcode_Delete(symbol);
+
+    testFinish();
+}
+
 int main(int argc, char *argv[]) {
 
     testFunction funcs[] = { /* name, func, has_index, has_generate, has_debug */
@@ -1371,6 +1422,7 @@ int main(int argc, char *argv[]) {
         { "test_strip_bom", test_strip_bom, 0, 0, 0 },
         { "test_zero_outfile", test_zero_outfile, 0, 0, 0 },
         { "test_clear", test_clear, 0, 0, 0 },
+        { "test_timings", test_timings, 0, 0, 0 },
     };
 
     testRun(argc, argv, funcs, ARRAY_SIZE(funcs));
@@ -212,10 +212,100 @@ static void test_print(int index, int generate, int debug) {
     testFinish();
 }
 
+static void test_memfile(int index, int debug) {
+
+    struct item {
+        int symbology;
+        int option_1;
+        int option_2;
+        char *data;
+    };
+    struct item data[] = {
+        /*  0*/ { BARCODE_CODE128, -1, -1, "AIM" },
+        /*  1*/ { BARCODE_QRCODE, 2, 1, "1234567890" },
+        /*  2*/ { BARCODE_MAXICODE, -1, -1, "THIS IS A 93 CHARACTER CODE SET A MESSAGE THAT FILLS A MODE 4, UNAPPENDED, MAXICODE SYMBOL..." },
+    };
+    int data_size = ARRAY_SIZE(data);
+    int i, length, ret;
+    struct zint_symbol *symbol;
+    int j;
+
+    char *exts[] = { "bmp", "emf", "eps", "gif", "pcx", "png", "svg", "tif", "txt" };
+    int exts_size = ARRAY_SIZE(exts);
+
+    testStart("test_memfile");
+
+    for (j = 0; j < exts_size; j++) {
+#ifdef NO_PNG
+        if (strcmp(exts[j], "png") == 0) continue;
+#endif
+        for (i = 0; i < data_size; i++) {
+            FILE *fp;
+            long file_size;
+            unsigned char *file_buf;
+
+            if (index != -1 && i != index) continue;
+
+            symbol = ZBarcode_Create();
+            assert_nonnull(symbol, "Symbol not created\n");
+
+            length = testUtilSetSymbol(symbol, data[i].symbology, -1 /*input_mode*/, -1 /*eci*/, data[i].option_1, data[i].option_2, -1, -1 /*output_options*/, data[i].data, -1, debug);
+
+            ret = ZBarcode_Encode(symbol, (unsigned char *) data[i].data, length);
+            assert_zero(ret, "i:%d %s ZBarcode_Encode ret %d != 0 %s\n", i, testUtilBarcodeName(data[i].symbology), ret, symbol->errtxt);
+
+            strcpy(symbol->outfile, "out.");
+            strcat(symbol->outfile, exts[j]);
+
+            ret = ZBarcode_Print(symbol, 0);
+            assert_zero(ret, "i:%d j:%d %s ZBarcode_Print %s ret %d != 0 (%s)\n", i, j, exts[j], symbol->outfile, ret, symbol->errtxt);
+            assert_null(symbol->memfile, "i:%d j:%d %s memfile not NULL\n", i, j, exts[j]);
+
+            symbol->output_options |= BARCODE_MEMORY_FILE;
+            ret = ZBarcode_Print(symbol, 0);
+            assert_zero(ret, "i:%d j:%d %s ZBarcode_Print memory ret %d != 0 (%s)\n", i, j, exts[j], ret, symbol->errtxt);
+            assert_nonnull(symbol->memfile, "i:%d j:%d %s memfile NULL\n", i, j, exts[j]);
+            assert_zero(symbol->memfile[symbol->memfile_size], "i:%d j:%d %s memfile not NUL-terminated\n", i, j, exts[j]);
+
+            fp = fopen(symbol->outfile, "rb");
+            assert_nonnull(fp, "i:%d j:%d fopen(%s) NULL\n", i, j, symbol->outfile);
+            assert_zero(fseek(fp, 0, SEEK_END), "i:%d j:%d fseek(%s) != 0\n", i, j, symbol->outfile);
+            file_size = ftell(fp);
+            assert_equal(file_size, (long) symbol->memfile_size, "i:%d j:%d %s file_size %ld != memfile_size %d\n",
+                        i, j, exts[j], file_size, symbol->memfile_size);
+            rewind(fp);
+            file_buf = (unsigned char *) malloc(file_size);
+            assert_nonnull(file_buf, "i:%d j:%d malloc(%ld) NULL\n", i, j, file_size);
+            assert_equal((long) fread(file_buf, 1, file_size, fp), file_size, "i:%d j:%d fread(%s) short\n", i, j, symbol->outfile);
+            fclose(fp);
+
+            assert_zero(memcmp(file_buf, symbol->memfile, file_size), "i:%d j:%d %s memfile != file\n", i, j, exts[j]);
+            free(file_buf);
+
+            /* Memory output replaces any previous memory output and is freed on clear */
+            ret = ZBarcode_Print(symbol, 0);
+            assert_zero(ret, "i:%d j:%d %s ZBarcode_Print memory 2nd ret %d != 0 (%s)\n", i, j, exts[j], ret, symbol->errtxt);
+            assert_equal((long) symbol->memfile_size, file_size, "i:%d j:%d %s 2nd memfile_size %d != %ld\n",
+                        i, j, exts[j], symbol->memfile_size, file_size);
+
+            ZBarcode_Clear(symbol);
+            assert_null(symbol->memfile, "i:%d j:%d %s memfile not NULL after ZBarcode_Clear\n", i, j, exts[j]);
+            assert_zero(symbol->memfile_size, "i:%d j:%d %s memfile_size %d != 0 after ZBarcode_Clear\n", i, j, exts[j], symbol->memfile_size);
+
+            if (index == -1) assert_zero(remove(symbol->outfile), "i:%d remove(%s) != 0\n", i, symbol->outfile);
+
+            ZBarcode_Delete(symbol);
+        }
+    }
+
+    testFinish();
+}
+
 int main(int argc, char *argv[]) {
 
     testFunction funcs[] = { /* name, func, has_index, has_generate, has_debug */
         { "test_print", test_print, 1, 1, 1 },
+        { "test_memfile", test_memfile, 1, 0, 1 },
     };
 
     testRun(argc, argv, funcs, ARRAY_SIZE(funcs));
@@ -232,6 +232,19 @@ static void test_outfile(void) {
     printf(" - ignore (EPS to stdout)\n"); fflush(stdout);
     assert_zero(ret, "ps_plot ret %d != 0 (%s)\n", ret, symbol.errtxt);
 
+    symbol.output_options &= ~BARCODE_STDOUT;
+    symbol.output_options |= BARCODE_MEMORY_FILE;
+
+    ret = ps_plot(&symbol, 0);
+    assert_zero(ret, "ps_plot memory ret %d != 0 (%s)\n", ret, symbol.errtxt);
+    assert_nonnull(symbol.memfile, "ps_plot memfile NULL\n");
+    assert_nonzero(symbol.memfile_size, "ps_plot memfile_size 0\n");
+    assert_zero(strncmp((char *) symbol.memfile, "%!PS", 4), "ps_plot memfile %.10s != %%!PS\n", symbol.memfile);
+    assert_equal((int) strlen((char *) symbol.memfile), symbol.memfile_size, "strlen(memfile) %d != memfile_size %d\n",
+                (int) strlen((char *) symbol.memfile), symbol.memfile_size);
+    free(symbol.memfile);
+    symbol.memfile = NULL;
+
     symbol.vector = NULL;
     ret = ps_plot(&symbol, 0);
     assert_equal(ret, ZINT_ERROR_INVALID_DATA, "ps_plot ret %d != ZINT_ERROR_INVALID_DATA (%d) (%s)\n", ret, ZINT_ERROR_INVALID_DATA, symbol.errtxt);
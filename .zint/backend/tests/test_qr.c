@@ -88,6 +88,8 @@ static void test_qr_options(int index, int debug) {
         /* 39*/ { 4, 1, { 3, 17, "123" }, "12345678901", ZINT_ERROR_INVALID_OPTION, -1, 0, -1 }, /* Bad Structured Append count */
         /* 40*/ { 4, 1, { 3, 2, "123" }, "12345678901", ZINT_ERROR_INVALID_OPTION, -1, 0, -1 }, /* Bad Structured Append index */
         /* 41*/ { 4, 1, { 1, 2, "256" }, "12345678901", ZINT_ERROR_INVALID_OPTION, -1, 0, -1 }, /* Bad Structured Append ID */
+        /* 42*/ { 1, -1, { 0, 0, "" }, "123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012", 0, 0, 53, -1 }, /* 552 digits, fit version 9 with its 10-bit count but not with version 40's 14-bit one */
+        /* 43*/ { 1, -1, { 0, 0, "" }, "1234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123456789012345678901234567890123", 0, 0, 57, -1 }, /* 553 digits, version 10 */
     };
     int data_size = ARRAY_SIZE(data);
     int i, length, ret;
@@ -4387,6 +4389,80 @@ static void test_qr_encode_segs(int index, int generate, int debug) {
     testFinish();
 }
 
+/* Automatic mask selection, for versions packing rows into 1, 2 and 3 64-bit words (see `qr_evaluate()`) */
+static void test_qr_mask(int index, int debug) {
+
+    struct item {
+        int option_1;
+        int option_2;
+        char *repeat;
+        int length;
+        int expected_size;
+        int expected_mask;
+    };
+    /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
+    struct item data[] = {
+        /*  0*/ { 1, 10, "ABC123", 100, 57, 2 },
+        /*  1*/ { 2, 13, "Zint 2.11", 200, 69, 2 },
+        /*  2*/ { 1, 14, "1234567890", 300, 73, 4 },
+        /*  3*/ { 3, 28, "AAAAAAAAAA", 400, 129, 0 },
+        /*  4*/ { 4, 29, "http://example.com/?q=", 500, 133, 2 },
+        /*  5*/ { 2, 31, "\001\377\200abc", 600, 141, 0 },
+        /*  6*/ { 1, 35, "0", 1000, 157, 0 },
+        /*  7*/ { 3, 37, "The quick brown fox ", 1200, 165, 4 },
+        /*  8*/ { 4, 40, "ABCDEFGHIJKLMNOPQRSTUVWXYZ", 1800, 177, 3 },
+        /*  9*/ { 1, 40, "31415926535897932384626", 2900, 177, 2 },
+    };
+    int data_size = ARRAY_SIZE(data);
+    int i, length, ret, mask;
+    struct zint_symbol *symbol;
+    struct zint_symbol *masked;
+    char data_buf[4096];
+
+    testStart("test_qr_mask");
+
+    for (i = 0; i < data_size; i++) {
+
+        if (index != -1 && i != index) continue;
+        if ((debug & ZINT_DEBUG_TEST_PRINT) && !(debug & ZINT_DEBUG_TEST_LESS_NOISY)) printf("i:%d\n", i);
+
+        testUtilStrCpyRepeat(data_buf, data[i].repeat, data[i].length);
+        assert_equal(data[i].length, (int) strlen(data_buf), "i:%d length %d != strlen(data_buf) %d\n", i, data[i].length, (int) strlen(data_buf));
+
+        symbol = ZBarcode_Create();
+        assert_nonnull(symbol, "Symbol not created\n");
+
+        length = testUtilSetSymbol(symbol, BARCODE_QRCODE, DATA_MODE, -1 /*eci*/, data[i].option_1, data[i].option_2, -1, -1 /*output_options*/, data_buf, data[i].length, debug);
+
+        ret = ZBarcode_Encode(symbol, (unsigned char *) data_buf, length);
+        assert_zero(ret, "i:%d ZBarcode_Encode ret %d != 0 (%s)\n", i, ret, symbol->errtxt);
+        assert_equal(symbol->width, data[i].expected_size, "i:%d symbol->width %d != %d\n", i, symbol->width, data[i].expected_size);
+
+        /* Find the mask chosen by encoding with each one */
+        for (mask = 0; mask < 8; mask++) {
+            masked = ZBarcode_Create();
+            assert_nonnull(masked, "Symbol not created\n");
+
+            length = testUtilSetSymbol(masked, BARCODE_QRCODE, DATA_MODE, -1 /*eci*/, data[i].option_1, data[i].option_2, (mask + 1) << 8, -1 /*output_options*/, data_buf, data[i].length, debug);
+
+            ret = ZBarcode_Encode(masked, (unsigned char *) data_buf, length);
+            assert_zero(ret, "i:%d mask %d ZBarcode_Encode ret %d != 0 (%s)\n", i, mask, ret, masked->errtxt);
+
+            ret = testUtilSymbolCmp(symbol, masked);
+            ZBarcode_Delete(masked);
+            if (ret == 0) {
+                break;
+            }
+        }
+        if (debug & ZINT_DEBUG_TEST_PRINT) printf("i:%d mask %d\n", i, mask);
+        assert_equal(mask, data[i].expected_mask, "i:%d mask %d != %d\n", i, mask, data[i].expected_mask);
+
+        ZBarcode_Delete(symbol);
+    }
+
+    testFinish();
+}
+
 #include <time.h>
 
 #define TEST_PERF_ITERATIONS    1000
@@ -8291,6 +8367,7 @@ int main(int argc, char *argv[]) {
         { "test_qr_optimize", test_qr_optimize, 1, 1, 1 },
         { "test_qr_encode", test_qr_encode, 1, 1, 1 },
         { "test_qr_encode_segs", test_qr_encode_segs, 1, 1, 1 },
+        { "test_qr_mask", test_qr_mask, 1, 0, 1 },
         { "test_qr_perf", test_qr_perf, 1, 0, 1 },
 
         { "test_microqr_options", test_microqr_options, 1, 0, 1 },
@@ -252,6 +252,7 @@ static void test_uint_encoding(int index, int debug) {
         /*  1*/ { 0x1069, 4095, 4, 1, 7, { 0xFFF, 0x000, 0x700, 0x7FF, 0xFFF, 0x000, 0x123 }, { 3472, 2350, 3494, 575 } },
         /*  2*/ { 0x1000, 4095, 4, 0, 7, { 0xFFF, 0x000, 0x700, 0x7FF, 0xFFF, 0x000, 0x123 }, { 1, 65, 0, 64 } },
         /*  3*/ { 0x1000, 4095, 256, 0, 1, { 0xFFF }, { 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 512, 0, 2048, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 } },
+        /*  4*/ { 0x409, 1023, 30, 1, 40, { 0x00B, 0x198, 0x325, 0x0B2, 0x23F, 0x3CC, 0x159, 0x2E6, 0x073, 0x200, 0x38D, 0x11A, 0x2A7, 0x034, 0x1C1, 0x34E, 0x0DB, 0x268, 0x3F5, 0x182, 0x30F, 0x09C, 0x229, 0x3B6, 0x143, 0x2D0, 0x05D, 0x1EA, 0x377, 0x104, 0x291, 0x01E, 0x1AB, 0x338, 0x0C5, 0x252, 0x3DF, 0x16C, 0x2F9, 0x086 }, { 79, 512, 809, 443, 320, 953, 216, 721, 440, 557, 362, 167, 161, 830, 124, 895, 841, 263, 842, 683, 854, 600, 412, 817, 235, 395, 534, 885, 808, 656 } },
     };
     int data_size = ARRAY_SIZE(data);
     int i;
@@ -279,6 +280,19 @@ static void test_uint_encoding(int index, int debug) {
             assert_equal(res[k], data[i].expected[j], "i:%d res[%d] %d != expected[%d] %d\n", i, k, (int) res[k], j, (int) data[i].expected[j]);
         }
 
+        /* Simulate rs_uint_init_code() products malloc() failure, which encodes using logs */
+        assert_nonzero(rs_uint_init_gf(&rs_uint, data[i].prime_poly, data[i].logmod), "i:%d rs_uint_init_gf() == 0\n", i);
+        rs_uint_init_code(&rs_uint, data[i].nsym, data[i].index);
+        free(rs_uint.mul);
+        rs_uint.mul = NULL;
+        rs_uint_encode(&rs_uint, data[i].datalen, data[i].data, res);
+        rs_uint_free(&rs_uint);
+
+        for (j = 0; j < data[i].nsym; j++) {
+            int k = data[i].nsym - 1 - j;
+            assert_equal(res[k], data[i].expected[j], "i:%d res[%d] %d != expected[%d] %d (logs)\n", i, k, (int) res[k], j, (int) data[i].expected[j]);
+        }
+
         /* Simulate rs_uint_init_gf() malloc() failure and rs_uint_init_gf()'s return val not being checked */
         assert_nonzero(rs_uint_init_gf(&rs_uint, data[i].prime_poly, data[i].logmod), "i:%d rs_uint_init_gf() == 0\n", i);
         free(rs_uint.logt);
@@ -299,6 +313,92 @@ static void test_uint_encoding(int index, int debug) {
     testFinish();
 }
 
+static void test_init_cached(int index) {
+
+    struct item {
+        unsigned int prime_poly;
+        int logmod; /* 0 for `rs_init_cached()` */
+        int nsym;
+        int index;
+        int cached;
+    };
+    /* s/\/\*[ 0-9]*\*\//\=printf("\/\*%3d*\/", line(".") - line("'<")): */
+    struct item data[] = {
+        /*  0*/ { 0x13, 0, 5, 1, 1 },
+        /*  1*/ { 0x25, 0, 6, 1, 1 },
+        /*  2*/ { 0x43, 0, 10, 1, 1 },
+        /*  3*/ { 0x89, 0, 25, 1, 1 },
+        /*  4*/ { 0x11d, 0, 30, 0, 1 },
+        /*  5*/ { 0x12d, 0, 68, 1, 1 },
+        /*  6*/ { 0x163, 0, 256, 0, 1 },
+        /*  7*/ { 0x11d, 0, 30, 2, 0 }, /* index > 1 not cached */
+        /*  8*/ { 0x409, 1023, 100, 1, 1 },
+        /*  9*/ { 0x1069, 4095, 400, 1, 1 },
+        /* 10*/ { 0x1069, 4095, 400, 0, 1 },
+        /* 11*/ { 0x1000, 4095, 4, 0, 0 }, /* Not an Aztec field so not cached */
+    };
+    int data_size = ARRAY_SIZE(data);
+    int i;
+
+    testStart("test_init_cached");
+
+    for (i = 0; i < data_size; i++) {
+        int j;
+        unsigned int udata[600], res[1024], expected[1024];
+
+        if (index != -1 && i != index) continue;
+
+        for (j = 0; j < ARRAY_SIZE(udata); j++) {
+            udata[j] = (j * 397 + 11) & (data[i].logmod ? (unsigned int) data[i].logmod : (data[i].prime_poly >> 1) | 0x0F);
+        }
+
+        if (data[i].logmod) {
+            rs_uint_t rs_uint, rs_uint2;
+            const rs_uint_t *p_rs_uint, *p_rs_uint2;
+
+            assert_nonzero(rs_uint_init_gf(&rs_uint, data[i].prime_poly, data[i].logmod), "i:%d rs_uint_init_gf() == 0\n", i);
+            rs_uint_init_code(&rs_uint, data[i].nsym, data[i].index);
+            rs_uint_encode(&rs_uint, ARRAY_SIZE(udata), udata, expected);
+            rs_uint_free(&rs_uint);
+
+            p_rs_uint = rs_uint_init_cached(&rs_uint, data[i].prime_poly, data[i].logmod, data[i].nsym, data[i].index);
+            assert_nonnull(p_rs_uint, "i:%d rs_uint_init_cached() NULL\n", i);
+            p_rs_uint2 = rs_uint_init_cached(&rs_uint2, data[i].prime_poly, data[i].logmod, data[i].nsym, data[i].index);
+            assert_nonnull(p_rs_uint2, "i:%d rs_uint_init_cached() 2nd NULL\n", i);
+            if (data[i].cached) {
+                assert_equal(p_rs_uint, p_rs_uint2, "i:%d cached %p != %p\n", i, (const void *) p_rs_uint, (const void *) p_rs_uint2);
+            } else {
+                assert_equal(p_rs_uint, &rs_uint, "i:%d not cached %p != %p\n", i, (const void *) p_rs_uint, (void *) &rs_uint);
+            }
+            rs_uint_encode(p_rs_uint, ARRAY_SIZE(udata), udata, res);
+            rs_uint_free(&rs_uint);
+            rs_uint_free(&rs_uint2);
+        } else {
+            rs_t rs, rs2;
+            const rs_t *p_rs, *p_rs2;
+
+            rs_init_gf(&rs, data[i].prime_poly);
+            rs_init_code(&rs, data[i].nsym, data[i].index);
+            rs_encode_uint(&rs, ARRAY_SIZE(udata), udata, expected);
+
+            p_rs = rs_init_cached(&rs, data[i].prime_poly, data[i].nsym, data[i].index);
+            p_rs2 = rs_init_cached(&rs2, data[i].prime_poly, data[i].nsym, data[i].index);
+            if (data[i].cached) {
+                assert_equal(p_rs, p_rs2, "i:%d cached %p != %p\n", i, (const void *) p_rs, (const void *) p_rs2);
+            } else {
+                assert_equal(p_rs, &rs, "i:%d not cached %p != %p\n", i, (const void *) p_rs, (void *) &rs);
+            }
+            rs_encode_uint(p_rs, ARRAY_SIZE(udata), udata, res);
+        }
+
+        for (j = 0; j < data[i].nsym; j++) {
+            assert_equal(res[j], expected[j], "i:%d res[%d] %d != expected[%d] %d\n", i, j, (int) res[j], j, (int) expected[j]);
+        }
+    }
+
+    testFinish();
+}
+
 int main(int argc, char *argv[]) {
 
     testFunction funcs[] = { /* name, func, has_index, has_generate, has_debug */
@@ -306,6 +406,7 @@ int main(int argc, char *argv[]) {
         { "test_encoding", test_encoding, 1, 0, 1 },
         { "test_encoding_uint", test_encoding_uint, 1, 0, 1 },
         { "test_uint_encoding", test_uint_encoding, 1, 0, 1 },
+        { "test_init_cached", test_init_cached, 1, 0, 0 },
     };
 
     testRun(argc, argv, funcs, ARRAY_SIZE(funcs));
@@ -31,6 +31,7 @@
 
 #include "testcommon.h"
 #include <sys/stat.h>
+#include "../filemem.h"
 
 static void test_print(int index, int generate, int debug) {
 
@@ -240,6 +241,19 @@ static void test_outfile(void) {
     printf(" - ignore (SVG to stdout)\n"); fflush(stdout);
     assert_zero(ret, "svg_plot ret %d != 0 (%s)\n", ret, symbol.errtxt);
 
+    symbol.output_options &= ~BARCODE_STDOUT;
+    symbol.output_options |= BARCODE_MEMORY_FILE;
+
+    ret = svg_plot(&symbol, 0);
+    assert_zero(ret, "svg_plot memory ret %d != 0 (%s)\n", ret, symbol.errtxt);
+    assert_nonnull(symbol.memfile, "svg_plot memfile NULL\n");
+    assert_nonzero(symbol.memfile_size, "svg_plot memfile_size 0\n");
+    assert_zero(strncmp((char *) symbol.memfile, "<?xml", 5), "svg_plot memfile %.10s != <?xml\n", symbol.memfile);
+    assert_equal((int) strlen((char *) symbol.memfile), symbol.memfile_size, "strlen(memfile) %d != memfile_size %d\n",
+                (int) strlen((char *) symbol.memfile), symbol.memfile_size);
+    free(symbol.memfile);
+    symbol.memfile = NULL;
+
     symbol.vector = NULL;
     ret = svg_plot(&symbol, 0);
     assert_equal(ret, ZINT_ERROR_INVALID_DATA, "svg_plot ret %d != ZINT_ERROR_INVALID_DATA (%d) (%s)\n", ret, ZINT_ERROR_INVALID_DATA, symbol.errtxt);
@@ -247,11 +261,150 @@ static void test_outfile(void) {
     testFinish();
 }
 
+/* Memory output must not be truncated however large it is */
+static void test_memfile_large(void) {
+    int ret;
+    struct zint_symbol *symbol;
+    char data[451];
+    const char expected_end[] = "</svg>\n";
+    const int expected_end_len = (int) sizeof(expected_end) - 1;
+
+    testStart("test_memfile_large");
+
+    symbol = ZBarcode_Create();
+    assert_nonnull(symbol, "Symbol not created\n");
+
+    symbol->symbology = BARCODE_DOTCODE;
+    symbol->output_options |= BARCODE_MEMORY_FILE;
+    strcpy(symbol->outfile, "out.svg");
+
+    testUtilStrCpyRepeat(data, "1234567890ABCDEFGHIJKLMNOPQRSTUVWXYZ", 450);
+
+    ret = ZBarcode_Encode_and_Print(symbol, (unsigned char *) data, -1, 0);
+    assert_zero(ret, "ZBarcode_Encode_and_Print ret %d != 0 (%s)\n", ret, symbol->errtxt);
+    assert_nonnull(symbol->memfile, "memfile NULL\n");
+    assert_nonzero(symbol->memfile_size > 65536, "memfile_size %d <= 65536\n", symbol->memfile_size);
+    assert_zero(strcmp((char *) symbol->memfile + symbol->memfile_size - expected_end_len, expected_end),
+                "memfile end %s != %s\n", symbol->memfile + symbol->memfile_size - expected_end_len, expected_end);
+
+    ZBarcode_Clear(symbol);
+    assert_null(symbol->memfile, "memfile not NULL after ZBarcode_Clear\n");
+    assert_zero(symbol->memfile_size, "memfile_size %d != 0 after ZBarcode_Clear\n", symbol->memfile_size);
+
+    ZBarcode_Delete(symbol);
+
+    testFinish();
+}
+
+/* `fm_printf()` must format floating-point numbers with "." whatever the locale (there may be none installed with
+   another decimal point, so `fmp->decimal` is set as `fm_open()` would for them) */
+static void test_locale_decimal(int index) {
+
+    struct item {
+        const char *decimal;
+    };
+    /* Comma, and Arabic decimal separator U+066B (2 bytes in UTF-8) */
+    struct item data[] = {
+        /*  0*/ { "," },
+        /*  1*/ { "\xD9\xAB" },
+    };
+    int data_size = ARRAY_SIZE(data);
+    int i, ret;
+    struct zint_symbol *symbol;
+    struct filemem fm;
+    struct filemem *const fmp = &fm;
+    static const char expected[] = "<rect x=\"1.50\" y=\"-2.25\" width=\"3,4\" opacity=\"0.500\" r=\"1.0\" 100% "
+                                   "rotate(90,1.50,2.00) 1e+06   2.5 ff a\n";
+
+    testStart("test_locale_decimal");
+
+    for (i = 0; i < data_size; i++) {
+
+        if (index != -1 && i != index) continue;
+
+        symbol = ZBarcode_Create();
+        assert_nonnull(symbol, "Symbol not created\n");
+        symbol->output_options |= BARCODE_MEMORY_FILE;
+
+        ret = fm_open(fmp, symbol, "w");
+        assert_equal(ret, 1, "i:%d fm_open ret %d != 1\n", i, ret);
+        strcpy(fmp->decimal, data[i].decimal);
+
+        ret = fm_printf(fmp, "<rect x=\"%.2f\" y=\"%.2f\" width=\"%d,%ld\" opacity=\"%.3f\" r=\"%.*f\" %d%% ",
+                        1.5, -2.25, 3, 4L, 0.5, 1, 1.0, 100);
+        assert_equal(ret, 66, "i:%d fm_printf ret %d != 66\n", i, ret);
+        ret = fm_printf(fmp, "rotate(%d,%.2f,%.2f) %g %*.1f %x %c\n", 90, 1.5, 2.0, 1e6, 5, 2.5, 255, 'a');
+        assert_equal(ret, 38, "i:%d fm_printf ret %d != 38\n", i, ret);
+
+        ret = fm_close(fmp, symbol);
+        assert_equal(ret, 1, "i:%d fm_close ret %d != 1\n", i, ret);
+        assert_equal(symbol->memfile_size, (int) strlen(expected), "i:%d memfile_size %d != %d\n",
+                    i, symbol->memfile_size, (int) strlen(expected));
+        assert_zero(strcmp((const char *) symbol->memfile, expected), "i:%d memfile \"%s\" != \"%s\"\n",
+                    i, symbol->memfile, expected);
+
+        ZBarcode_Delete(symbol);
+    }
+
+    testFinish();
+}
+
+/* `fm_printf()` after an `fm_seek()` back must only overwrite the bytes it formats */
+static void test_printf_seek(void) {
+
+    int ret;
+    struct zint_symbol *symbol;
+    struct filemem fm;
+    struct filemem *const fmp = &fm;
+    char buf[512];
+
+    testStart("test_printf_seek");
+
+    symbol = ZBarcode_Create();
+    assert_nonnull(symbol, "Symbol not created\n");
+    symbol->output_options |= BARCODE_MEMORY_FILE;
+
+    ret = fm_open(fmp, symbol, "w");
+    assert_equal(ret, 1, "fm_open ret %d != 1\n", ret);
+
+    memset(buf, 'x', 300);
+    buf[300] = '\0';
+    ret = fm_puts("0123456789", fmp);
+    assert_zero(ret, "fm_puts ret %d != 0\n", ret);
+    ret = fm_seek(fmp, 2, SEEK_SET);
+    assert_zero(ret, "fm_seek ret %d != 0\n", ret);
+    ret = fm_printf(fmp, "%d", 45);
+    assert_equal(ret, 2, "fm_printf ret %d != 2\n", ret);
+    /* Longer than the scratch buffer, and extending the output */
+    ret = fm_seek(fmp, 8, SEEK_SET);
+    assert_zero(ret, "fm_seek ret %d != 0\n", ret);
+    ret = fm_printf(fmp, "%s", buf);
+    assert_equal(ret, 300, "fm_printf ret %d != 300\n", ret);
+    ret = fm_seek(fmp, 9, SEEK_SET);
+    assert_zero(ret, "fm_seek ret %d != 0\n", ret);
+    ret = fm_printf(fmp, "%c", 'y');
+    assert_equal(ret, 1, "fm_printf ret %d != 1\n", ret);
+
+    ret = fm_close(fmp, symbol);
+    assert_equal(ret, 1, "fm_close ret %d != 1\n", ret);
+    assert_equal(symbol->memfile_size, 308, "memfile_size %d != 308\n", symbol->memfile_size);
+    assert_zero(memcmp(symbol->memfile, "01454567xy", 10), "memfile \"%.10s\" != \"01454567xy\"\n",
+                symbol->memfile);
+    assert_zero(memcmp(symbol->memfile + 10, buf, 298), "memfile tail not all 'x'\n");
+
+    ZBarcode_Delete(symbol);
+
+    testFinish();
+}
+
 int main(int argc, char *argv[]) {
 
     testFunction funcs[] = { /* name, func, has_index, has_generate, has_debug */
         { "test_print", test_print, 1, 1, 1 },
         { "test_outfile", test_outfile, 0, 0, 0 },
+        { "test_memfile_large", test_memfile_large, 0, 0, 0 },
+        { "test_locale_decimal", test_locale_decimal, 1, 0, 0 },
+        { "test_printf_seek", test_printf_seek, 0, 0, 0 },
     };
 
     testRun(argc, argv, funcs, ARRAY_SIZE(funcs));
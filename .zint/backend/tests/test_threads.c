@@ -0,0 +1,368 @@
+/*
+    libzint - the open source barcode library
+    Copyright (C) 2026 Robin Stuart <rstuart114@gmail.com>
+
+    Redistribution and use in source and binary forms, with or without
+    modification, are permitted provided that the following conditions
+    are met:
+
+    1. Redistributions of source code must retain the above copyright
+       notice, this list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright
+       notice, this list of conditions and the following disclaimer in the
+       documentation and/or other materials provided with the distribution.
+    3. Neither the name of the project nor the names of its contributors
+       may be used to endorse or promote products derived from this software
+       without specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+    IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+    ARE DISCLAIMED.  IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE
+    FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+    DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS
+    OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+    HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+    LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY
+    OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+    SUCH DAMAGE.
+ */
+/* SPDX-License-Identifier: BSD-3-Clause */
+
+/*
+ * Stress test of the re-entrancy of the library: renders every symbology from several threads at once, and checks
+ * that each render is byte-identical to the same render done single-threaded. Also races threads to set up the
+ * process-wide Reed-Solomon codes
+ */
+
+#include "testcommon.h"
+#include "../reedsol.h"
+#include <pthread.h>
+
+#define THREADS_NUM     8   /* Number of threads rendering at once */
+#define THREADS_ROUNDS  3   /* Number of times each thread renders every symbology */
+#define THREADS_RS_NSYM 200 /* Number of Reed-Solomon codes each thread gets from the cache */
+
+/* Candidate inputs, of which the first one a symbology encodes without error is used for it */
+struct thread_input {
+    const char *data;
+    const char *primary;
+};
+
+static const struct thread_input thread_inputs[] = {
+    { "1234567", "" },
+    { "12345678", "" },
+    { "123456", "" },
+    { "123", "" },
+    { "123456789012", "" },
+    { "01234565", "" },
+    { "12345678901", "" },
+    { "1234567890123", "" },
+    { "12345678901234567", "" },
+    { "01234567094987654321", "" },
+    { "9781234567897", "" },
+    { "[01]12345678901231", "" },
+    { "[21]A12345678", "[01]12345678901231" },
+    { "[21]A12345678", "331234567890" },
+    { "[21]A12345678", "12345678901" },
+    { "[21]A12345678", "0123456" },
+    { "A1234567B", "" },
+    { "EE876543216CA", "" },
+    { "2FTPX28L0XCA15511", "" },
+    { "%000393206219912345678101040", "" },
+    { "0100000000000AA000AA0A", "" },
+    { "FADT", "" },
+    { "A", "" },
+};
+
+/* A render: the encoded symbol (with its bitmap and vector), and its SVG and EPS memory files */
+struct thread_render {
+    struct zint_symbol *symbol;
+    unsigned char *svg;
+    int svg_size;
+    unsigned char *eps;
+    int eps_size;
+};
+
+/* The single-threaded reference render of each symbology (index 0 if none) */
+static struct thread_render thread_refs[BARCODE_LAST + 1];
+static int thread_ref_inputs[BARCODE_LAST + 1];
+
+struct thread_ctx {
+    pthread_t thread;
+    int index;
+    int renders;
+    int failures;
+    char msg[256];
+};
+
+/* Print the symbol to a memory file in the format of `filename`, taking ownership of the file */
+static int thread_print(struct zint_symbol *symbol, const char *filename, unsigned char **p_mem, int *p_size) {
+    int ret;
+
+    strcpy(symbol->outfile, filename);
+    ret = ZBarcode_Print(symbol, 0);
+    if (ret >= ZINT_ERROR) {
+        return ret;
+    }
+    *p_mem = symbol->memfile;
+    *p_size = symbol->memfile_size;
+    symbol->memfile = NULL;
+    symbol->memfile_size = 0;
+
+    return ret;
+}
+
+/* Render `input` as `symbology` with `ZBarcode_Encode_and_Buffer()`, `ZBarcode_Buffer_Vector()` and
+   `ZBarcode_Print()`. Returns the first error, if any */
+static int thread_do_render(int symbology, const struct thread_input *input, struct thread_render *render) {
+    struct zint_symbol *symbol;
+    int ret;
+
+    memset(render, 0, sizeof(*render));
+
+    if (!(render->symbol = symbol = ZBarcode_Create())) {
+        return ZINT_ERROR_MEMORY;
+    }
+    symbol->symbology = symbology;
+    symbol->output_options |= BARCODE_MEMORY_FILE;
+    strcpy(symbol->primary, input->primary);
+
+    ret = ZBarcode_Encode_and_Buffer(symbol, (const unsigned char *) input->data, (int) strlen(input->data), 0);
+    if (ret >= ZINT_ERROR) {
+        return ret;
+    }
+    ret = ZBarcode_Buffer_Vector(symbol, 0);
+    if (ret >= ZINT_ERROR) {
+        return ret;
+    }
+    ret = thread_print(symbol, "out.svg", &render->svg, &render->svg_size);
+    if (ret >= ZINT_ERROR) {
+        return ret;
+    }
+    return thread_print(symbol, "out.eps", &render->eps, &render->eps_size);
+}
+
+static void thread_free_render(struct thread_render *render) {
+    ZBarcode_Delete(render->symbol);
+    free(render->svg);
+    free(render->eps);
+    memset(render, 0, sizeof(*render));
+}
+
+/* Compare a render with the reference one. Returns NULL if identical, else what differs */
+static const char *thread_cmp_render(const struct thread_render *a, const struct thread_render *b) {
+    if (testUtilSymbolCmp(a->symbol, b->symbol)) {
+        return "symbol";
+    }
+    if (a->symbol->bitmap_width != b->symbol->bitmap_width || a->symbol->bitmap_height != b->symbol->bitmap_height
+            || memcmp(a->symbol->bitmap, b->symbol->bitmap,
+                        (size_t) a->symbol->bitmap_width * a->symbol->bitmap_height * 3)) {
+        return "bitmap";
+    }
+    if (testUtilVectorCmp(a->symbol->vector, b->symbol->vector)) {
+        return "vector";
+    }
+    if (a->svg_size != b->svg_size || memcmp(a->svg, b->svg, a->svg_size)) {
+        return "svg";
+    }
+    if (a->eps_size != b->eps_size || memcmp(a->eps, b->eps, a->eps_size)) {
+        return "eps";
+    }
+    return NULL;
+}
+
+/* Thread entry: render every symbology `THREADS_ROUNDS` times, starting at a different one in each thread, so
+   that different symbologies are rendered at once */
+static void *thread_run(void *arg) {
+    struct thread_ctx *ctx = (struct thread_ctx *) arg;
+    int round, i;
+
+    for (round = 0; round < THREADS_ROUNDS; round++) {
+        for (i = 0; i <= BARCODE_LAST; i++) {
+            const int symbology = (i + ctx->index * 17) % (BARCODE_LAST + 1);
+            struct thread_render render;
+            const char *diff;
+            int ret;
+
+            if (!thread_refs[symbology].symbol) {
+                continue;
+            }
+            ret = thread_do_render(symbology, &thread_inputs[thread_ref_inputs[symbology]], &render);
+            diff = ret >= ZINT_ERROR ? "error" : thread_cmp_render(&render, &thread_refs[symbology]);
+            if (diff) {
+                if (!ctx->failures) {
+                    sprintf(ctx->msg, "thread %d round %d symbology %d (%s) %s differs (ret %d, %.60s)", ctx->index,
+                            round, symbology, testUtilBarcodeName(symbology), diff, ret,
+                            render.symbol ? render.symbol->errtxt : "");
+                }
+                ctx->failures++;
+            }
+            ctx->renders++;
+            thread_free_render(&render);
+        }
+    }
+
+    return NULL;
+}
+
+static void test_threads(int debug) {
+
+    struct thread_ctx ctxs[THREADS_NUM];
+    int symbology, i, ret;
+    int valid_symbologies = 0, symbologies = 0;
+
+    testStart("test_threads");
+
+    /* Single-threaded reference renders */
+    for (symbology = 1; symbology <= BARCODE_LAST; symbology++) {
+        if (!ZBarcode_ValidID(symbology)) {
+            continue;
+        }
+        valid_symbologies++;
+        for (i = 0; i < ARRAY_SIZE(thread_inputs); i++) {
+            ret = thread_do_render(symbology, &thread_inputs[i], &thread_refs[symbology]);
+            if (ret < ZINT_ERROR) {
+                thread_ref_inputs[symbology] = i;
+                symbologies++;
+                break;
+            }
+            thread_free_render(&thread_refs[symbology]);
+        }
+        if (debug & ZINT_DEBUG_TEST_PRINT) {
+            printf("symbology %d (%s): %s\n", symbology, testUtilBarcodeName(symbology),
+                    thread_refs[symbology].symbol ? thread_inputs[i].data : "no input");
+        }
+    }
+    assert_equal(symbologies, valid_symbologies, "symbologies rendered %d != %d (not all have an input)\n",
+                symbologies, valid_symbologies);
+
+    memset(ctxs, 0, sizeof(ctxs));
+    for (i = 0; i < THREADS_NUM; i++) {
+        ctxs[i].index = i;
+        ret = pthread_create(&ctxs[i].thread, NULL, thread_run, &ctxs[i]);
+        assert_zero(ret, "i:%d pthread_create() ret %d != 0\n", i, ret);
+    }
+    for (i = 0; i < THREADS_NUM; i++) {
+        ret = pthread_join(ctxs[i].thread, NULL);
+        assert_zero(ret, "i:%d pthread_join() ret %d != 0\n", i, ret);
+    }
+
+    for (symbology = 0; symbology <= BARCODE_LAST; symbology++) {
+        if (thread_refs[symbology].symbol) {
+            thread_free_render(&thread_refs[symbology]);
+        }
+    }
+
+    for (i = 0; i < THREADS_NUM; i++) {
+        assert_equal(ctxs[i].renders, symbologies * THREADS_ROUNDS, "i:%d renders %d != %d\n", i, ctxs[i].renders,
+                    symbologies * THREADS_ROUNDS);
+        assert_zero(ctxs[i].failures, "i:%d failures %d != 0 (first: %s)\n", i, ctxs[i].failures, ctxs[i].msg);
+    }
+
+    testFinish();
+}
+
+/* Reed-Solomon codes got by a thread, in parameters not used by any symbology so that the threads race to set them
+   up in the process-wide cache */
+struct thread_rs_ctx {
+    pthread_t thread;
+    const rs_t *codes[THREADS_RS_NSYM];
+    const rs_uint_t *uint_codes[THREADS_RS_NSYM];
+};
+
+static void *thread_rs_run(void *arg) {
+    struct thread_rs_ctx *ctx = (struct thread_rs_ctx *) arg;
+    rs_t rs;
+    rs_uint_t rs_uint;
+    int nsym;
+
+    for (nsym = 1; nsym <= THREADS_RS_NSYM; nsym++) {
+        ctx->codes[nsym - 1] = rs_init_cached(&rs, 0x163, nsym, 0);
+        ctx->uint_codes[nsym - 1] = rs_uint_init_cached(&rs_uint, 0x409, 1023, nsym, 0);
+        if (ctx->codes[nsym - 1] == &rs) {
+            ctx->codes[nsym - 1] = NULL;
+        }
+        if (ctx->uint_codes[nsym - 1] == &rs_uint) {
+            ctx->uint_codes[nsym - 1] = NULL;
+        }
+        rs_uint_free(&rs_uint);
+    }
+
+    return NULL;
+}
+
+static void test_rs_cache(void) {
+
+    struct thread_rs_ctx ctxs[THREADS_NUM];
+    unsigned char data[20], res[THREADS_RS_NSYM], expected[THREADS_RS_NSYM];
+    unsigned int udata[20], ures[THREADS_RS_NSYM], uexpected[THREADS_RS_NSYM];
+    int i, j, nsym, ret;
+
+    testStart("test_rs_cache");
+
+    for (i = 0; i < ARRAY_SIZE(data); i++) {
+        data[i] = (unsigned char) (i * 37 + 11);
+        udata[i] = (i * 397 + 11) & 0x3FF;
+    }
+
+    memset(ctxs, 0, sizeof(ctxs));
+    for (i = 0; i < THREADS_NUM; i++) {
+        ret = pthread_create(&ctxs[i].thread, NULL, thread_rs_run, &ctxs[i]);
+        assert_zero(ret, "i:%d pthread_create() ret %d != 0\n", i, ret);
+    }
+    for (i = 0; i < THREADS_NUM; i++) {
+        ret = pthread_join(ctxs[i].thread, NULL);
+        assert_zero(ret, "i:%d pthread_join() ret %d != 0\n", i, ret);
+    }
+
+    /* Every thread must have got the same codes, set up as if uncached */
+    for (nsym = 1; nsym <= THREADS_RS_NSYM; nsym++) {
+        rs_t rs;
+        rs_uint_t rs_uint;
+
+        assert_nonnull(ctxs[0].codes[nsym - 1], "nsym:%d code not cached\n", nsym);
+        assert_nonnull(ctxs[0].uint_codes[nsym - 1], "nsym:%d uint code not cached\n", nsym);
+        for (i = 1; i < THREADS_NUM; i++) {
+            assert_equal(ctxs[i].codes[nsym - 1], ctxs[0].codes[nsym - 1], "i:%d nsym:%d code %p != %p\n", i, nsym,
+                        (const void *) ctxs[i].codes[nsym - 1], (const void *) ctxs[0].codes[nsym - 1]);
+            assert_equal(ctxs[i].uint_codes[nsym - 1], ctxs[0].uint_codes[nsym - 1],
+                        "i:%d nsym:%d uint code %p != %p\n", i, nsym, (const void *) ctxs[i].uint_codes[nsym - 1],
+                        (const void *) ctxs[0].uint_codes[nsym - 1]);
+        }
+
+        rs_init_gf(&rs, 0x163);
+        rs_init_code(&rs, nsym, 0);
+        rs_encode(&rs, ARRAY_SIZE(data), data, expected);
+        rs_encode(ctxs[0].codes[nsym - 1], ARRAY_SIZE(data), data, res);
+        assert_zero(memcmp(res, expected, nsym), "nsym:%d res != expected\n", nsym);
+
+        assert_nonzero(rs_uint_init_gf(&rs_uint, 0x409, 1023), "nsym:%d rs_uint_init_gf() == 0\n", nsym);
+        rs_uint_init_code(&rs_uint, nsym, 0);
+        rs_uint_encode(&rs_uint, ARRAY_SIZE(udata), udata, uexpected);
+        rs_uint_free(&rs_uint);
+        rs_uint_encode(ctxs[0].uint_codes[nsym - 1], ARRAY_SIZE(udata), udata, ures);
+        for (j = 0; j < nsym; j++) {
+            assert_equal(ures[j], uexpected[j], "nsym:%d ures[%d] %d != %d\n", nsym, j, (int) ures[j],
+                        (int) uexpected[j]);
+        }
+    }
+
+    testFinish();
+}
+
+int main(int argc, char *argv[]) {
+
+    testFunction funcs[] = { /* name, func, has_index, has_generate, has_debug */
+        { "test_threads", test_threads, 0, 0, 1 },
+        { "test_rs_cache", test_rs_cache, 0, 0, 0 },
+    };
+
+    testRun(argc, argv, funcs, ARRAY_SIZE(funcs));
+
+    testReport();
+
+    return 0;
+}
+
+/* vim: set ts=4 sw=4 et : */
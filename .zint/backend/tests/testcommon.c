@@ -488,6 +488,8 @@ const char *testUtilOutputOptionsName(int output_options) {
         { "BARCODE_QUIET_ZONES", BARCODE_QUIET_ZONES, 2048 },
         { "BARCODE_NO_QUIET_ZONES", BARCODE_NO_QUIET_ZONES, 4096 },
         { "COMPLIANT_HEIGHT", COMPLIANT_HEIGHT, 0x2000 },
+        { "BARCODE_MEMORY_FILE", BARCODE_MEMORY_FILE, 0x10000 },
+        { "BARCODE_TIMINGS", BARCODE_TIMINGS, 0x40000000 },
     };
     static int const data_size = ARRAY_SIZE(data);
     int set = 0;
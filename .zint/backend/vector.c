@@ -422,6 +422,13 @@ INTERNAL int plot_vector(struct zint_symbol *symbol, int rotate_angle, int file_
     struct zint_vector_string *last_string = NULL;
     struct zint_vector_circle *circle, *last_circle = NULL;
     struct zint_vector_rect **first_row_rects = z_alloca(sizeof(struct zint_vector_rect *) * (symbol->rows + 1));
+    const int timed = symbol->output_options & BARCODE_TIMINGS;
+    double start = 0.0, output_start = 0.0;
+
+    if (timed) {
+        symbol->timings.plot = symbol->timings.output = 0.0;
+        start = monotonic_ms();
+    }
 
     memset(first_row_rects, 0, sizeof(struct zint_vector_rect *) * (symbol->rows + 1));
 
@@ -961,6 +968,11 @@ INTERNAL int plot_vector(struct zint_symbol *symbol, int rotate_angle, int file_
         vector_rotate(symbol, rotate_angle);
     }
 
+    if (timed) {
+        output_start = monotonic_ms();
+        symbol->timings.plot = output_start - start;
+    }
+
     switch (file_type) {
         case OUT_EPS_FILE:
             error_number = ps_plot(symbol);
@@ -974,6 +986,10 @@ INTERNAL int plot_vector(struct zint_symbol *symbol, int rotate_angle, int file_
         /* case OUT_BUFFER: No more work needed */
     }
 
+    if (timed) {
+        symbol->timings.output = monotonic_ms() - output_start;
+    }
+
     return error_number;
 }
 
@@ -89,11 +89,16 @@ extern "C" {
         char id[32];        /* Optional ID to distinguish sequence, ASCII, NUL-terminated unless max 32 long */
     };
 
-    /* Main symbol structure */
-    
-  struct zint_symbol {
-      char rendered_data[1000000];
+    /* Durations of the phases of the last encode and output, in milliseconds (`BARCODE_TIMINGS` only) */
+    struct zint_timings {
+        double convert;     /* Input processing (escapes, UTF-8, GS1 verification) */
+        double encode;      /* Symbology encoding (incl. any ECI retry) */
+        double plot;        /* Raster/vector layout of the encoded symbol */
+        double output;      /* Output of the layout (rotation, bitmap buffering or file writing) */
+    };
 
+    /* Main symbol structure */
+    struct zint_symbol {
         int symbology;      /* Symbol to use (see BARCODE_XXX below) */
         float height;       /* Barcode height in X-dimensions (ignored for fixed-width barcodes) */
         float scale;        /* Scale factor when printing barcode, i.e. adjusts X-dimension. Default 1 */
@@ -131,6 +136,9 @@ extern "C" {
         unsigned char *alphamap; /* Array of alpha values used (raster output only) */
         unsigned int bitmap_byte_length; /* Size of BMP bitmap data (raster output only) */
         struct zint_vector *vector; /* Pointer to vector header (vector output only) */
+        unsigned char *memfile; /* In-memory file buffer, NUL-terminated (`BARCODE_MEMORY_FILE` only) */
+        int memfile_size;   /* Length of in-memory file buffer, not counting NUL (`BARCODE_MEMORY_FILE` only) */
+        struct zint_timings timings; /* Phase durations (`BARCODE_TIMINGS` only) (output only) */
     };
 
     /* Segment for use with `ZBarcode_Encode_Segs()` below */
@@ -285,6 +293,9 @@ extern "C" {
                                          */
 #define BARCODE_NO_QUIET_ZONES  0x1000  /* Disable quiet zones, notably those with defaults as listed above */
 #define COMPLIANT_HEIGHT        0x2000  /* Warn if height not compliant and use standard height (if any) as default */
+#define BARCODE_MEMORY_FILE     0x10000 /* Write output to in-memory buffer `memfile` instead of to `outfile` */
+#define BARCODE_TIMINGS         0x40000000 /* Record the duration of each encode and output phase in `timings` */
+                                        /* Note: highest bit of a positive `int`, clear of those allocated upstream */
 
 /* Input data types (`symbol->input_mode`) */
 #define DATA_MODE               0       /* Binary */
@@ -38,6 +38,7 @@ HEADERS +=  ../backend/aztec.h \
             ../backend/eci.h \
             ../backend/eci_sb.h \
             ../backend/emf.h \
+            ../backend/filemem.h \
             ../backend/font.h \
             ../backend/gb18030.h \
             ../backend/gb2312.h \
@@ -85,6 +86,7 @@ SOURCES += ../backend/2of5.c \
            ../backend/dotcode.c \
            ../backend/eci.c \
            ../backend/emf.c \
+           ../backend/filemem.c \
            ../backend/general_field.c \
            ../backend/gif.c \
            ../backend/gridmtx.c \
@@ -46,6 +46,7 @@
         ".zint/backend/dotcode.c",
         ".zint/backend/eci.c",
         ".zint/backend/emf.c",
+        ".zint/backend/filemem.c",
         ".zint/backend/general_field.c",
         ".zint/backend/gif.c",
         ".zint/backend/hanxin.c",
@@ -55,6 +56,11 @@
         ".zint/backend/tif.c",
         ".zint/backend/ultra.c",
         ".zint/backend/vector.c",
+        "src/binding/base64.cpp",
+        "src/binding/cache.cpp",
+        "src/binding/geometry.cpp",
+        "src/binding/image.cpp",
+        "src/binding/stats.cpp",
         "src/binding/main.cpp"
       ],
       "include_dirs": [
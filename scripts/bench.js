@@ -0,0 +1,248 @@
+/**
+ * Benchmarks the built module (`dist`): runs a corpus of representative payloads through `encode()`,
+ * `createRaster()`, `createVector()` and `createStream()` with each output type, and reports ops/s, p50/p99 latency
+ * and bytes allocated per op, as a table or as JSON (`-j`). The corpus is the same as that of the zint benchmark
+ * harness (`.zint/backend/tests/bench.c`), so that both report comparable results.
+ *
+ *   node --expose-gc scripts/bench.js [-c case[,case...]] [-p path[,path...]] [-n iterations] [-t ms] [-w warmups] [-j]
+ *
+ * Bytes allocated (JS heap and external memory, e.g. Buffers) can only be measured with `--expose-gc`.
+ */
+const { PerformanceObserver } = require('perf_hooks')
+const { version } = require('../package.json')
+const symbology = require('../dist').default
+
+const { SymbologyType, OutputType, RasterMode } = symbology
+
+/** Minimum number of iterations of a time-based run */
+const MIN_ITERATIONS = 10
+
+/** Number of ops of which the allocations are measured */
+const ALLOC_ITERATIONS = 10
+
+/** Characters of the generated payloads (URL-like text, so that every symbology picks a mix of modes) */
+const TEXT = 'ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789 -./:'
+const DIGITS = '0123456789'
+
+/**
+ * Keep in sync with `bench_cases` of `bench.c`.
+ */
+const cases = [
+  { name: 'ean13', config: { symbology: SymbologyType.EANX }, data: '5901234123457' },
+  { name: 'code128-100', config: { symbology: SymbologyType.CODE128 }, length: 100, charset: DIGITS },
+  { name: 'qr-1k', config: { symbology: SymbologyType.QRCODE }, length: 1024, charset: TEXT },
+  { name: 'qr-3k', config: { symbology: SymbologyType.QRCODE }, length: 2900, charset: TEXT },
+  { name: 'datamatrix-1k', config: { symbology: SymbologyType.DATAMATRIX }, length: 1024, charset: TEXT },
+  { name: 'pdf417-1k', config: { symbology: SymbologyType.PDF417 }, length: 1024, charset: TEXT },
+  { name: 'aztec-1k', config: { symbology: SymbologyType.AZTEC }, length: 1024, charset: TEXT },
+  { name: 'dotcode-1k', config: { symbology: SymbologyType.DOTCODE, option2: 150 }, length: 1024, charset: TEXT },
+  { name: 'ean13-cc', config: { symbology: SymbologyType.EANX_CC, option1: 1, primary: '331234567890' }, data: '[99]1234-abcd' },
+  { name: 'gs1-128-cc', config: { symbology: SymbologyType.EAN128_CC, option1: 3, primary: '[01]12345678901231' }, data: '[10]ABC123[21]SN0123456789[17]251231' }
+]
+
+const paths = [
+  { name: 'encode', run: (config, data) => symbology.encode(config, data) },
+  { name: 'raster', run: (config, data) => symbology.createRaster(config, data, RasterMode.RGBA) },
+  { name: 'vector', run: (config, data) => symbology.createVector(config, data) },
+  ...[OutputType.PNG, OutputType.SVG, OutputType.EPS, OutputType.EMF, OutputType.GIF, OutputType.BMP, OutputType.PCX, OutputType.TIFF]
+    .map(outputType => ({ name: outputType, run: (config, data) => symbology.createStream(config, data, outputType) }))
+]
+
+/**
+ * Generates `length` characters of payload, the same for every run (the same LCG as `bench.c`).
+ *
+ * @param {number} length
+ * @param {string} charset
+ * @returns {string}
+ */
+const generate = (length, charset) => {
+  let seed = 1
+  let data = ''
+
+  for (let i = 0; i < length; i++) {
+    seed = (Math.imul(seed, 1103515245) + 12345) & 0x7FFFFFFF
+    data += charset[(seed >> 16) % charset.length]
+  }
+  return data
+}
+
+/**
+ * Parses the command line options (the same as those of `bench.c`).
+ *
+ * @param {string[]} args
+ * @returns {object}
+ */
+const parseOptions = args => {
+  const options = { cases: null, paths: null, iterations: 0, minMs: 200, warmups: 3, json: false }
+
+  for (let i = 0; i < args.length; i++) {
+    switch (args[i]) {
+      case '-c':
+        options.cases = args[++i].split(',')
+        break
+      case '-p':
+        options.paths = args[++i].split(',')
+        break
+      case '-n':
+        options.iterations = parseInt(args[++i], 10)
+        break
+      case '-t':
+        options.minMs = parseInt(args[++i], 10)
+        break
+      case '-w':
+        options.warmups = parseInt(args[++i], 10)
+        break
+      case '-j':
+        options.json = true
+        break
+      default:
+        console.log('Usage: node --expose-gc scripts/bench.js [-c case[,case...]] [-p path[,path...]] [-n iterations] [-t ms] [-w warmups] [-j]')
+        process.exit(args[i] === '-h' ? 0 : 1)
+    }
+  }
+  return options
+}
+
+/**
+ * Returns the nearest-rank percentile of sorted latencies.
+ *
+ * @param {number[]} sorted
+ * @param {number} percentile
+ * @returns {number}
+ */
+const getPercentile = (sorted, percentile) => sorted[Math.max(Math.ceil(percentile * sorted.length) - 1, 0)]
+
+/**
+ * Returns the bytes allocated by each of a few ops, or null if they can't be measured: without `--expose-gc`, or if
+ * the garbage collector ran in between (which would hide some of them).
+ *
+ * @param {Function} op
+ * @returns {Promise<number | null>}
+ */
+const measureAllocations = async op => {
+  if (typeof global.gc !== 'function') {
+    return null
+  }
+
+  let collections = 0
+  const observer = new PerformanceObserver(list => { collections += list.getEntries().length })
+  const getUsage = () => {
+    const { heapUsed, external } = process.memoryUsage()
+
+    return heapUsed + external
+  }
+
+  global.gc()
+  observer.observe({ entryTypes: ['gc'] })
+
+  const before = getUsage()
+
+  for (let i = 0; i < ALLOC_ITERATIONS; i++) {
+    await op()
+  }
+
+  const bytes = getUsage() - before
+
+  // gc entries are delivered asynchronously
+  await new Promise(resolve => setImmediate(resolve))
+  observer.disconnect()
+
+  return collections === 0 ? Math.max(bytes, 0) / ALLOC_ITERATIONS : null
+}
+
+/**
+ * Runs `iterations` ops, or if 0, as many as fit in `minMs` (at least `MIN_ITERATIONS`), one after another.
+ *
+ * @param {Function} op
+ * @param {object} options
+ * @returns {Promise<object>}
+ */
+const measure = async (op, { iterations, minMs, warmups }) => {
+  const latencies = []
+  let totalMs = 0
+
+  for (let i = 0; i < warmups; i++) {
+    await op()
+  }
+
+  while (iterations ? latencies.length < iterations : totalMs < minMs || latencies.length < MIN_ITERATIONS) {
+    const start = process.hrtime.bigint()
+
+    await op()
+
+    const ms = Number(process.hrtime.bigint() - start) / 1e6
+
+    latencies.push(ms)
+    totalMs += ms
+  }
+
+  latencies.sort((a, b) => a - b)
+
+  return {
+    iterations: latencies.length,
+    ops_per_sec: latencies.length * 1000 / totalMs,
+    p50_us: getPercentile(latencies, 0.5) * 1000,
+    p99_us: getPercentile(latencies, 0.99) * 1000,
+    bytes_per_op: await measureAllocations(op),
+    // allocations can't be counted from JS
+    allocs_per_op: null
+  }
+}
+
+const run = async () => {
+  const options = parseOptions(process.argv.slice(2))
+  const results = []
+  let failed = false
+
+  if (!options.json) {
+    console.log(['case'.padEnd(16), 'path'.padEnd(8), 'iterations'.padStart(10), 'ops/s'.padStart(12), 'p50 (us)'.padStart(10), 'p99 (us)'.padStart(10), 'bytes/op'.padStart(12)].join(' '))
+  }
+
+  for (const { name, config, data, length, charset } of cases) {
+    if (options.cases && !options.cases.includes(name)) {
+      continue
+    }
+
+    const payload = data || generate(length, charset)
+
+    for (const path of paths) {
+      if (options.paths && !options.paths.includes(path.name)) {
+        continue
+      }
+
+      try {
+        const result = {
+          case: name,
+          path: path.name,
+          symbology: config.symbology,
+          length: payload.length,
+          ...await measure(() => path.run(config, payload), options)
+        }
+
+        results.push(result)
+
+        if (!options.json) {
+          console.log([
+            name.padEnd(16),
+            path.name.padEnd(8),
+            String(result.iterations).padStart(10),
+            result.ops_per_sec.toFixed(1).padStart(12),
+            result.p50_us.toFixed(1).padStart(10),
+            result.p99_us.toFixed(1).padStart(10),
+            (result.bytes_per_op === null ? '-' : result.bytes_per_op.toFixed(0)).padStart(12)
+          ].join(' '))
+        }
+      } catch (err) {
+        console.error(`bench: ${name} ${path.name} failed (${err})`)
+        failed = true
+      }
+    }
+  }
+
+  if (options.json) {
+    console.log(JSON.stringify({ harness: 'node', version, results }, null, 2))
+  }
+  process.exitCode = failed ? 1 : 0
+}
+
+run()
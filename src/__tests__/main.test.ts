@@ -1,14 +1,15 @@
 import fs from 'fs'
-import { PNG } from 'pngjs'
 import binary from '../lib/binary'
 import png from '../lib/png'
 import SymbologyType from '../types/enums/SymbologyType'
-import { createStream, createFile } from '../main'
+import { createStream, createStreams, createFile, createFiles, createEncoder, createReadStream, createRenders, createVector, createRaster, encode, configureCache, clearCache, getCacheStats, configureStats, clearStats, getStats } from '../main'
 import OutputType from '../types/enums/OutputType'
+import RasterMode from '../types/enums/RasterMode'
 
 describe('Symbology Library', () => {
   const mockPngRes = {
-    bitmap: [1, 2, 3, 4, 5, 6],
+    bitmap: Buffer.alloc(0),
+    image: Buffer.from([0x89, 0x50, 0x4e, 0x47]),
     encodedData: '',
     width: 20,
     height: 25,
@@ -17,21 +18,15 @@ describe('Symbology Library', () => {
   }
   const mockSvgRes = {
     ...mockPngRes,
+    image: Buffer.alloc(0),
     encodedData: '<svg>...</svg>'
   }
-  const mockPngImage = new PNG({
-    width: mockPngRes.width,
-    height: mockPngRes.height
-  })
   const mockBase64Png = 'data:image/png;base64,iVBOR=='
 
   beforeEach(() => {
     jest
-      .spyOn(png, 'render')
-      .mockReturnValue(mockPngImage)
-    jest
-      .spyOn(png, 'blobToBase64')
-      .mockResolvedValue(mockBase64Png)
+      .spyOn(png, 'toBase64')
+      .mockReturnValue(mockBase64Png)
   })
 
   afterEach(() => jest.resetAllMocks())
@@ -46,10 +41,8 @@ describe('Symbology Library', () => {
         symbology: SymbologyType.CODE128
       }, '12345', OutputType.PNG)
 
-      expect(png.render).toHaveBeenCalledTimes(1)
-      expect(png.render).toHaveBeenCalledWith(mockPngRes.bitmap, mockPngRes.width, mockPngRes.height, 'FFFFFFFF', '000000FF')
-      expect(png.blobToBase64).toHaveBeenCalledTimes(1)
-      expect(png.blobToBase64).toHaveBeenCalledWith(mockPngImage)
+      expect(png.toBase64).toHaveBeenCalledTimes(1)
+      expect(png.toBase64).toHaveBeenCalledWith(mockPngRes.image, 'image/png')
 
       expect(res.data).toEqual(mockBase64Png)
       expect(res.width).toEqual(mockPngRes.width)
@@ -66,8 +59,7 @@ describe('Symbology Library', () => {
         symbology: SymbologyType.CODE128
       }, '12345', OutputType.SVG)
 
-      expect(png.render).not.toHaveBeenCalled()
-      expect(png.blobToBase64).not.toHaveBeenCalled()
+      expect(png.toBase64).not.toHaveBeenCalled()
 
       expect(res.data).toEqual(mockSvgRes.encodedData)
       expect(res.width).toEqual(mockSvgRes.width)
@@ -75,6 +67,34 @@ describe('Symbology Library', () => {
       expect(res.message).toEqual(mockSvgRes.message)
     })
 
+    it('should render other image types as a base64 data URL of their MIME type', async () => {
+      jest
+        .spyOn(binary, 'invoke')
+        .mockResolvedValue(mockPngRes)
+
+      await createStream({
+        symbology: SymbologyType.CODE128
+      }, '12345', OutputType.GIF)
+
+      expect(png.toBase64).toHaveBeenCalledWith(mockPngRes.image, 'image/gif')
+    })
+
+    it('should use the data URL created natively when present', async () => {
+      const dataUrl = 'data:image/png;base64,native=='
+
+      jest
+        .spyOn(binary, 'invoke')
+        .mockResolvedValue({ ...mockPngRes, dataUrl })
+
+      const res = await createStream({
+        symbology: SymbologyType.CODE128
+      }, '12345', OutputType.PNG)
+
+      expect(binary.invoke).toHaveBeenCalledWith(expect.anything(), '12345', OutputType.PNG, true)
+      expect(png.toBase64).not.toHaveBeenCalled()
+      expect(res.data).toEqual(dataUrl)
+    })
+
     it('should fallback to a PNG image if no output type is specified', async () => {
       jest
         .spyOn(binary, 'invoke')
@@ -84,16 +104,363 @@ describe('Symbology Library', () => {
         symbology: SymbologyType.CODE128
       }, '12345')
 
-      expect(png.render).toHaveBeenCalledTimes(1)
-      expect(png.render).toHaveBeenCalledWith(mockPngRes.bitmap, mockPngRes.width, mockPngRes.height, 'FFFFFFFF', '000000FF')
-      expect(png.blobToBase64).toHaveBeenCalledTimes(1)
-      expect(png.blobToBase64).toHaveBeenCalledWith(mockPngImage)
+      expect(png.toBase64).toHaveBeenCalledTimes(1)
+      expect(png.toBase64).toHaveBeenCalledWith(mockPngRes.image, 'image/png')
+
+      expect(res.data).toEqual(mockBase64Png)
+      expect(res.width).toEqual(mockPngRes.width)
+      expect(res.height).toEqual(mockPngRes.height)
+      expect(res.message).toEqual(mockPngRes.message)
+    })
+
+    it('should pass on the timings of the render, if any', async () => {
+      const timings = { queue: 0.1, convert: 0.01, encode: 0.2, plot: 0.05, output: 0.02, image: 0.3, dataUrl: 0.01, total: 0.7 }
+
+      jest
+        .spyOn(binary, 'invoke')
+        .mockResolvedValue({ ...mockPngRes, timings })
+
+      const res = await createStream({
+        symbology: SymbologyType.CODE128
+      }, '12345')
+
+      expect(res.timings).toEqual(timings)
+    })
+
+    it('should not set timings if the render was not timed', async () => {
+      jest
+        .spyOn(binary, 'invoke')
+        .mockResolvedValue(mockSvgRes)
+
+      const res = await createStream({
+        symbology: SymbologyType.CODE128
+      }, '12345', OutputType.SVG)
+
+      expect(res).not.toHaveProperty('timings')
+    })
+  })
+
+  describe('createStreams()', () => {
+    it('should render every item of the batch with one native call', async () => {
+      jest
+        .spyOn(binary, 'invokeAll')
+        .mockResolvedValue([mockSvgRes, mockSvgRes])
+
+      const dataArray = ['12345', '67890']
+      const res = await createStreams({
+        symbology: SymbologyType.CODE128
+      }, dataArray, OutputType.SVG)
+
+      expect(binary.invokeAll).toHaveBeenCalledTimes(1)
+      expect(binary.invokeAll).toHaveBeenCalledWith(expect.objectContaining({
+        symbology: SymbologyType.CODE128
+      }), dataArray, OutputType.SVG)
+      expect(res).toEqual([
+        { data: mockSvgRes.encodedData, width: mockSvgRes.width, height: mockSvgRes.height, message: mockSvgRes.message, code: mockSvgRes.code },
+        { data: mockSvgRes.encodedData, width: mockSvgRes.width, height: mockSvgRes.height, message: mockSvgRes.message, code: mockSvgRes.code }
+      ])
+    })
+
+    it('should render PNG images as base64 strings by default', async () => {
+      jest
+        .spyOn(binary, 'invokeAll')
+        .mockResolvedValue([mockPngRes])
+
+      const res = await createStreams({
+        symbology: SymbologyType.CODE128
+      }, ['12345'])
+
+      expect(binary.invokeAll).toHaveBeenCalledWith(expect.anything(), ['12345'], OutputType.PNG)
+      expect(png.toBase64).toHaveBeenCalledWith(mockPngRes.image, 'image/png')
+      expect(res[0].data).toEqual(mockBase64Png)
+    })
+
+    it('should give the message and status code of items which failed to render', async () => {
+      jest
+        .spyOn(binary, 'invokeAll')
+        .mockResolvedValue([mockSvgRes, { ...mockSvgRes, code: 5, message: 'Failure' }])
+
+      const res = await createStreams({
+        symbology: SymbologyType.CODE128
+      }, ['12345', 'bad'], OutputType.SVG)
+
+      expect(res[0].code).toEqual(mockSvgRes.code)
+      expect(res[1]).toEqual({ width: 0, height: 0, message: 'Failure', code: 5 })
+    })
+  })
+
+  describe('createEncoder()', () => {
+    it('should create one native encoder for the config and output type', () => {
+      jest
+        .spyOn(binary, 'createEncoder')
+        .mockReturnValue({ encode: jest.fn() })
+
+      createEncoder({
+        symbology: SymbologyType.CODE128
+      }, OutputType.SVG)
+
+      expect(binary.createEncoder).toHaveBeenCalledTimes(1)
+      expect(binary.createEncoder).toHaveBeenCalledWith(expect.objectContaining({
+        symbology: SymbologyType.CODE128
+      }), OutputType.SVG)
+    })
+
+    it('should render each encoded PNG image as a base64 string', async () => {
+      const encode = jest.fn().mockResolvedValue(mockPngRes)
+
+      jest
+        .spyOn(binary, 'createEncoder')
+        .mockReturnValue({ encode })
 
+      const encoder = createEncoder({
+        symbology: SymbologyType.CODE128
+      })
+      const res = await encoder.encode('12345')
+
+      expect(encode).toHaveBeenCalledWith('12345', true)
+      expect(png.toBase64).toHaveBeenCalledWith(mockPngRes.image, 'image/png')
       expect(res.data).toEqual(mockBase64Png)
       expect(res.width).toEqual(mockPngRes.width)
       expect(res.height).toEqual(mockPngRes.height)
       expect(res.message).toEqual(mockPngRes.message)
     })
+
+    it('should render each encoded SVG as a string', async () => {
+      jest
+        .spyOn(binary, 'createEncoder')
+        .mockReturnValue({ encode: jest.fn().mockResolvedValue(mockSvgRes) })
+
+      const res = await createEncoder({
+        symbology: SymbologyType.CODE128
+      }, OutputType.SVG).encode('12345')
+
+      expect(png.toBase64).not.toHaveBeenCalled()
+      expect(res.data).toEqual(mockSvgRes.encodedData)
+    })
+  })
+
+  describe('createRenders()', () => {
+    it('should convert the result of each render to the format of its output type', async () => {
+      jest
+        .spyOn(binary, 'invokeRenders')
+        .mockResolvedValue([mockPngRes, mockSvgRes])
+
+      const specs = [
+        { outputType: OutputType.PNG, scale: 4 },
+        { outputType: OutputType.SVG }
+      ]
+      const res = await createRenders({
+        symbology: SymbologyType.CODE128
+      }, '12345', specs)
+
+      expect(binary.invokeRenders).toHaveBeenCalledWith(expect.objectContaining({
+        symbology: SymbologyType.CODE128,
+        height: 50
+      }), '12345', specs)
+      expect(png.toBase64).toHaveBeenCalledWith(mockPngRes.image, 'image/png')
+      expect(res[0].data).toEqual(mockBase64Png)
+      expect(res[1].data).toEqual(mockSvgRes.encodedData)
+    })
+  })
+
+  describe('createVector()', () => {
+    it('should return the vector geometry of the symbology with the default config applied', async () => {
+      const vector = {
+        width: 20,
+        height: 10,
+        rectangles: new Float32Array([0, 0, 2, 10, -1]),
+        hexagons: new Float32Array(0),
+        circles: new Float32Array(0),
+        strings: new Float32Array(0),
+        texts: [],
+        message: 'Codify successfully created.',
+        code: 0
+      }
+
+      jest
+        .spyOn(binary, 'invokeVector')
+        .mockResolvedValue(vector)
+
+      const res = await createVector({
+        symbology: SymbologyType.CODE128
+      }, '12345')
+
+      expect(binary.invokeVector).toHaveBeenCalledWith(expect.objectContaining({
+        symbology: SymbologyType.CODE128,
+        height: 50
+      }), '12345')
+      expect(res).toEqual(vector)
+    })
+  })
+
+  describe('createRaster()', () => {
+    it('should return the RGBA pixels of the symbology with the default config applied', async () => {
+      const raster = {
+        mode: RasterMode.RGBA,
+        width: 2,
+        height: 1,
+        stride: 8,
+        pixels: Buffer.from([0, 0, 0, 255, 255, 255, 255, 0]),
+        palette: Buffer.alloc(0),
+        message: 'Codify successfully created.',
+        code: 0
+      }
+
+      jest
+        .spyOn(binary, 'invokeRaster')
+        .mockResolvedValue(raster)
+
+      const res = await createRaster({
+        symbology: SymbologyType.CODE128
+      }, '12345')
+
+      expect(binary.invokeRaster).toHaveBeenCalledWith(expect.objectContaining({
+        symbology: SymbologyType.CODE128,
+        height: 50
+      }), '12345', RasterMode.RGBA)
+      expect(res).toEqual(raster)
+    })
+  })
+
+  describe('encode()', () => {
+    it('should return the module matrix of the symbology with the default config applied', async () => {
+      const matrix = {
+        rows: 1,
+        width: 11,
+        stride: 2,
+        height: 50,
+        modules: Buffer.from([0x8b, 0x01]),
+        colours: Buffer.alloc(0),
+        rowHeights: new Float32Array([50]),
+        message: 'Codify successfully created.',
+        code: 0
+      }
+
+      jest
+        .spyOn(binary, 'invokeMatrix')
+        .mockResolvedValue(matrix)
+
+      const res = await encode({
+        symbology: SymbologyType.CODE128
+      }, '12345')
+
+      expect(binary.invokeMatrix).toHaveBeenCalledWith(expect.objectContaining({
+        symbology: SymbologyType.CODE128,
+        height: 50
+      }), '12345')
+      expect(res).toEqual(matrix)
+    })
+  })
+
+  describe('createReadStream()', () => {
+    const readAll = async (stream: NodeJS.ReadableStream) => {
+      const results = []
+
+      for await (const res of stream) {
+        results.push(res)
+      }
+
+      return results
+    }
+
+    it('should emit a result for each item of the source in order', async () => {
+      const encode = jest.fn((data: string) => new Promise<typeof mockSvgRes>(resolve => {
+        // resolve later items first
+        setTimeout(() => resolve({ ...mockSvgRes, encodedData: data }), 10 - Number(data))
+      }))
+
+      jest
+        .spyOn(binary, 'createEncoder')
+        .mockReturnValue({ encode })
+
+      const results = await readAll(createReadStream({
+        symbology: SymbologyType.CODE128
+      }, ['1', '2', '3', '4', '5'], OutputType.SVG))
+
+      expect(binary.createEncoder).toHaveBeenCalledTimes(1)
+      expect(results.map(res => res.data)).toEqual(['1', '2', '3', '4', '5'])
+    })
+
+    it('should read from an async iterable', async () => {
+      async function * source () {
+        yield '12345'
+        yield '67890'
+      }
+
+      jest
+        .spyOn(binary, 'createEncoder')
+        .mockReturnValue({ encode: jest.fn().mockResolvedValue(mockPngRes) })
+
+      const results = await readAll(createReadStream({
+        symbology: SymbologyType.CODE128
+      }, source()))
+
+      expect(results).toHaveLength(2)
+      expect(results[0].data).toEqual(mockBase64Png)
+    })
+
+    it('should not render more than `concurrency` items at once', async () => {
+      let inFlight = 0
+      let maxInFlight = 0
+      const encode = jest.fn(() => {
+        maxInFlight = Math.max(maxInFlight, ++inFlight)
+
+        return new Promise<typeof mockSvgRes>(resolve => setTimeout(() => {
+          inFlight--
+          resolve(mockSvgRes)
+        }))
+      })
+
+      jest
+        .spyOn(binary, 'createEncoder')
+        .mockReturnValue({ encode })
+
+      const results = await readAll(createReadStream({
+        symbology: SymbologyType.CODE128
+      }, new Array(20).fill('12345'), OutputType.SVG, { concurrency: 3 }))
+
+      expect(results).toHaveLength(20)
+      expect(maxInFlight).toEqual(3)
+    })
+
+    it('should not read the source until the stream is consumed', async () => {
+      const encode = jest.fn().mockResolvedValue(mockSvgRes)
+
+      jest
+        .spyOn(binary, 'createEncoder')
+        .mockReturnValue({ encode })
+
+      const stream = createReadStream({
+        symbology: SymbologyType.CODE128
+      }, ['12345'], OutputType.SVG)
+
+      await new Promise(resolve => setTimeout(resolve, 10))
+
+      expect(encode).not.toHaveBeenCalled()
+      stream.destroy()
+    })
+
+    it('should emit the raw image files as Buffers', async () => {
+      jest
+        .spyOn(binary, 'createEncoder')
+        .mockReturnValue({ encode: jest.fn().mockResolvedValue(mockSvgRes) })
+
+      const [res] = await readAll(createReadStream({
+        symbology: SymbologyType.CODE128
+      }, ['12345'], OutputType.SVG, { raw: true }))
+
+      expect(res).toEqual(Buffer.from(mockSvgRes.encodedData))
+    })
+
+    it('should destroy the stream with the message of a failed render', async () => {
+      jest
+        .spyOn(binary, 'createEncoder')
+        .mockReturnValue({ encode: jest.fn().mockRejectedValue('Invalid data') })
+
+      await expect(readAll(createReadStream({
+        symbology: SymbologyType.CODE128
+      }, ['12345']))).rejects.toThrow('Invalid data')
+    })
   })
 
   describe('createFile()', () => {
@@ -122,10 +489,8 @@ describe('Symbology Library', () => {
         fileName
       }, '12345')
 
-      expect(png.render).toHaveBeenCalledTimes(1)
-      expect(png.render).toHaveBeenCalledWith(mockPngRes.bitmap, mockPngRes.width, mockPngRes.height, 'FFFFFFFF', '000000FF')
       expect(fs.writeFileSync).toHaveBeenCalledTimes(1)
-      expect(fs.writeFileSync).toHaveBeenCalledWith(fileName, png.getBuffer(mockPngImage))
+      expect(fs.writeFileSync).toHaveBeenCalledWith(fileName, mockPngRes.image)
 
       expect(res.width).toEqual(mockPngRes.width)
       expect(res.height).toEqual(mockPngRes.height)
@@ -143,7 +508,6 @@ describe('Symbology Library', () => {
         fileName
       }, '12345')
 
-      expect(png.render).not.toHaveBeenCalled()
       expect(fs.writeFileSync).toHaveBeenCalledTimes(1)
       expect(fs.writeFileSync).toHaveBeenCalledWith(fileName, mockSvgRes.encodedData)
 
@@ -151,5 +515,154 @@ describe('Symbology Library', () => {
       expect(res.height).toEqual(mockSvgRes.height)
       expect(res.message).toEqual(mockSvgRes.message)
     })
+
+    it('should write the natively-rendered file of other image types, such as `.tiff`', async () => {
+      const mockTiffRes = {
+        ...mockPngRes,
+        image: Buffer.from([0x49, 0x49, 0x2a, 0x00])
+      }
+
+      jest
+        .spyOn(binary, 'invoke')
+        .mockResolvedValue(mockTiffRes)
+
+      const fileName = 'out.tiff'
+
+      await createFile({
+        symbology: SymbologyType.CODE128,
+        fileName
+      }, '12345')
+
+      expect(binary.invoke).toHaveBeenCalledWith(expect.any(Object), '12345', OutputType.TIFF)
+      expect(fs.writeFileSync).toHaveBeenCalledWith(fileName, mockTiffRes.image)
+    })
+  })
+
+  describe('createFiles()', () => {
+    beforeEach(() => {
+      jest
+        .spyOn(fs, 'writeFileSync')
+        .mockReturnValue()
+    })
+
+    it('should render each output type with one native call and write the files in order', async () => {
+      jest
+        .spyOn(binary, 'invokeAll')
+        .mockImplementation(async (config, dataArray, outputType) => dataArray.map(() => outputType === OutputType.PNG ? mockPngRes : mockSvgRes))
+
+      const res = await createFiles({
+        symbology: SymbologyType.CODE128
+      }, [
+        { fileName: 'a.png', data: '1' },
+        { fileName: 'b.svg', data: '2' },
+        { fileName: 'c.png', data: '3' }
+      ])
+
+      expect(binary.invokeAll).toHaveBeenCalledTimes(2)
+      expect(binary.invokeAll).toHaveBeenCalledWith(expect.anything(), ['1', '3'], OutputType.PNG)
+      expect(binary.invokeAll).toHaveBeenCalledWith(expect.anything(), ['2'], OutputType.SVG)
+
+      expect(fs.writeFileSync).toHaveBeenCalledTimes(3)
+      expect(fs.writeFileSync).toHaveBeenCalledWith('a.png', mockPngRes.image)
+      expect(fs.writeFileSync).toHaveBeenCalledWith('b.svg', mockSvgRes.encodedData)
+      expect(fs.writeFileSync).toHaveBeenCalledWith('c.png', mockPngRes.image)
+
+      expect(res.map(r => r.code)).toEqual([mockPngRes.code, mockSvgRes.code, mockPngRes.code])
+    })
+
+    it('should not write the files of items which failed to render', async () => {
+      jest
+        .spyOn(binary, 'invokeAll')
+        .mockResolvedValue([{ ...mockSvgRes, code: 5, message: 'Failure' }])
+
+      const res = await createFiles({
+        symbology: SymbologyType.CODE128
+      }, [{ fileName: 'a.svg', data: 'bad' }])
+
+      expect(fs.writeFileSync).not.toHaveBeenCalled()
+      expect(res).toEqual([{ width: 0, height: 0, message: 'Failure', code: 5 }])
+    })
+  })
+
+  describe('result cache', () => {
+    it('should configure the byte budget of the cache', () => {
+      jest
+        .spyOn(binary, 'configureCache')
+        .mockReturnValue()
+
+      configureCache({ maxBytes: 1 << 20 })
+
+      expect(binary.configureCache).toHaveBeenCalledWith(1 << 20)
+    })
+
+    it('should clear the cache', () => {
+      jest
+        .spyOn(binary, 'clearCache')
+        .mockReturnValue()
+
+      clearCache()
+
+      expect(binary.clearCache).toHaveBeenCalledTimes(1)
+    })
+
+    it('should return the stats of the cache', () => {
+      const stats = { hits: 3, misses: 1, entries: 1, bytes: 512, maxBytes: 1 << 20 }
+
+      jest
+        .spyOn(binary, 'getCacheStats')
+        .mockReturnValue(stats)
+
+      expect(getCacheStats()).toEqual(stats)
+    })
+  })
+
+  describe('render stats', () => {
+    it('should enable or disable the stats', () => {
+      jest
+        .spyOn(binary, 'configureStats')
+        .mockReturnValue()
+
+      configureStats({ enabled: true })
+
+      expect(binary.configureStats).toHaveBeenCalledWith(true)
+    })
+
+    it('should clear the stats', () => {
+      jest
+        .spyOn(binary, 'clearStats')
+        .mockReturnValue()
+
+      clearStats()
+
+      expect(binary.clearStats).toHaveBeenCalledTimes(1)
+    })
+
+    it('should return the stats', () => {
+      const phase = { count: 1, totalMs: 0.5, maxMs: 0.5, histogram: [0, 1] }
+      const stats = {
+        enabled: true,
+        renders: 1,
+        errors: 0,
+        phases: { queue: phase, convert: phase, encode: phase, plot: phase, output: phase, image: phase, dataUrl: phase, total: phase }
+      }
+
+      jest
+        .spyOn(binary, 'getStats')
+        .mockReturnValue(stats)
+
+      expect(getStats()).toEqual(stats)
+    })
+
+    it('should pass on the timings of a failed batch item', async () => {
+      const timings = { queue: 0.1, convert: 0.01, encode: 0.2, total: 0.4 }
+
+      jest
+        .spyOn(binary, 'invokeAll')
+        .mockResolvedValue([{ ...mockPngRes, code: 5, message: 'Failure', timings }])
+
+      const res = await createStreams({ symbology: SymbologyType.CODE128 }, ['12345'], OutputType.PNG)
+
+      expect(res).toEqual([{ width: 0, height: 0, message: 'Failure', code: 5, timings }])
+    })
   })
 })
@@ -0,0 +1,64 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "base64.h"
+
+namespace codify {
+  static const char BASE64_CHARS[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+  size_t getDataUrlLength(const char *mime_type, size_t length) {
+    // "data:" + mime type + ";base64," + 4 characters for every (started) 3 bytes
+    return 5 + strlen(mime_type) + 8 + (length + 2) / 3 * 4;
+  }
+
+  /**
+   * Encodes `length` bytes as base64 into `out`, which must have room for `(length + 2) / 3 * 4` characters.
+   */
+  static void encodeBase64(const unsigned char *data, size_t length, char *out) {
+    size_t i = 0;
+
+    // encode 3 bytes into 4 characters at a time, reading them as one 24-bit group
+    for (; i + 3 <= length; i += 3) {
+      const uint32_t group = ((uint32_t)data[i] << 16) | ((uint32_t)data[i + 1] << 8) | data[i + 2];
+
+      out[0] = BASE64_CHARS[group >> 18];
+      out[1] = BASE64_CHARS[(group >> 12) & 0x3f];
+      out[2] = BASE64_CHARS[(group >> 6) & 0x3f];
+      out[3] = BASE64_CHARS[group & 0x3f];
+      out += 4;
+    }
+
+    // pad the last 1 or 2 bytes
+    if (i < length) {
+      const uint32_t group = ((uint32_t)data[i] << 16) | (i + 1 < length ? (uint32_t)data[i + 1] << 8 : 0);
+
+      out[0] = BASE64_CHARS[group >> 18];
+      out[1] = BASE64_CHARS[(group >> 12) & 0x3f];
+      out[2] = i + 1 < length ? BASE64_CHARS[(group >> 6) & 0x3f] : '=';
+      out[3] = '=';
+    }
+  }
+
+  char *createDataUrl(const char *mime_type, const unsigned char *data, size_t length, size_t *url_length) {
+    const size_t mime_length = strlen(mime_type);
+    char *url = (char*)malloc(getDataUrlLength(mime_type, length));
+    char *out = url;
+
+    if (url == NULL) {
+      return NULL;
+    }
+
+    memcpy(out, "data:", 5);
+    out += 5;
+    memcpy(out, mime_type, mime_length);
+    out += mime_length;
+    memcpy(out, ";base64,", 8);
+    out += 8;
+
+    encodeBase64(data, length, out);
+
+    *url_length = getDataUrlLength(mime_type, length);
+
+    return url;
+  }
+}
@@ -0,0 +1,19 @@
+#ifndef CODIFY_BASE64_H
+#define CODIFY_BASE64_H
+
+#include <stddef.h>
+
+namespace codify {
+  /**
+   * Returns the length of the base64 data URL of `length` bytes of data of the given MIME type.
+   */
+  size_t getDataUrlLength(const char *mime_type, size_t length);
+
+  /**
+   * Writes the base64 data URL (`data:<mime_type>;base64,...`) of the given data into a single malloc'd block of
+   * exactly `getDataUrlLength()` bytes (not NUL-terminated), owned by the caller. Returns NULL if out of memory.
+   */
+  char *createDataUrl(const char *mime_type, const unsigned char *data, size_t length, size_t *url_length);
+}
+
+#endif
@@ -0,0 +1,133 @@
+#include <string.h>
+#include "cache.h"
+
+namespace codify {
+  std::shared_ptr<CachedResult> ResultCache::get(uint64_t hash, const std::string &key) {
+    std::unordered_map<uint64_t, ResultList::iterator>::iterator found = index.find(hash);
+
+    // compare the whole key too, so that a hash collision is a miss rather than a wrong result
+    if (found == index.end() || (*found->second)->key != key) {
+      misses++;
+      return std::shared_ptr<CachedResult>();
+    }
+
+    // move the result to the front, as the most recently used
+    results.splice(results.begin(), results, found->second);
+    hits++;
+
+    return *found->second;
+  }
+
+  void ResultCache::put(const std::shared_ptr<CachedResult> &result) {
+    size_t size = result->size();
+
+    if (size > max_bytes) {
+      return;
+    }
+
+    std::unordered_map<uint64_t, ResultList::iterator>::iterator found = index.find(result->hash);
+
+    if (found != index.end()) {
+      // replace the result with the same hash (the same key, or a collision)
+      bytes -= (*found->second)->size();
+      results.erase(found->second);
+      index.erase(found);
+    }
+
+    evict(max_bytes - size);
+
+    results.push_front(result);
+    index[result->hash] = results.begin();
+    bytes += size;
+  }
+
+  void ResultCache::addDataUrl(const std::shared_ptr<CachedResult> &result, const std::string &mime_type, char *url, size_t length) {
+    std::unordered_map<uint64_t, ResultList::iterator>::iterator found = index.find(result->hash);
+    bool is_cached = found != index.end() && *found->second == result;
+
+    if (!is_cached) {
+      result->addDataUrl(mime_type, url, length);
+      return;
+    }
+
+    bytes -= result->size();
+    result->addDataUrl(mime_type, url, length);
+    bytes += result->size();
+
+    evict(max_bytes);
+  }
+
+  void ResultCache::clear() {
+    results.clear();
+    index.clear();
+    bytes = 0;
+  }
+
+  void ResultCache::setMaxBytes(size_t max_bytes) {
+    this->max_bytes = max_bytes;
+    evict(max_bytes);
+  }
+
+  void ResultCache::evict(size_t max_bytes) {
+    while (bytes > max_bytes && !results.empty()) {
+      bytes -= results.back()->size();
+      index.erase(results.back()->hash);
+      results.pop_back();
+    }
+  }
+
+  /**
+   * Appends the bytes of a value of a fixed size to a key.
+   */
+  template <typename T>
+  static void appendValue(std::string &key, const T &value) {
+    key.append((const char*)&value, sizeof(value));
+  }
+
+  /**
+   * Appends a string to a key, prefixed with its length so that adjacent strings can't run into each other.
+   */
+  static void appendString(std::string &key, const char *value, size_t length) {
+    appendValue(key, length);
+    key.append(value, length);
+  }
+
+  std::string getCacheKey(const zint_symbol *symbol, int rotate_angle, const std::string &data) {
+    std::string key;
+
+    key.reserve(128 + data.size());
+
+    appendValue(key, symbol->symbology);
+    appendValue(key, symbol->height);
+    appendValue(key, symbol->scale);
+    appendValue(key, symbol->whitespace_width);
+    appendValue(key, symbol->border_width);
+    appendValue(key, symbol->output_options);
+    appendValue(key, symbol->option_1);
+    appendValue(key, symbol->option_2);
+    appendValue(key, symbol->option_3);
+    appendValue(key, symbol->show_hrt);
+    appendValue(key, symbol->input_mode);
+    appendValue(key, symbol->eci);
+    appendValue(key, symbol->dot_size);
+    appendValue(key, rotate_angle);
+    appendString(key, symbol->fgcolour, strlen(symbol->fgcolour));
+    appendString(key, symbol->bgcolour, strlen(symbol->bgcolour));
+    appendString(key, symbol->outfile, strlen(symbol->outfile));
+    appendString(key, symbol->primary, strlen(symbol->primary));
+    appendString(key, (const char*)symbol->text, strlen((const char*)symbol->text));
+    appendString(key, data.data(), data.size());
+
+    return key;
+  }
+
+  uint64_t hashCacheKey(const std::string &key) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+
+    for (size_t i = 0; i < key.size(); i++) {
+      hash ^= (unsigned char)key[i];
+      hash *= 0x100000001b3ULL;
+    }
+    return hash;
+  }
+}
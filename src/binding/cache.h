@@ -0,0 +1,156 @@
+#ifndef CODIFY_CACHE_H
+#define CODIFY_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include "../../.zint/backend/zint.h"
+
+namespace codify {
+  /**
+   * A base64 data URL of a cached image (malloc'd, not NUL-terminated).
+   */
+  struct CachedDataUrl {
+    char *url;
+    size_t length;
+  };
+
+  /**
+   * The final output of a rendered symbology, as held by the cache. It is shared (by reference count) between the
+   * cache and any Buffers made from its image, so evicting it never invalidates a Buffer still in use.
+   */
+  struct CachedResult {
+    uint64_t hash;
+    std::string key;
+    /** Encoded image file (owned; freed with the result), or NULL for text output */
+    unsigned char *image;
+    size_t image_length;
+    /** SVG or EPS text, if the output is text */
+    std::string encoded_data;
+    int width;
+    int height;
+    int status_code;
+    std::string message;
+    /** Data URLs of the image by MIME type (owned), built on worker threads and only ever added to */
+    std::unordered_map<std::string, CachedDataUrl> data_urls;
+
+    CachedResult() : hash(0), image(NULL), image_length(0), width(0), height(0), status_code(0) {}
+
+    ~CachedResult() {
+      free(image);
+
+      for (std::unordered_map<std::string, CachedDataUrl>::iterator it = data_urls.begin(); it != data_urls.end(); ++it) {
+        free(it->second.url);
+      }
+    }
+
+    /**
+     * Returns the data URL of the image of the given MIME type, or null if there is none yet.
+     */
+    const CachedDataUrl *getDataUrl(const std::string &mime_type) const {
+      std::unordered_map<std::string, CachedDataUrl>::const_iterator found = data_urls.find(mime_type);
+
+      return found == data_urls.end() ? NULL : &found->second;
+    }
+
+    /**
+     * Adds the data URL of the image of the given MIME type, taking ownership of it, unless there is one already
+     * (then it is freed). This changes `size()`, so a result in a cache must be given to `ResultCache::addDataUrl()`.
+     */
+    void addDataUrl(const std::string &mime_type, char *url, size_t length) {
+      CachedDataUrl data_url = { url, length };
+
+      if (!data_urls.insert(std::make_pair(mime_type, data_url)).second) {
+        free(url);
+      }
+    }
+
+    /** Number of bytes counted against the cache's budget */
+    size_t size() const {
+      size_t data_urls_size = 0;
+
+      for (std::unordered_map<std::string, CachedDataUrl>::const_iterator it = data_urls.begin(); it != data_urls.end(); ++it) {
+        data_urls_size += it->first.size() + it->second.length;
+      }
+      return sizeof(CachedResult) + key.size() + image_length + encoded_data.size() + message.size() + data_urls_size;
+    }
+  };
+
+  /**
+   * A bounded LRU cache of rendered results, keyed by a hash of everything that determines the output of a render.
+   * The cache is disabled (stores nothing) until it is given a byte budget. It is not thread-safe: it must only be
+   * used from the JS thread of the addon instance that owns it.
+   */
+  class ResultCache {
+    public:
+      ResultCache() : max_bytes(0), bytes(0), hits(0), misses(0) {}
+
+      bool enabled() const {
+        return max_bytes > 0;
+      }
+
+      /**
+       * Returns the result with the given hash and key, or null if there is none. Counts a hit or a miss.
+       */
+      std::shared_ptr<CachedResult> get(uint64_t hash, const std::string &key);
+
+      /**
+       * Adds a result, evicting the least recently used results until it fits in the budget.
+       * Results larger than the whole budget are not stored.
+       */
+      void put(const std::shared_ptr<CachedResult> &result);
+
+      /**
+       * Adds a data URL to a result (see `CachedResult::addDataUrl()`), counting it against the budget if the result
+       * is cached, which may evict results (including this one).
+       */
+      void addDataUrl(const std::shared_ptr<CachedResult> &result, const std::string &mime_type, char *url, size_t length);
+
+      /**
+       * Removes all results. Results still referenced by Buffers live on until those are garbage collected.
+       */
+      void clear();
+
+      /**
+       * Sets the byte budget, evicting results as needed to fit it. A budget of 0 disables the cache and empties it.
+       */
+      void setMaxBytes(size_t max_bytes);
+
+      size_t getMaxBytes() const { return max_bytes; }
+      size_t getBytes() const { return bytes; }
+      size_t getEntries() const { return index.size(); }
+      uint64_t getHits() const { return hits; }
+      uint64_t getMisses() const { return misses; }
+
+    private:
+      typedef std::list<std::shared_ptr<CachedResult> > ResultList;
+
+      void evict(size_t max_bytes);
+
+      size_t max_bytes;
+      size_t bytes;
+      uint64_t hits;
+      uint64_t misses;
+      /** Results in order of use, most recent first */
+      ResultList results;
+      std::unordered_map<uint64_t, ResultList::iterator> index;
+  };
+
+  /**
+   * Returns the cache key of rendering the given data with the given symbol (which must not have been encoded yet)
+   * and rotation: a serialisation of every input that determines the output.
+   */
+  std::string getCacheKey(const zint_symbol *symbol, int rotate_angle, const std::string &data);
+
+  /**
+   * Returns the 64-bit FNV-1a hash of a cache key.
+   */
+  uint64_t hashCacheKey(const std::string &key);
+}
+
+#endif
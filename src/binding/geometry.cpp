@@ -0,0 +1,94 @@
+#include <string.h>
+#include "geometry.h"
+
+namespace codify {
+  void packMatrix(const zint_symbol *symbol, PackedMatrix *packed) {
+    const int stride = (symbol->width + 7) / 8;
+
+    packed->rows = symbol->rows;
+    packed->width = symbol->width;
+    packed->stride = stride;
+    packed->height = symbol->height;
+    packed->modules.assign((size_t)symbol->rows * stride, 0);
+    packed->row_heights.assign(symbol->row_height, symbol->row_height + symbol->rows);
+
+    // rows of zero height share the rest of the symbol's height equally (as in `out_large_bar_height()`)
+    float fixed_height = 0.0f;
+    int zero_count = 0;
+
+    for (int row = 0; row < symbol->rows; row++) {
+      if (symbol->row_height[row]) {
+        fixed_height += symbol->row_height[row];
+      } else {
+        zero_count++;
+      }
+    }
+    if (zero_count) {
+      for (int row = 0; row < symbol->rows; row++) {
+        if (!symbol->row_height[row]) {
+          packed->row_heights[row] = (symbol->height - fixed_height) / zero_count;
+        }
+      }
+    }
+
+    if (symbol->symbology == BARCODE_ULTRA) {
+      // Ultracode has a colour (one byte) per module rather than a bit; the dark modules are the non-white ones
+      packed->colours.resize((size_t)symbol->rows * symbol->width);
+
+      for (int row = 0; row < symbol->rows; row++) {
+        for (int column = 0; column < symbol->width; column++) {
+          const unsigned char colour = symbol->encoded_data[row][column];
+
+          packed->colours[(size_t)row * symbol->width + column] = colour;
+
+          if (colour != 0 && colour != 8) {
+            packed->modules[(size_t)row * stride + (column >> 3)] |= 1 << (column & 7);
+          }
+        }
+      }
+      return;
+    }
+
+    // zint already stores a row as one bit per module (least significant first), so each row is a straight copy
+    for (int row = 0; row < symbol->rows; row++) {
+      memcpy(&packed->modules[(size_t)row * stride], symbol->encoded_data[row], stride);
+
+      if (symbol->width & 7) {
+        // clear any bits past the end of the row
+        packed->modules[(size_t)row * stride + stride - 1] &= (1 << (symbol->width & 7)) - 1;
+      }
+    }
+  }
+
+  void packVector(const zint_vector *vector, PackedVector *packed) {
+    packed->width = vector->width;
+    packed->height = vector->height;
+
+    for (const zint_vector_rect *rect = vector->rectangles; rect != NULL; rect = rect->next) {
+      const float values[RECT_STRIDE] = { rect->x, rect->y, rect->width, rect->height, (float)rect->colour };
+
+      packed->rectangles.insert(packed->rectangles.end(), values, values + RECT_STRIDE);
+    }
+
+    for (const zint_vector_hexagon *hexagon = vector->hexagons; hexagon != NULL; hexagon = hexagon->next) {
+      const float values[HEXAGON_STRIDE] = { hexagon->x, hexagon->y, hexagon->diameter, (float)hexagon->rotation };
+
+      packed->hexagons.insert(packed->hexagons.end(), values, values + HEXAGON_STRIDE);
+    }
+
+    for (const zint_vector_circle *circle = vector->circles; circle != NULL; circle = circle->next) {
+      const float values[CIRCLE_STRIDE] = { circle->x, circle->y, circle->diameter, circle->width, (float)circle->colour };
+
+      packed->circles.insert(packed->circles.end(), values, values + CIRCLE_STRIDE);
+    }
+
+    for (const zint_vector_string *string = vector->strings; string != NULL; string = string->next) {
+      const float values[STRING_STRIDE] = {
+        string->x, string->y, string->fsize, string->width, (float)string->rotation, (float)string->halign
+      };
+
+      packed->strings.insert(packed->strings.end(), values, values + STRING_STRIDE);
+      packed->texts.push_back(std::string((const char*)string->text, string->length));
+    }
+  }
+}
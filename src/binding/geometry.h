@@ -0,0 +1,61 @@
+#ifndef CODIFY_GEOMETRY_H
+#define CODIFY_GEOMETRY_H
+
+#include <string>
+#include <vector>
+#include "../../.zint/backend/zint.h"
+
+namespace codify {
+  /** Number of floats packed per rectangle: x, y, width, height, colour */
+  const int RECT_STRIDE = 5;
+  /** Number of floats packed per hexagon: x, y, diameter, rotation */
+  const int HEXAGON_STRIDE = 4;
+  /** Number of floats packed per circle: x, y, diameter, width, colour */
+  const int CIRCLE_STRIDE = 5;
+  /** Number of floats packed per string: x, y, font size, width, rotation, halign */
+  const int STRING_STRIDE = 6;
+
+  /**
+   * The vector geometry of a symbol (`symbol->vector`), with each of its linked lists flattened into a packed
+   * array of floats (see the strides above). The text of each string is kept separately, in the same order.
+   */
+  struct PackedVector {
+    float width;
+    float height;
+    std::vector<float> rectangles;
+    std::vector<float> hexagons;
+    std::vector<float> circles;
+    std::vector<float> strings;
+    std::vector<std::string> texts;
+  };
+
+  /**
+   * The logical module matrix of an encoded symbol (`symbol->encoded_data`), without any layout or rendering.
+   * `modules` holds one bit per module, row-major, with each row padded to `stride` bytes; module `(row, column)`
+   * is dark if bit `column & 7` (least significant first) of byte `row * stride + (column >> 3)` is set.
+   * For Ultracode, `colours` also holds the colour of each module (one byte each, `row * width + column`), where
+   * 0 is none and 1-8 are Cyan, Blue, Magenta, Red, Yellow, Green, Black and White; it is empty otherwise.
+   * `row_heights` holds the height of each row in X-dimensions, adding up to `height`.
+   */
+  struct PackedMatrix {
+    int rows;
+    int width;
+    int stride;
+    float height;
+    std::vector<unsigned char> modules;
+    std::vector<unsigned char> colours;
+    std::vector<float> row_heights;
+  };
+
+  /**
+   * Packs the module matrix and row heights of a symbol encoded by `ZBarcode_Encode()` into `*packed`.
+   */
+  void packMatrix(const zint_symbol *symbol, PackedMatrix *packed);
+
+  /**
+   * Flattens the vector geometry of a symbol buffered by `ZBarcode_Buffer_Vector()` into `*packed`.
+   */
+  void packVector(const zint_vector *vector, PackedVector *packed);
+}
+
+#endif
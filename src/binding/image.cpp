@@ -0,0 +1,386 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+#include "image.h"
+
+namespace codify {
+  static const unsigned char PNG_SIGNATURE[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+
+  /**
+   * Colours of the Ultracode modules in an intermediate bitmap, by their letter (see `ultra_colour` in raster.c).
+   */
+  static const struct {
+    unsigned char letter;
+    unsigned char rgb[3];
+  } ULTRA_COLOURS[] = {
+    { 'C', { 0x00, 0xff, 0xff } },
+    { 'B', { 0x00, 0x00, 0xff } },
+    { 'M', { 0xff, 0x00, 0xff } },
+    { 'R', { 0xff, 0x00, 0x00 } },
+    { 'Y', { 0xff, 0xff, 0x00 } },
+    { 'G', { 0x00, 0xff, 0x00 } },
+    { 'K', { 0x00, 0x00, 0x00 } },
+    { 'W', { 0xff, 0xff, 0xff } }
+  };
+
+  /**
+   * Returns the value of a single hexadecimal digit.
+   */
+  static int hexValue(char c) {
+    if (c >= '0' && c <= '9') {
+      return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+      return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+      return c - 'A' + 10;
+    }
+    return 0;
+  }
+
+  /**
+   * Converts a 6-digit (or 8-digit with alpha) hexadecimal colour to RGBA. Alpha defaults to 255.
+   */
+  static void getRgbaColor(const char *hex, unsigned char *rgba) {
+    rgba[0] = rgba[1] = rgba[2] = 0;
+    rgba[3] = 0xff;
+
+    if (strlen(hex) >= 6) {
+      rgba[0] = (unsigned char)((hexValue(hex[0]) << 4) | hexValue(hex[1]));
+      rgba[1] = (unsigned char)((hexValue(hex[2]) << 4) | hexValue(hex[3]));
+      rgba[2] = (unsigned char)((hexValue(hex[4]) << 4) | hexValue(hex[5]));
+    }
+    if (strlen(hex) >= 8) {
+      rgba[3] = (unsigned char)((hexValue(hex[6]) << 4) | hexValue(hex[7]));
+    }
+  }
+
+  /**
+   * Returns the smallest PNG bit depth (1, 2, 4 or 8) that can index the given number of colours.
+   */
+  static int getBitDepth(int colours) {
+    return colours <= 2 ? 1 : colours <= 4 ? 2 : colours <= 16 ? 4 : 8;
+  }
+
+  /**
+   * Writes one row of an intermediate bitmap as palette indices of the given bit depth, packed from the most
+   * significant bit (as in PNG). The last byte is padded with zeros.
+   */
+  static void packRow(const unsigned char *pixels, const Palette &palette, int width, int bit_depth, unsigned char *out) {
+    const int per_byte = 8 / bit_depth;
+    int x, i;
+
+    if (bit_depth == 8) {
+      for (x = 0; x < width; x++) {
+        out[x] = palette.lookup[pixels[x]];
+      }
+      return;
+    }
+
+    for (x = 0; x < width; out++) {
+      unsigned char byte = 0;
+
+      for (i = 0; i < per_byte; i++, x++) {
+        byte = (unsigned char)(byte << bit_depth);
+
+        if (x < width) {
+          byte |= palette.lookup[pixels[x]];
+        }
+      }
+      *out = byte;
+    }
+  }
+
+  /**
+   * Writes one row of RGBA pixels from a row of the RGB bitmap and of the alphamap (if any; opaque otherwise).
+   */
+  static void mergeRgbaRow(const unsigned char *rgb, const unsigned char *alpha, unsigned char *out, int width) {
+    int x;
+
+    if (alpha == NULL) {
+      for (x = 0; x < width; x++, rgb += 3, out += 4) {
+        out[0] = rgb[0];
+        out[1] = rgb[1];
+        out[2] = rgb[2];
+        out[3] = 0xff;
+      }
+    } else {
+      for (x = 0; x < width; x++, rgb += 3, out += 4) {
+        out[0] = rgb[0];
+        out[1] = rgb[1];
+        out[2] = rgb[2];
+        out[3] = alpha[x];
+      }
+    }
+  }
+
+  /**
+   * Writes a 32-bit unsigned integer in network (big-endian) byte order.
+   */
+  static void writeUint32(unsigned char *p, uint32_t value) {
+    p[0] = (unsigned char)(value >> 24);
+    p[1] = (unsigned char)(value >> 16);
+    p[2] = (unsigned char)(value >> 8);
+    p[3] = (unsigned char)value;
+  }
+
+  /**
+   * Completes the chunk at `p` whose `length` bytes of data are already in place,
+   * by writing its length, type and CRC. Returns the position following the chunk.
+   */
+  static unsigned char *writeChunk(unsigned char *p, const char *type, uint32_t length) {
+    writeUint32(p, length);
+    memcpy(p + 4, type, 4);
+    writeUint32(p + 8 + length, (uint32_t)crc32(crc32(0L, Z_NULL, 0), p + 4, length + 4));
+
+    return p + 12 + length;
+  }
+
+  /**
+   * Applies the `Up` filter to all rows of the PNG scanlines after the first, so that repeated rows deflate to nothing.
+   * Each row of `raw` is `row_length` bytes, starting with its filter type byte.
+   */
+  static void filterRows(unsigned char *raw, size_t row_length, int height) {
+    size_t i;
+    int y;
+
+    raw[0] = 0;
+
+    for (y = height - 1; y > 0; y--) {
+      unsigned char *row = raw + row_length * y;
+      const unsigned char *prev = row - row_length;
+
+      row[0] = 2;
+
+      for (i = 1; i < row_length; i++) {
+        row[i] -= prev[i];
+      }
+    }
+  }
+
+  /**
+   * Writes a PNG file with the given filtered scanlines, which are freed. `palette` is only given for indexed images.
+   */
+  static int writePngFile(zint_symbol *symbol, unsigned char *raw, size_t raw_length, int bit_depth, int colour_type,
+      const Palette *palette, unsigned char **png, size_t *png_length) {
+    const int palette_size = palette != NULL ? palette->size : 0;
+    int transparent = 0;
+    uLongf idat_length = compressBound((uLong)raw_length);
+    unsigned char *out, *p;
+    int i;
+
+    // only the colours up to the last translucent one need a tRNS entry
+    for (i = 0; i < palette_size; i++) {
+      if (palette->colours[i][3] != 0xff) {
+        transparent = i + 1;
+      }
+    }
+
+    // signature + IHDR chunk + PLTE and tRNS chunks + IDAT chunk header and CRC + IEND chunk
+    out = (unsigned char *)malloc(8 + 25 + 12 + palette_size * 3 + 12 + transparent + 12 + idat_length + 12);
+    if (out == NULL) {
+      free(raw);
+      strcpy(symbol->errtxt, "Insufficient memory for PNG buffer");
+      return ZINT_ERROR_MEMORY;
+    }
+
+    memcpy(out, PNG_SIGNATURE, 8);
+    p = out + 8;
+
+    writeUint32(p + 8, (uint32_t)symbol->bitmap_width);
+    writeUint32(p + 12, (uint32_t)symbol->bitmap_height);
+    p[16] = (unsigned char)bit_depth;
+    p[17] = (unsigned char)colour_type;
+    p[18] = 0; // compression method
+    p[19] = 0; // filter method
+    p[20] = 0; // interlace method
+    p = writeChunk(p, "IHDR", 13);
+
+    if (palette_size > 0) {
+      for (i = 0; i < palette_size; i++) {
+        memcpy(p + 8 + i * 3, palette->colours[i], 3);
+      }
+      p = writeChunk(p, "PLTE", (uint32_t)palette_size * 3);
+    }
+    if (transparent > 0) {
+      for (i = 0; i < transparent; i++) {
+        p[8 + i] = palette->colours[i][3];
+      }
+      p = writeChunk(p, "tRNS", (uint32_t)transparent);
+    }
+
+    if (compress2(p + 8, &idat_length, raw, (uLong)raw_length, Z_DEFAULT_COMPRESSION) != Z_OK) {
+      free(raw);
+      free(out);
+      strcpy(symbol->errtxt, "Failed to deflate PNG image data");
+      return ZINT_ERROR_MEMORY;
+    }
+    free(raw);
+
+    p = writeChunk(p, "IDAT", (uint32_t)idat_length);
+    p = writeChunk(p, "IEND", 0);
+
+    *png = out;
+    *png_length = (size_t)(p - out);
+
+    return 0;
+  }
+
+  int getPalette(zint_symbol *symbol, Palette *palette) {
+    const size_t pixels = (size_t)symbol->bitmap_width * symbol->bitmap_height;
+    unsigned char bg[4], fg[4];
+    unsigned char plotted[256];
+    size_t i;
+    int c;
+
+    if (symbol->bitmap == NULL || (symbol->output_options & OUT_BUFFER_INTERMEDIATE) == 0) {
+      strcpy(symbol->errtxt, "No intermediate bitmap available to index");
+      return ZINT_ERROR_INVALID_DATA;
+    }
+
+    getRgbaColor(symbol->bgcolour, bg);
+    getRgbaColor(symbol->fgcolour, fg);
+
+    // paper and ink are always the first two colours, so that a two-colour symbology is indexed by 0 and 1
+    memset(palette->lookup, 1, sizeof(palette->lookup));
+    palette->lookup['0'] = 0;
+    memcpy(palette->colours[0], bg, 4);
+    memcpy(palette->colours[1], fg, 4);
+    palette->size = 2;
+
+    if (symbol->symbology != BARCODE_ULTRA) {
+      // only Ultracode plots anything other than ink and paper
+      return 0;
+    }
+
+    memset(plotted, 0, sizeof(plotted));
+    for (i = 0; i < pixels; i++) {
+      plotted[symbol->bitmap[i]] = 1;
+    }
+
+    for (c = 0; c < (int)(sizeof(ULTRA_COLOURS) / sizeof(ULTRA_COLOURS[0])); c++) {
+      const unsigned char letter = ULTRA_COLOURS[c].letter;
+
+      if (plotted[letter]) {
+        palette->lookup[letter] = (unsigned char)palette->size;
+        memcpy(palette->colours[palette->size], ULTRA_COLOURS[c].rgb, 3);
+        palette->colours[palette->size][3] = fg[3];
+        palette->size++;
+      }
+    }
+
+    return 0;
+  }
+
+  int writePng(zint_symbol *symbol, unsigned char **png, size_t *png_length) {
+    const int width = symbol->bitmap_width;
+    const int height = symbol->bitmap_height;
+    const bool indexed = (symbol->output_options & OUT_BUFFER_INTERMEDIATE) != 0;
+    Palette palette;
+    int bit_depth = 8;
+    size_t row_length, raw_length;
+    unsigned char *raw;
+    int y;
+
+    if (symbol->bitmap == NULL || width <= 0 || height <= 0) {
+      strcpy(symbol->errtxt, "No bitmap available to write PNG");
+      return ZINT_ERROR_INVALID_DATA;
+    }
+
+    if (indexed) {
+      int error_number = getPalette(symbol, &palette);
+
+      if (error_number != 0) {
+        return error_number;
+      }
+      bit_depth = getBitDepth(palette.size);
+      row_length = ((size_t)width * bit_depth + 7) / 8 + 1;
+    } else {
+      row_length = (size_t)width * 4 + 1;
+    }
+    raw_length = row_length * height;
+
+    raw = (unsigned char *)malloc(raw_length);
+    if (raw == NULL) {
+      strcpy(symbol->errtxt, "Insufficient memory for PNG scanlines");
+      return ZINT_ERROR_MEMORY;
+    }
+
+    // write the palette indices (of a two-colour symbology, as a 1-bit image) or RGBA pixels of each scanline
+    for (y = 0; y < height; y++) {
+      const size_t offset = (size_t)width * y;
+      unsigned char *row = raw + row_length * y + 1;
+
+      if (indexed) {
+        packRow(symbol->bitmap + offset, palette, width, bit_depth, row);
+      } else {
+        mergeRgbaRow(symbol->bitmap + offset * 3, symbol->alphamap ? symbol->alphamap + offset : NULL, row, width);
+      }
+    }
+    filterRows(raw, row_length, height);
+
+    return indexed
+      ? writePngFile(symbol, raw, raw_length, bit_depth, 3, &palette, png, png_length)
+      : writePngFile(symbol, raw, raw_length, 8, 6, NULL, png, png_length);
+  }
+
+  int writeRgba(zint_symbol *symbol, unsigned char **rgba, size_t *rgba_length) {
+    const int width = symbol->bitmap_width;
+    const int height = symbol->bitmap_height;
+    const size_t pixels = (size_t)width * height;
+    unsigned char *out;
+
+    if (symbol->bitmap == NULL || width <= 0 || height <= 0) {
+      strcpy(symbol->errtxt, "No bitmap available to write RGBA pixels");
+      return ZINT_ERROR_INVALID_DATA;
+    }
+
+    out = (unsigned char *)malloc(pixels * 4);
+    if (out == NULL) {
+      strcpy(symbol->errtxt, "Insufficient memory for RGBA buffer");
+      return ZINT_ERROR_MEMORY;
+    }
+
+    // the rows are contiguous, so the whole bitmap is merged as a single row
+    mergeRgbaRow(symbol->bitmap, symbol->alphamap, out, (int)pixels);
+
+    *rgba = out;
+    *rgba_length = pixels * 4;
+
+    return 0;
+  }
+
+  int writeIndexed(zint_symbol *symbol, const Palette &palette, int bit_depth, unsigned char **pixels, size_t *pixels_length) {
+    const int width = symbol->bitmap_width;
+    const int height = symbol->bitmap_height;
+    const size_t stride = ((size_t)width * bit_depth + 7) / 8;
+    unsigned char *out;
+    int y;
+
+    if (symbol->bitmap == NULL || width <= 0 || height <= 0) {
+      strcpy(symbol->errtxt, "No bitmap available to write indexed pixels");
+      return ZINT_ERROR_INVALID_DATA;
+    }
+    if (palette.size > (1 << bit_depth)) {
+      strcpy(symbol->errtxt, "Too many colours for the bit depth of indexed pixels");
+      return ZINT_ERROR_INVALID_OPTION;
+    }
+
+    out = (unsigned char *)malloc(stride * height);
+    if (out == NULL) {
+      strcpy(symbol->errtxt, "Insufficient memory for indexed pixels");
+      return ZINT_ERROR_MEMORY;
+    }
+
+    for (y = 0; y < height; y++) {
+      packRow(symbol->bitmap + (size_t)width * y, palette, width, bit_depth, out + stride * y);
+    }
+
+    *pixels = out;
+    *pixels_length = stride * height;
+
+    return 0;
+  }
+}
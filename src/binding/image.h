@@ -0,0 +1,59 @@
+#ifndef CODIFY_IMAGE_H
+#define CODIFY_IMAGE_H
+
+#include <stddef.h>
+#include "../../.zint/backend/zint.h"
+
+namespace codify {
+  /**
+   * The colours of a symbology buffered as an intermediate bitmap (`OUT_BUFFER_INTERMEDIATE`), which holds one byte
+   * per pixel: '0' for paper, '1' for ink, or the letter of an Ultracode colour.
+   */
+  struct Palette {
+    /** Number of colours; the background (paper) is always 0 and the foreground (ink) 1 */
+    int size;
+    /** RGBA value of each colour */
+    unsigned char colours[16][4];
+    /** Colour index of each byte value of the intermediate bitmap (any unknown value is the foreground) */
+    unsigned char lookup[256];
+  };
+
+  /**
+   * Gets the palette of a symbology buffered as an intermediate bitmap.
+   * Returns 0 on success, or a zint error code (with `symbol->errtxt` set) if the symbol has no intermediate bitmap.
+   */
+  int getPalette(zint_symbol *symbol, Palette *palette);
+
+  /**
+   * Encodes the bitmap of a buffered symbol as a PNG image.
+   * An intermediate bitmap is written as an indexed PNG of the smallest bit depth that fits its palette (1-bit for a
+   * two-colour symbology), with a tRNS chunk if any colour has an alpha channel.
+   * An RGB bitmap is written as an 8-bit RGBA PNG, with the alpha of each pixel taken from the symbol's alphamap,
+   * which zint only buffers if either colour has an alpha channel; otherwise each pixel is opaque.
+   *
+   * On success, `*png` points to a malloc'd block of `*png_length` bytes owned by the caller.
+   * Returns 0 on success, or a zint error code (with `symbol->errtxt` set) on failure.
+   */
+  int writePng(zint_symbol *symbol, unsigned char **png, size_t *png_length);
+
+  /**
+   * Merges the RGB bitmap and alphamap of a buffered symbol into 8-bit RGBA pixels (4 bytes per pixel, rows top to
+   * bottom), in a single pass.
+   *
+   * On success, `*rgba` points to a malloc'd block of `*rgba_length` bytes owned by the caller.
+   * Returns 0 on success, or a zint error code (with `symbol->errtxt` set) on failure.
+   */
+  int writeRgba(zint_symbol *symbol, unsigned char **rgba, size_t *rgba_length);
+
+  /**
+   * Writes the palette indices of an intermediate bitmap at the given bit depth (1 or 8), packed from the most
+   * significant bit, with each row padded to a whole byte.
+   *
+   * On success, `*pixels` points to a malloc'd block of `*pixels_length` bytes owned by the caller.
+   * Returns 0 on success, or a zint error code (with `symbol->errtxt` set) on failure, e.g. if the palette has more
+   * colours than the bit depth can index.
+   */
+  int writeIndexed(zint_symbol *symbol, const Palette &palette, int bit_depth, unsigned char **pixels, size_t *pixels_length);
+}
+
+#endif
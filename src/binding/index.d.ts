@@ -1,3 +1,33 @@
 import BinResult from "../types/BinResult";
+import CacheStats from "../types/CacheStats";
+import RenderStats from "../types/RenderStats";
+import SymbologyVector from "../types/SymbologyVector";
 
-export declare const createStream: (data: string, ...config: any[]) => BinResult;
+export declare const createStream: (data: string, ...config: any[]) => BinResult | undefined;
+
+export declare const createStreams: (data: string[], ...config: any[]) => void;
+
+export declare const createRenders: (data: string, ...configAndSpecs: any[]) => void;
+
+export declare const createVector: (data: string, ...config: any[]) => void;
+
+export declare const createRaster: (data: string, ...configAndMode: any[]) => void;
+
+export declare const encode: (data: string, ...config: any[]) => void;
+
+export declare class Encoder {
+  constructor (...config: any[]);
+  encode (data: string, callback: (result: BinResult) => void, mimeType?: string): BinResult | undefined;
+}
+
+export declare const configureCache: (maxBytes: number) => void;
+
+export declare const clearCache: () => void;
+
+export declare const getCacheStats: () => CacheStats;
+
+export declare const configureStats: (enabled: boolean) => void;
+
+export declare const clearStats: () => void;
+
+export declare const getStats: () => RenderStats;
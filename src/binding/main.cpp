@@ -1,5 +1,9 @@
 #include <v8.h>
+#include <algorithm>
+#include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 #include <iostream>
 #include <node.h>
 #include <node_buffer.h>
@@ -9,6 +13,11 @@
 #include <stdlib.h>
 #include <nan.h>
 #include "../../.zint/backend/zint.h"
+#include "base64.h"
+#include "cache.h"
+#include "geometry.h"
+#include "image.h"
+#include "stats.h"
 
 namespace codify {
   using v8::FunctionCallbackInfo;
@@ -20,57 +29,97 @@ namespace codify {
   using v8::Value;
 
   /**
-   * Returns a bitmap (of type V8 Array) of the image in memory.
+   * Returns the RGB bitmap of the image in memory as a Buffer.
+   * The Buffer takes ownership of `symbol->bitmap`, so the pixel data is never copied.
    */
-  Local<Object> getBitmap(Isolate* isolate, zint_symbol *symbol) {
-    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  Local<Object> getBitmap(zint_symbol *symbol) {
+    uint32_t matrix_size = symbol->bitmap_width * symbol->bitmap_height * 3;
+
+    if (symbol->bitmap == NULL) {
+      return Nan::NewBuffer(0).ToLocalChecked();
+    }
+
+    Local<Object> buffer = Nan::NewBuffer((char*)symbol->bitmap, matrix_size).ToLocalChecked();
 
-    int matrix_size = symbol->bitmap_width * symbol->bitmap_height * 3;
-    int i;
+    // the buffer frees the bitmap once it is garbage collected
+    symbol->bitmap = NULL;
 
-    Local<v8::Array> outArr = v8::Array::New(isolate, matrix_size);
+    return buffer;
+  }
+
+  /**
+   * Returns the three-character extension of the symbol's `outfile`, or an empty string if it has none.
+   */
+  const char *getFileExtension(zint_symbol *symbol) {
+    int fileNameLength = strlen(symbol->outfile);
 
-    for (i = 0; i < matrix_size; i++) {
-      (void)outArr->Set(context, i, v8::Integer::NewFromUnsigned(isolate, symbol->bitmap[i]));
+    // check if the file at least is 4 chars long so we can parse the last three and check it as an extension
+    if(fileNameLength > 4) {
+      return &symbol->outfile[fileNameLength - 3];
     }
-    return outArr;
+    return "";
   }
 
   /**
-   * Renders symbology and returns an object with PNG bitmap data, EPS, or SVG XML.
+   * Buffers a PNG as an intermediate bitmap (one byte per pixel), so that it is written as an indexed PNG and its
+   * pixels are never expanded to RGB (see `writePng()`).
    */
-  Local<Object> createStreamHandle(Isolate* isolate, zint_symbol *symbol, uint8_t *data, char *str, int rotate_angle) {
-    int status_code;
+  void setBufferMode(zint_symbol *symbol) {
+    if (strcmp("png", getFileExtension(symbol)) == 0) {
+      symbol->output_options |= OUT_BUFFER_INTERMEDIATE;
+    }
+  }
 
-    if ((symbol->output_options & BARCODE_STDOUT) != 0) {
-      status_code = ZBarcode_Encode_and_Print(symbol, data, 0, rotate_angle);
-    } else {
-      status_code = ZBarcode_Encode_and_Buffer(symbol, data, 0, rotate_angle);
+  /**
+   * Encodes the symbology and renders it to a bitmap buffer (or to `memfile`, if `BARCODE_MEMORY_FILE` is set).
+   * This does not touch any V8 state, so it is safe to call from a libuv worker thread.
+   */
+  int encodeSymbol(zint_symbol *symbol, uint8_t *data, int rotate_angle) {
+    if ((symbol->output_options & BARCODE_MEMORY_FILE) != 0) {
+      return ZBarcode_Encode_and_Print(symbol, data, 0, rotate_angle);
     }
+    setBufferMode(symbol);
+
+    return ZBarcode_Encode_and_Buffer(symbol, data, 0, rotate_angle);
+  }
 
+  /**
+   * Returns an object with the image file (PNG, GIF, TIF, BMP, PCX or EMF), bitmap data, EPS, or SVG XML of the
+   * rendered symbology.
+   * If `image` is given, ownership of it is transferred to the returned object.
+   */
+  Local<Object> createStreamHandle(Isolate* isolate, zint_symbol *symbol, int status_code, unsigned char *image, size_t image_length) {
     v8::Local<v8::Object> obj = Object::New(isolate);
 
     if(status_code <= 2) {
       // the barcode creation was successful; parse the result
-      int fileNameLength = strlen(symbol->outfile);
+      const char *fileExt = getFileExtension(symbol);
 
-      // assign `encodedData` and `bitmap` to be initially empty (required by BinResult)
+      // assign `encodedData`, `bitmap` and `image` to be initially empty (required by BinResult)
       Nan::Set(obj, Nan::New<String>("encodedData").ToLocalChecked(), Nan::New<String>("").ToLocalChecked());
-      Nan::Set(obj, Nan::New<String>("bitmap").ToLocalChecked(), v8::Array::New(isolate, 0));
+      Nan::Set(obj, Nan::New<String>("bitmap").ToLocalChecked(), Nan::NewBuffer(0).ToLocalChecked());
+      Nan::Set(obj, Nan::New<String>("image").ToLocalChecked(), Nan::NewBuffer(0).ToLocalChecked());
 
-      if(fileNameLength > 4) {
-        // check if the file at least is 4 chars long so we can parse the last three and check it as an extension
-        const char *fileExt = &symbol->outfile[fileNameLength - 3];
+      if(image != NULL) {
+        // hand the encoded image file over to a Buffer and store it in `image`
+        Nan::Set(obj, Nan::New<String>("image").ToLocalChecked(), Nan::NewBuffer((char*)image, (uint32_t)image_length).ToLocalChecked());
 
-        if(strcmp("bmp", fileExt) == 0) {
-          // parse the buffer as a bitmap array and store it in `bitmap`
-          Nan::Set(obj, Nan::New<String>("bitmap").ToLocalChecked(), getBitmap(isolate, symbol));
-
-        } else if(strcmp("svg", fileExt) == 0 || strcmp("eps", fileExt) == 0) {
-          // pass the rendered_data (stdout) to `encodedData`
-          Nan::Set(obj, Nan::New<String>("encodedData").ToLocalChecked(), Nan::New<String>(symbol->rendered_data).ToLocalChecked());
+      } else if(symbol->memfile != NULL) {
+        if(strcmp("svg", fileExt) == 0 || strcmp("eps", fileExt) == 0) {
+          // pass the text file rendered in memory to `encodedData`
+          Nan::Set(obj, Nan::New<String>("encodedData").ToLocalChecked(), Nan::New<String>((char*)symbol->memfile, symbol->memfile_size).ToLocalChecked());
+        } else {
+          // hand any other file rendered in memory (GIF, TIF, BMP, PCX, EMF) over to a Buffer and store it in `image`
+          Nan::Set(obj, Nan::New<String>("image").ToLocalChecked(), Nan::NewBuffer((char*)symbol->memfile, (uint32_t)symbol->memfile_size).ToLocalChecked());
 
+          // the buffer frees the file once it is garbage collected
+          symbol->memfile = NULL;
+          symbol->memfile_size = 0;
         }
+
+      } else if(strcmp("bmp", fileExt) == 0) {
+        // hand the bitmap over to a Buffer and store it in `bitmap`
+        Nan::Set(obj, Nan::New<String>("bitmap").ToLocalChecked(), getBitmap(symbol));
       }
 
       // set the buffered bitmap dimensions
@@ -85,30 +134,462 @@ namespace codify {
     return obj;
   }
 
+  /**
+   * If rendering a PNG, encodes the bitmap of the rendered symbology as a PNG file into `*image`.
+   * Returns the given status code, or the error code of encoding the PNG.
+   * If `timings` is given, the duration of encoding the PNG is stored in it.
+   */
+  int writeImage(zint_symbol *symbol, int status_code, unsigned char **image, size_t *image_length, Timings *timings) {
+    if (status_code <= 2 && strcmp("png", getFileExtension(symbol)) == 0) {
+      double start = timings != NULL ? monotonicMs() : 0.0;
+
+      // encode the bitmap as a PNG file here, so that no pixels need to be processed on the JS thread
+      int error_number = writePng(symbol, image, image_length);
+
+      if (timings != NULL) {
+        timings->ms[PHASE_IMAGE] = monotonicMs() - start;
+      }
+
+      if (error_number != 0) {
+        status_code = error_number;
+      } else {
+        // the bitmap is no longer needed, so don't hold on to it until the result is handled
+        free(symbol->bitmap);
+        symbol->bitmap = NULL;
+      }
+    }
+    return status_code;
+  }
+
+  /**
+   * Encodes and renders the symbology, and if rendering a PNG, encodes the bitmap as a PNG file into `*image`.
+   * Returns the status code. Like `encodeSymbol()`, this is safe to call from any thread.
+   * If `timings` is given, the durations of the phases of the render are stored in it.
+   */
+  int renderSymbol(zint_symbol *symbol, const std::string &data, int rotate_angle, unsigned char **image, size_t *image_length,
+      Timings *timings = NULL) {
+    if (timings != NULL) {
+      symbol->output_options |= BARCODE_TIMINGS;
+    }
+
+    int status_code = encodeSymbol(symbol, (uint8_t*)data.c_str(), rotate_angle);
+
+    if (timings != NULL) {
+      timings->setZintTimings(symbol);
+
+      if (status_code >= ZINT_ERROR) {
+        // nothing is plotted if the encode fails
+        timings->ms[PHASE_PLOT] = timings->ms[PHASE_OUTPUT] = -1.0;
+      }
+    }
+    return writeImage(symbol, status_code, image, image_length, timings);
+  }
+
+  /**
+   * Renders a symbology which has already been encoded (see `renderSymbol()`). `encode_status` is the status code of
+   * encoding it, which is returned if the render itself succeeds without a warning (as `ZBarcode_Encode_and_Print()`
+   * does). Safe to call from any thread.
+   * If `timings` is given, the durations of the phases of the render (and of the encode) are stored in it.
+   */
+  int renderEncodedSymbol(zint_symbol *symbol, int encode_status, int rotate_angle, unsigned char **image, size_t *image_length,
+      Timings *timings = NULL) {
+    int status_code;
+
+    if (timings != NULL) {
+      symbol->output_options |= BARCODE_TIMINGS;
+    }
+
+    if ((symbol->output_options & BARCODE_MEMORY_FILE) != 0) {
+      status_code = ZBarcode_Print(symbol, rotate_angle);
+    } else {
+      setBufferMode(symbol);
+      status_code = ZBarcode_Buffer(symbol, rotate_angle);
+    }
+
+    if (status_code == 0) {
+      status_code = encode_status;
+    }
+    if (timings != NULL) {
+      timings->setZintTimings(symbol);
+    }
+    return writeImage(symbol, status_code, image, image_length, timings);
+  }
+
+  /**
+   * A data URL handed over to V8 as an external string, so that it is never copied: either a malloc'd one, which is
+   * freed when the string is garbage collected, or one of a cached result, which the string keeps alive.
+   */
+  class ExternalDataUrl : public v8::String::ExternalOneByteStringResource {
+    public:
+      ExternalDataUrl(char *url, size_t url_length) : url(url), url_length(url_length) {}
+
+      ExternalDataUrl(const std::shared_ptr<CachedResult> &result, const CachedDataUrl *data_url)
+        : url(data_url->url), url_length(data_url->length), result(result) {}
+
+      ~ExternalDataUrl() {
+        if (!result) {
+          free(url);
+        }
+      }
+
+      const char *data() const {
+        return url;
+      }
+
+      size_t length() const {
+        return url_length;
+      }
+
+    private:
+      char *url;
+      size_t url_length;
+      std::shared_ptr<CachedResult> result;
+  };
+
+  /**
+   * Sets `dataUrl` of a result object to the given data URL, taking ownership of it.
+   */
+  void setDataUrl(Isolate *isolate, v8::Local<v8::Object> obj, ExternalDataUrl *resource) {
+    v8::MaybeLocal<v8::String> str = v8::String::NewExternalOneByte(isolate, resource);
+
+    if (str.IsEmpty()) {
+      // V8 does not take ownership if it fails (e.g. if the string is too long)
+      delete resource;
+      return;
+    }
+
+    Nan::Set(obj, Nan::New<String>("dataUrl").ToLocalChecked(), str.ToLocalChecked());
+  }
+
+  /**
+   * Sets `dataUrl` of a result object to the data URL of the given MIME type of a cached result, if it has one.
+   */
+  void setCachedDataUrl(Isolate *isolate, v8::Local<v8::Object> obj, const std::shared_ptr<CachedResult> &result,
+      const std::string &mime_type) {
+    const CachedDataUrl *data_url = result->getDataUrl(mime_type);
+
+    if (data_url != NULL) {
+      setDataUrl(isolate, obj, new ExternalDataUrl(result, data_url));
+    }
+  }
+
+  /**
+   * Sets `timings` of a result object to the durations of the phases of its render which ran, in milliseconds.
+   */
+  void setTimings(v8::Local<v8::Object> obj, const Timings &timings) {
+    v8::Local<v8::Object> phases = Nan::New<v8::Object>();
+
+    for (int i = 0; i < PHASE_COUNT; i++) {
+      if (timings.ms[i] >= 0) {
+        Nan::Set(phases, Nan::New<String>(PHASE_NAMES[i]).ToLocalChecked(), Nan::New<v8::Number>(timings.ms[i]));
+      }
+    }
+
+    Nan::Set(obj, Nan::New<String>("timings").ToLocalChecked(), phases);
+  }
+
+  /**
+   * Returns the result of a successful render as a result to cache, taking ownership of its image file (the given
+   * `image`, or any binary file rendered in memory). Returns null if the result can't be cached: if the render failed,
+   * or if it has no file (i.e., the raw bitmap was rendered).
+   */
+  std::shared_ptr<CachedResult> createCachedResult(zint_symbol *symbol, int status_code, unsigned char *image, size_t image_length) {
+    const char *fileExt = getFileExtension(symbol);
+
+    if (status_code > 2 || (image == NULL && symbol->memfile == NULL)) {
+      return std::shared_ptr<CachedResult>();
+    }
+
+    std::shared_ptr<CachedResult> result = std::make_shared<CachedResult>();
+
+    if (image != NULL) {
+      result->image = image;
+      result->image_length = image_length;
+    } else if (strcmp("svg", fileExt) == 0 || strcmp("eps", fileExt) == 0) {
+      result->encoded_data.assign((const char*)symbol->memfile, symbol->memfile_size);
+    } else {
+      result->image = symbol->memfile;
+      result->image_length = symbol->memfile_size;
+      symbol->memfile = NULL;
+      symbol->memfile_size = 0;
+    }
+
+    result->width = symbol->bitmap_width;
+    result->height = symbol->bitmap_height;
+    result->status_code = status_code;
+    result->message = symbol->errtxt;
+
+    return result;
+  }
+
+  /**
+   * Buffer free callback which releases a Buffer's reference to the cached result holding its data.
+   */
+  void releaseCachedResult(char *data, void *hint) {
+    delete (std::shared_ptr<CachedResult>*)hint;
+  }
+
+  /**
+   * Returns the same object as `createStreamHandle()` for a cached result. The `image` Buffer is backed by the cached
+   * result's image, which it keeps alive, so results are never copied; it must be treated as read-only.
+   */
+  Local<Object> createCachedHandle(Isolate* isolate, const std::shared_ptr<CachedResult> &result) {
+    v8::Local<v8::Object> obj = Object::New(isolate);
+    v8::Local<v8::Object> image = result->image == NULL
+      ? Nan::NewBuffer(0).ToLocalChecked()
+      : Nan::NewBuffer((char*)result->image, (uint32_t)result->image_length, releaseCachedResult, new std::shared_ptr<CachedResult>(result)).ToLocalChecked();
+
+    Nan::Set(obj, Nan::New<String>("encodedData").ToLocalChecked(), Nan::New<String>(result->encoded_data).ToLocalChecked());
+    Nan::Set(obj, Nan::New<String>("bitmap").ToLocalChecked(), Nan::NewBuffer(0).ToLocalChecked());
+    Nan::Set(obj, Nan::New<String>("image").ToLocalChecked(), image);
+    Nan::Set(obj, Nan::New<String>("width").ToLocalChecked(), v8::Integer::New(isolate, result->width));
+    Nan::Set(obj, Nan::New<String>("height").ToLocalChecked(), v8::Integer::New(isolate, result->height));
+    Nan::Set(obj, Nan::New<String>("message").ToLocalChecked(), Nan::New<String>(result->message).ToLocalChecked());
+    Nan::Set(obj, Nan::New<String>("code").ToLocalChecked(), v8::Integer::New(isolate, result->status_code));
+
+    return obj;
+  }
+
+  /**
+   * Encodes and renders a symbology on the libuv thread pool.
+   * The symbol and data are owned by the worker, so nothing is shared with the JS thread while it runs.
+   */
+  class StreamWorker : public Nan::AsyncWorker {
+    public:
+      StreamWorker(Nan::Callback *callback, zint_symbol *symbol, const char *data, int rotate_angle)
+        : Nan::AsyncWorker(callback, "codify:createStream"), symbol(symbol), data(data), rotate_angle(rotate_angle),
+          status_code(0), image(NULL), image_length(0), cache_hash(0), data_url(NULL), data_url_length(0), queued_at(0.0) {}
+
+      ~StreamWorker() {
+        ZBarcode_Delete(symbol);
+        free(image);
+        free(data_url);
+      }
+
+      /**
+       * Also encodes the rendered image file (if it is not text) as a base64 data URL of the given MIME type, on the
+       * worker thread, and passes it as `dataUrl` instead of passing the file as `image`.
+       */
+      void setDataUrlType(const std::string &mime_type) {
+        this->mime_type = mime_type;
+      }
+
+      /**
+       * Stores the result in the given cache, under the given key, once it is rendered.
+       */
+      void setCache(const std::shared_ptr<ResultCache> &cache, const std::string &key, uint64_t hash) {
+        this->cache = cache;
+        this->cache_key = key;
+        this->cache_hash = hash;
+      }
+
+      /**
+       * Times the phases of the render from now on, and adds them to the given stats once it is rendered.
+       */
+      void setStats(const std::shared_ptr<Stats> &stats) {
+        this->stats = stats;
+        this->queued_at = monotonicMs();
+      }
+
+      void Execute() {
+        Timings *timed = stats ? &timings : NULL;
+
+        if (timed != NULL) {
+          timings.ms[PHASE_QUEUE] = monotonicMs() - queued_at;
+        }
+
+        status_code = renderSymbol(symbol, data, rotate_angle, &image, &image_length, timed);
+
+        if (status_code <= 2 && !mime_type.empty()) {
+          double start = timed != NULL ? monotonicMs() : 0.0;
+
+          writeDataUrl();
+
+          if (timed != NULL && data_url != NULL) {
+            timings.ms[PHASE_DATA_URL] = monotonicMs() - start;
+          }
+        }
+
+        if (timed != NULL) {
+          timings.ms[PHASE_TOTAL] = monotonicMs() - queued_at;
+        }
+      }
+
+      void HandleOKCallback() {
+        Nan::HandleScope scope;
+        Isolate *isolate = v8::Isolate::GetCurrent();
+        std::shared_ptr<CachedResult> result;
+
+        // the cache may have been disabled since the render was queued
+        if (cache && cache->enabled()) {
+          result = createCachedResult(symbol, status_code, image, image_length);
+        }
+
+        if (result) {
+          // the cached result now owns the image
+          image = NULL;
+
+          result->hash = cache_hash;
+          result->key = cache_key;
+
+          // and the data URL, so that hits don't build it again
+          if (data_url != NULL) {
+            result->addDataUrl(mime_type, data_url, data_url_length);
+            data_url = NULL;
+          }
+
+          cache->put(result);
+        }
+
+        v8::Local<v8::Object> obj = result
+          ? createCachedHandle(isolate, result)
+          : createStreamHandle(isolate, symbol, status_code, image, image_length);
+
+        // the result now owns the image
+        image = NULL;
+
+        if (result) {
+          setCachedDataUrl(isolate, obj, result, mime_type);
+        } else if (data_url != NULL) {
+          setDataUrl(isolate, obj, new ExternalDataUrl(data_url, data_url_length));
+          data_url = NULL;
+        }
+
+        if (stats) {
+          setTimings(obj, timings);
+
+          // stats may have been disabled since the render was queued
+          if (stats->enabled()) {
+            stats->record(timings, status_code);
+          }
+        }
+
+        v8::Local<v8::Value> argv[] = { obj };
+
+        callback->Call(1, argv, async_resource);
+      }
+
+    private:
+      /**
+       * Writes the data URL of the rendered image file, which is either the PNG in `image` or a binary file rendered
+       * in memory. The file itself is then freed, unless it is to be cached.
+       */
+      void writeDataUrl() {
+        const char *fileExt = getFileExtension(symbol);
+        bool is_memfile = image == NULL && symbol->memfile != NULL
+          && strcmp("svg", fileExt) != 0 && strcmp("eps", fileExt) != 0;
+
+        if (image == NULL && !is_memfile) {
+          return;
+        }
+
+        data_url = is_memfile
+          ? createDataUrl(mime_type.c_str(), symbol->memfile, symbol->memfile_size, &data_url_length)
+          : createDataUrl(mime_type.c_str(), image, image_length, &data_url_length);
+
+        if (data_url == NULL || cache) {
+          // keep the file to fall back on if out of memory, or to cache it
+          return;
+        }
+
+        if (is_memfile) {
+          free(symbol->memfile);
+          symbol->memfile = NULL;
+          symbol->memfile_size = 0;
+        } else {
+          free(image);
+          image = NULL;
+          image_length = 0;
+        }
+      }
+
+      zint_symbol *symbol;
+      std::string data;
+      int rotate_angle;
+      int status_code;
+      unsigned char *image;
+      size_t image_length;
+      std::shared_ptr<ResultCache> cache;
+      std::string cache_key;
+      uint64_t cache_hash;
+      std::string mime_type;
+      char *data_url;
+      size_t data_url_length;
+      std::shared_ptr<Stats> stats;
+      Timings timings;
+      double queued_at;
+  };
+
+  /**
+   * Builds the data URL of a cached result's image, of a MIME type it has none of yet, on the libuv thread pool. Only
+   * the image, which never changes once cached, is read off the JS thread: the data URL is added to the result (and
+   * counted against the cache's budget) on the JS thread, which then passes the result to the callback.
+   */
+  class DataUrlWorker : public Nan::AsyncWorker {
+    public:
+      DataUrlWorker(Nan::Callback *callback, const std::shared_ptr<ResultCache> &cache,
+          const std::shared_ptr<CachedResult> &result, const std::string &mime_type)
+        : Nan::AsyncWorker(callback, "codify:createStream"), cache(cache), result(result), mime_type(mime_type),
+          data_url(NULL), data_url_length(0) {}
+
+      ~DataUrlWorker() {
+        free(data_url);
+      }
+
+      void Execute() {
+        data_url = createDataUrl(mime_type.c_str(), result->image, result->image_length, &data_url_length);
+      }
+
+      void HandleOKCallback() {
+        Nan::HandleScope scope;
+        Isolate *isolate = v8::Isolate::GetCurrent();
+        v8::Local<v8::Object> obj = createCachedHandle(isolate, result);
+
+        // if out of memory, the image is passed without a data URL
+        if (data_url != NULL) {
+          cache->addDataUrl(result, mime_type, data_url, data_url_length);
+          data_url = NULL;
+          setCachedDataUrl(isolate, obj, result, mime_type);
+        }
+
+        v8::Local<v8::Value> argv[] = { obj };
+
+        callback->Call(1, argv, async_resource);
+      }
+
+    private:
+      std::shared_ptr<ResultCache> cache;
+      std::shared_ptr<CachedResult> result;
+      std::string mime_type;
+      char *data_url;
+      size_t data_url_length;
+  };
+
   /**
    * Takes the given callback arguments and places their converted values into a new `zint_symbol` instance.
+   * The symbology config arguments start at `args[first]` (i.e., `args[first]` is the symbology).
    */
-  zint_symbol *getSymbolFromArgs(v8::Local<v8::Context> context, const Nan::FunctionCallbackInfo<v8::Value>& args) {
+  zint_symbol *getSymbolFromArgs(v8::Local<v8::Context> context, const Nan::FunctionCallbackInfo<v8::Value>& args, int first) {
     struct zint_symbol *symbol;
 
     symbol = ZBarcode_Create();
 
     // basic symbology info and render size
-    symbol->symbology = (int)args[1]->NumberValue(context).FromJust();
-    symbol->height = (int)args[2]->NumberValue(context).FromJust();
-    symbol->whitespace_width = (int)args[3]->NumberValue(context).FromJust();
-    symbol->border_width = (int)args[4]->NumberValue(context).FromJust();
+    symbol->symbology = (int)args[first]->NumberValue(context).FromJust();
+    symbol->height = (int)args[first + 1]->NumberValue(context).FromJust();
+    symbol->whitespace_width = (int)args[first + 2]->NumberValue(context).FromJust();
+    symbol->border_width = (int)args[first + 3]->NumberValue(context).FromJust();
 
     // options (-1 indicates not set)
     int option_1, option_2, option_3, output_options;
     float scale, dot_size;
 
-    scale = (float)args[9]->NumberValue(context).FromJust();
-    dot_size = (float)args[19]->NumberValue(context).FromJust();
-    option_1 = (int)args[10]->NumberValue(context).FromJust();
-    option_2 = (int)args[11]->NumberValue(context).FromJust();
-    option_3 = (int)args[12]->NumberValue(context).FromJust();
-    output_options = (int)args[5]->NumberValue(context).FromJust();
+    scale = (float)args[first + 8]->NumberValue(context).FromJust();
+    dot_size = (float)args[first + 18]->NumberValue(context).FromJust();
+    option_1 = (int)args[first + 9]->NumberValue(context).FromJust();
+    option_2 = (int)args[first + 10]->NumberValue(context).FromJust();
+    option_3 = (int)args[first + 11]->NumberValue(context).FromJust();
+    output_options = (int)args[first + 4]->NumberValue(context).FromJust();
 
     if(option_1 > -1) {
       symbol->option_1 = option_1;
@@ -129,11 +610,11 @@ namespace codify {
       symbol->dot_size = dot_size;
     }
 
-    Nan::Utf8String bgcolor(args[6]);
-    Nan::Utf8String fgcolor(args[7]);
-    Nan::Utf8String outfile(args[8]);
-    Nan::Utf8String text(args[14]);
-    Nan::Utf8String primary(args[17]);
+    Nan::Utf8String bgcolor(args[first + 5]);
+    Nan::Utf8String fgcolor(args[first + 6]);
+    Nan::Utf8String outfile(args[first + 7]);
+    Nan::Utf8String text(args[first + 13]);
+    Nan::Utf8String primary(args[first + 16]);
 
     // colors
     strncpy((char*)&symbol->bgcolour[0], *bgcolor, sizeof(symbol->bgcolour) - 1);
@@ -149,13 +630,13 @@ namespace codify {
     strncpy((char*)&symbol->text[0], *text, sizeof(symbol->text) - 1);
 
     // show/hide human-readable text
-    symbol->show_hrt = (int)args[13]->NumberValue(context).FromJust();
+    symbol->show_hrt = (int)args[first + 12]->NumberValue(context).FromJust();
 
     // encoding mode
-    symbol->input_mode = (int)args[15]->NumberValue(context).FromJust();
+    symbol->input_mode = (int)args[first + 14]->NumberValue(context).FromJust();
 
     // eci mode
-    symbol->eci = (int)args[16]->NumberValue(context).FromJust();
+    symbol->eci = (int)args[first + 15]->NumberValue(context).FromJust();
 
     // text to display
     strncpy((char*)&symbol->text[0], *text, sizeof(symbol->text) - 1);
@@ -164,15 +645,111 @@ namespace codify {
   }
 
   /**
-   * Creates a new barcode stream and returns an object containing the
-   * binary data of the bitmap, status code, message, and fileName, and bitmap params.
+   * State of one instance of the addon. The addon is context-aware, so it is instantiated once per environment
+   * (i.e., once for the main thread and once for each worker thread that loads it); nothing mutable is shared
+   * between instances. Handles stored here belong to the instance's isolate.
+   */
+  struct AddonData {
+    Nan::Global<v8::FunctionTemplate> encoderTemplate;
+    std::shared_ptr<ResultCache> cache;
+    std::shared_ptr<Stats> stats;
+
+    AddonData() : cache(std::make_shared<ResultCache>()), stats(std::make_shared<Stats>()) {}
+  };
+
+  /**
+   * Returns the instance data passed to a function as its `data`.
+   */
+  AddonData *getAddonData(const Nan::FunctionCallbackInfo<v8::Value>& args) {
+    return (AddonData*)args.Data().As<v8::External>()->Value();
+  }
+
+  /**
+   * Environment cleanup hook which frees the instance data once its environment (thread) exits.
+   */
+  void deleteAddonData(void *arg) {
+    delete (AddonData*)arg;
+  }
+
+  /**
+   * Queues a worker to render the data with the symbol (taking ownership of it), which calls the callback with the
+   * result. If the instance's cache is enabled and already holds the result, nothing is queued: the result is set as
+   * the return value of the calling function instead, and the callback is never called.
+   * If `mime_type` is not empty, the result's image file is passed as a data URL of that type (see `StreamWorker`).
+   * A cached result holds the data URLs built for it, so only if it has none of that type yet is a worker queued, to
+   * build it (see `DataUrlWorker`), instead of returning the result.
+   * If the instance's stats are enabled, the render is timed (see `StreamWorker::setStats()`).
+   */
+  void queueStreamWorker(const Nan::FunctionCallbackInfo<v8::Value>& args, AddonData *addonData, zint_symbol *symbol,
+      const char *data, int rotate_angle, v8::Local<v8::Function> callback, const std::string &mime_type) {
+    std::shared_ptr<ResultCache> cache = addonData->cache;
+    StreamWorker *worker;
+
+    if (!cache->enabled()) {
+      worker = new StreamWorker(new Nan::Callback(callback), symbol, data, rotate_angle);
+    } else {
+      std::string key = getCacheKey(symbol, rotate_angle, data);
+      uint64_t hash = hashCacheKey(key);
+      std::shared_ptr<CachedResult> result = cache->get(hash, key);
+
+      if (result) {
+        ZBarcode_Delete(symbol);
+
+        if (!mime_type.empty() && result->image != NULL && result->getDataUrl(mime_type) == NULL) {
+          Nan::AsyncQueueWorker(new DataUrlWorker(new Nan::Callback(callback), cache, result, mime_type));
+          return;
+        }
+
+        v8::Local<v8::Object> obj = createCachedHandle(args.GetIsolate(), result);
+
+        setCachedDataUrl(args.GetIsolate(), obj, result, mime_type);
+        args.GetReturnValue().Set(obj);
+        return;
+      }
+
+      worker = new StreamWorker(new Nan::Callback(callback), symbol, data, rotate_angle);
+      worker->setCache(cache, key, hash);
+    }
+
+    worker->setDataUrlType(mime_type);
+
+    if (addonData->stats->enabled()) {
+      worker->setStats(addonData->stats);
+    }
+
+    Nan::AsyncQueueWorker(worker);
+  }
+
+  /**
+   * Returns the optional MIME type argument of a render, which requests its image file as a data URL, or an empty
+   * string if it is not given.
+   */
+  std::string getDataUrlType(v8::Local<v8::Value> arg) {
+    if (!arg->IsString()) {
+      return std::string();
+    }
+
+    Nan::Utf8String mime_type(arg);
+
+    return std::string(*mime_type);
+  }
+
+  /**
+   * Creates a new barcode stream asynchronously. The last argument is a callback which receives an object
+   * containing the binary data of the bitmap, status code, message, and fileName, and bitmap params.
+   * If the result is cached, it is returned instead, and the callback is not called.
+   * An optional MIME type after the callback requests the image file as a base64 `dataUrl` of that type.
    */
   void createStream (const Nan::FunctionCallbackInfo<v8::Value>& args) {
     Isolate* isolate = args.GetIsolate();
     v8::Local<v8::Context> context = isolate->GetCurrentContext();
-    Local<Object> obj;
 
-    struct zint_symbol *symbol = getSymbolFromArgs(context, args);
+    if (!args[20]->IsFunction()) {
+      Nan::ThrowTypeError("createStream() expects a callback as its last argument.");
+      return;
+    }
+
+    struct zint_symbol *symbol = getSymbolFromArgs(context, args, 1);
 
     // parse `rotation` angle argument
     int rotate_angle;
@@ -180,21 +757,993 @@ namespace codify {
 
     Nan::Utf8String data(args[0]);
 
-    obj = createStreamHandle(isolate, symbol, (unsigned char*)*data, (char*)*data, rotate_angle);
+    queueStreamWorker(args, getAddonData(args), symbol, *data, rotate_angle, args[20].As<v8::Function>(), getDataUrlType(args[21]));
+  }
 
-    ZBarcode_Delete(symbol);
-    args.GetReturnValue().Set(obj);
+  /**
+   * Returns a new Float32Array holding a copy of the given values.
+   */
+  Local<v8::Float32Array> newFloat32Array(Isolate *isolate, const std::vector<float> &values) {
+    size_t byte_length = values.size() * sizeof(float);
+    Local<v8::ArrayBuffer> buffer = v8::ArrayBuffer::New(isolate, byte_length);
+
+    if (byte_length > 0) {
+      memcpy(buffer->GetBackingStore()->Data(), values.data(), byte_length);
+    }
+    return v8::Float32Array::New(buffer, 0, values.size());
   }
 
-  void Init(v8::Local<v8::Object> exports) {
-    v8::Local<v8::Context> context = exports->CreationContext();
+  /**
+   * Returns an object with the packed vector geometry of the rendered symbology (see `PackedVector`).
+   */
+  Local<Object> createVectorHandle(Isolate* isolate, zint_symbol *symbol, int status_code, const PackedVector &packed) {
+    v8::Local<v8::Object> obj = Object::New(isolate);
 
-    (void)exports->Set(context,
-      Nan::New("createStream").ToLocalChecked(),
-      Nan::New<v8::FunctionTemplate>(createStream)
+    if(status_code <= 2) {
+      v8::Local<v8::Array> texts = Nan::New<v8::Array>((int)packed.texts.size());
+
+      for (size_t i = 0; i < packed.texts.size(); i++) {
+        Nan::Set(texts, (uint32_t)i, Nan::New<String>(packed.texts[i].c_str(), (int)packed.texts[i].size()).ToLocalChecked());
+      }
+
+      Nan::Set(obj, Nan::New<String>("width").ToLocalChecked(), Nan::New<v8::Number>(packed.width));
+      Nan::Set(obj, Nan::New<String>("height").ToLocalChecked(), Nan::New<v8::Number>(packed.height));
+      Nan::Set(obj, Nan::New<String>("rectangles").ToLocalChecked(), newFloat32Array(isolate, packed.rectangles));
+      Nan::Set(obj, Nan::New<String>("hexagons").ToLocalChecked(), newFloat32Array(isolate, packed.hexagons));
+      Nan::Set(obj, Nan::New<String>("circles").ToLocalChecked(), newFloat32Array(isolate, packed.circles));
+      Nan::Set(obj, Nan::New<String>("strings").ToLocalChecked(), newFloat32Array(isolate, packed.strings));
+      Nan::Set(obj, Nan::New<String>("texts").ToLocalChecked(), texts);
+    }
+
+    // set the informational params (message and status code)
+    Nan::Set(obj, Nan::New<String>("message").ToLocalChecked(), Nan::New<String>(symbol->errtxt).ToLocalChecked());
+    Nan::Set(obj, Nan::New<String>("code").ToLocalChecked(), v8::Integer::New(isolate, status_code));
+
+    return obj;
+  }
+
+  /**
+   * Encodes a symbology and buffers its vector geometry on the libuv thread pool, where the geometry is also
+   * packed into flat arrays, so that only a copy of each array is left to do on the JS thread.
+   */
+  class VectorWorker : public Nan::AsyncWorker {
+    public:
+      VectorWorker(Nan::Callback *callback, zint_symbol *symbol, const char *data, int rotate_angle)
+        : Nan::AsyncWorker(callback, "codify:createVector"), symbol(symbol), data(data), rotate_angle(rotate_angle),
+          status_code(0) {}
+
+      ~VectorWorker() {
+        ZBarcode_Delete(symbol);
+      }
+
+      void Execute() {
+        status_code = ZBarcode_Encode_and_Buffer_Vector(symbol, (uint8_t*)data.c_str(), 0, rotate_angle);
+
+        if (status_code <= 2 && symbol->vector != NULL) {
+          packVector(symbol->vector, &packed);
+        }
+      }
+
+      void HandleOKCallback() {
+        Nan::HandleScope scope;
+        v8::Local<v8::Value> argv[] = { createVectorHandle(v8::Isolate::GetCurrent(), symbol, status_code, packed) };
+
+        callback->Call(1, argv, async_resource);
+      }
+
+    private:
+      zint_symbol *symbol;
+      std::string data;
+      int rotate_angle;
+      int status_code;
+      PackedVector packed;
+  };
+
+  /**
+   * Encodes a symbology and returns its vector geometry asynchronously. Takes the same arguments as
+   * `createStream()` (the output options and file name are ignored); the callback receives an object
+   * containing the packed geometry, status code, and message.
+   */
+  void createVector(const Nan::FunctionCallbackInfo<v8::Value>& args) {
+    Isolate* isolate = args.GetIsolate();
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+
+    if (!args[20]->IsFunction()) {
+      Nan::ThrowTypeError("createVector() expects a callback as its last argument.");
+      return;
+    }
+
+    struct zint_symbol *symbol = getSymbolFromArgs(context, args, 1);
+    int rotate_angle = (int)args[18]->NumberValue(context).FromJust();
+    Nan::Utf8String data(args[0]);
+    Nan::Callback *callback = new Nan::Callback(args[20].As<v8::Function>());
+
+    Nan::AsyncQueueWorker(new VectorWorker(callback, symbol, *data, rotate_angle));
+  }
+
+  /**
+   * Pixel formats of `createRaster()`: 4 bytes of RGBA per pixel, or a palette index per pixel, packed into 8 or 1 bits.
+   */
+  enum RasterMode {
+    RASTER_RGBA,
+    RASTER_INDEXED,
+    RASTER_MONO
+  };
+
+  /**
+   * Returns an object with the raster pixels of the rendered symbology, and their palette if they are indexed.
+   * Ownership of `pixels` is transferred to the returned object.
+   */
+  Local<Object> createRasterHandle(Isolate* isolate, zint_symbol *symbol, int status_code, unsigned char *pixels, size_t pixels_length, RasterMode mode, const Palette &palette) {
+    v8::Local<v8::Object> obj = Object::New(isolate);
+
+    if(status_code <= 2) {
+      const int width = symbol->bitmap_width;
+      const int stride = mode == RASTER_RGBA ? width * 4 : mode == RASTER_INDEXED ? width : (width + 7) / 8;
+      const int palette_size = mode == RASTER_RGBA ? 0 : palette.size;
+
+      Nan::Set(obj, Nan::New<String>("width").ToLocalChecked(), v8::Integer::New(isolate, width));
+      Nan::Set(obj, Nan::New<String>("height").ToLocalChecked(), v8::Integer::New(isolate, symbol->bitmap_height));
+      Nan::Set(obj, Nan::New<String>("stride").ToLocalChecked(), v8::Integer::New(isolate, stride));
+      Nan::Set(obj, Nan::New<String>("pixels").ToLocalChecked(), pixels != NULL
+        ? Nan::NewBuffer((char*)pixels, (uint32_t)pixels_length).ToLocalChecked()
+        : Nan::NewBuffer(0).ToLocalChecked());
+      Nan::Set(obj, Nan::New<String>("palette").ToLocalChecked(), Nan::CopyBuffer((const char*)palette.colours, (uint32_t)palette_size * 4).ToLocalChecked());
+    } else {
+      free(pixels);
+    }
+
+    // set the informational params (message and status code)
+    Nan::Set(obj, Nan::New<String>("message").ToLocalChecked(), Nan::New<String>(symbol->errtxt).ToLocalChecked());
+    Nan::Set(obj, Nan::New<String>("code").ToLocalChecked(), v8::Integer::New(isolate, status_code));
+
+    return obj;
+  }
+
+  /**
+   * Encodes and buffers a symbology on the libuv thread pool, where its pixels are also written in the requested
+   * format, so that they are handed to JS as they are. RGBA pixels are merged from zint's RGB bitmap and alphamap;
+   * indexed pixels are read from its intermediate bitmap, which is never expanded to RGB.
+   */
+  class RasterWorker : public Nan::AsyncWorker {
+    public:
+      RasterWorker(Nan::Callback *callback, zint_symbol *symbol, const char *data, int rotate_angle, RasterMode mode)
+        : Nan::AsyncWorker(callback, "codify:createRaster"), symbol(symbol), data(data), rotate_angle(rotate_angle),
+          mode(mode), status_code(0), pixels(NULL), pixels_length(0) {
+        palette.size = 0;
+      }
+
+      ~RasterWorker() {
+        ZBarcode_Delete(symbol);
+        free(pixels);
+      }
+
+      void Execute() {
+        int error_number;
+
+        if (mode == RASTER_RGBA) {
+          symbol->output_options &= ~OUT_BUFFER_INTERMEDIATE;
+        } else {
+          symbol->output_options |= OUT_BUFFER_INTERMEDIATE;
+        }
+
+        status_code = ZBarcode_Encode_and_Buffer(symbol, (uint8_t*)data.c_str(), 0, rotate_angle);
+
+        if (status_code > 2) {
+          return;
+        }
+
+        if (mode == RASTER_RGBA) {
+          error_number = writeRgba(symbol, &pixels, &pixels_length);
+        } else if ((error_number = getPalette(symbol, &palette)) == 0) {
+          error_number = writeIndexed(symbol, palette, mode == RASTER_MONO ? 1 : 8, &pixels, &pixels_length);
+        }
+
+        if (error_number != 0) {
+          status_code = error_number;
+        }
+      }
+
+      void HandleOKCallback() {
+        Nan::HandleScope scope;
+        v8::Local<v8::Value> argv[] = {
+          createRasterHandle(v8::Isolate::GetCurrent(), symbol, status_code, pixels, pixels_length, mode, palette)
+        };
+
+        // the result now owns the pixels
+        pixels = NULL;
+
+        callback->Call(1, argv, async_resource);
+      }
+
+    private:
+      zint_symbol *symbol;
+      std::string data;
+      int rotate_angle;
+      RasterMode mode;
+      int status_code;
+      unsigned char *pixels;
+      size_t pixels_length;
+      Palette palette;
+  };
+
+  /**
+   * Encodes a symbology and returns its raster pixels asynchronously. Takes the same arguments as `createStream()`
+   * (the output options and file name are ignored), followed by the raster mode ("rgba", "indexed" or "mono"); the
+   * callback receives an object containing the pixels, their dimensions and palette, status code, and message.
+   */
+  void createRaster(const Nan::FunctionCallbackInfo<v8::Value>& args) {
+    Isolate* isolate = args.GetIsolate();
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+    RasterMode mode;
+
+    if (!args[20]->IsFunction()) {
+      Nan::ThrowTypeError("createRaster() expects a callback as its last argument.");
+      return;
+    }
+
+    Nan::Utf8String mode_name(args[21]);
+
+    if (!args[21]->IsString()) {
+      Nan::ThrowTypeError("createRaster() expects a raster mode.");
+      return;
+    } else if (strcmp(*mode_name, "rgba") == 0) {
+      mode = RASTER_RGBA;
+    } else if (strcmp(*mode_name, "indexed") == 0) {
+      mode = RASTER_INDEXED;
+    } else if (strcmp(*mode_name, "mono") == 0) {
+      mode = RASTER_MONO;
+    } else {
+      Nan::ThrowTypeError("createRaster() expects a raster mode of \"rgba\", \"indexed\" or \"mono\".");
+      return;
+    }
+
+    struct zint_symbol *symbol = getSymbolFromArgs(context, args, 1);
+    int rotate_angle = (int)args[18]->NumberValue(context).FromJust();
+    Nan::Utf8String data(args[0]);
+    Nan::Callback *callback = new Nan::Callback(args[20].As<v8::Function>());
+
+    // raster pixels are read from the buffered bitmap, never from a file
+    symbol->output_options &= ~BARCODE_MEMORY_FILE;
+
+    Nan::AsyncQueueWorker(new RasterWorker(callback, symbol, *data, rotate_angle, mode));
+  }
+
+  /**
+   * Returns an object with the packed module matrix and row heights of the encoded symbology (see `PackedMatrix`).
+   */
+  Local<Object> createMatrixHandle(Isolate* isolate, zint_symbol *symbol, int status_code, const PackedMatrix &packed) {
+    v8::Local<v8::Object> obj = Object::New(isolate);
+
+    if(status_code <= 2) {
+      Nan::Set(obj, Nan::New<String>("rows").ToLocalChecked(), v8::Integer::New(isolate, packed.rows));
+      Nan::Set(obj, Nan::New<String>("width").ToLocalChecked(), v8::Integer::New(isolate, packed.width));
+      Nan::Set(obj, Nan::New<String>("stride").ToLocalChecked(), v8::Integer::New(isolate, packed.stride));
+      Nan::Set(obj, Nan::New<String>("height").ToLocalChecked(), Nan::New<v8::Number>(packed.height));
+      Nan::Set(obj, Nan::New<String>("modules").ToLocalChecked(), Nan::CopyBuffer((const char*)packed.modules.data(), (uint32_t)packed.modules.size()).ToLocalChecked());
+      Nan::Set(obj, Nan::New<String>("colours").ToLocalChecked(), Nan::CopyBuffer((const char*)packed.colours.data(), (uint32_t)packed.colours.size()).ToLocalChecked());
+      Nan::Set(obj, Nan::New<String>("rowHeights").ToLocalChecked(), newFloat32Array(isolate, packed.row_heights));
+    }
+
+    // set the informational params (message and status code)
+    Nan::Set(obj, Nan::New<String>("message").ToLocalChecked(), Nan::New<String>(symbol->errtxt).ToLocalChecked());
+    Nan::Set(obj, Nan::New<String>("code").ToLocalChecked(), v8::Integer::New(isolate, status_code));
+
+    return obj;
+  }
+
+  /**
+   * Encodes a symbology on the libuv thread pool, without laying it out or rendering it in any way.
+   */
+  class MatrixWorker : public Nan::AsyncWorker {
+    public:
+      MatrixWorker(Nan::Callback *callback, zint_symbol *symbol, const char *data)
+        : Nan::AsyncWorker(callback, "codify:encode"), symbol(symbol), data(data), status_code(0) {}
+
+      ~MatrixWorker() {
+        ZBarcode_Delete(symbol);
+      }
+
+      void Execute() {
+        status_code = ZBarcode_Encode(symbol, (uint8_t*)data.c_str(), 0);
+
+        if (status_code <= 2) {
+          packMatrix(symbol, &packed);
+        }
+      }
+
+      void HandleOKCallback() {
+        Nan::HandleScope scope;
+        v8::Local<v8::Value> argv[] = { createMatrixHandle(v8::Isolate::GetCurrent(), symbol, status_code, packed) };
+
+        callback->Call(1, argv, async_resource);
+      }
+
+    private:
+      zint_symbol *symbol;
+      std::string data;
+      int status_code;
+      PackedMatrix packed;
+  };
+
+  /**
+   * Encodes a symbology and returns its module matrix asynchronously. Takes the same arguments as `createStream()`
+   * (those that only affect rendering are ignored); the callback receives an object containing the packed module
+   * matrix, row heights, status code, and message.
+   */
+  void encode(const Nan::FunctionCallbackInfo<v8::Value>& args) {
+    Isolate* isolate = args.GetIsolate();
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+
+    if (!args[20]->IsFunction()) {
+      Nan::ThrowTypeError("encode() expects a callback as its last argument.");
+      return;
+    }
+
+    struct zint_symbol *symbol = getSymbolFromArgs(context, args, 1);
+    Nan::Utf8String data(args[0]);
+    Nan::Callback *callback = new Nan::Callback(args[20].As<v8::Function>());
+
+    Nan::AsyncQueueWorker(new MatrixWorker(callback, symbol, *data));
+  }
+
+  /**
+   * Returns a new symbol with the same config as the given template symbol, ready to be encoded. If the template has
+   * been encoded (but not rendered), the copy holds the same encoded symbology, ready to be rendered.
+   * The template must not hold any output (bitmap, vector, etc.), since those are not copied.
+   */
+  zint_symbol *cloneSymbol(const zint_symbol *templ) {
+    struct zint_symbol *symbol = ZBarcode_Create();
+
+    *symbol = *templ;
+
+    // the colour pointers reference the colour strings within the symbol itself
+    symbol->fgcolor = &symbol->fgcolour[0];
+    symbol->bgcolor = &symbol->bgcolour[0];
+
+    return symbol;
+  }
+
+  /**
+   * A symbology config that is converted and validated once, from which any number of symbologies can be encoded.
+   * Each `encode()` works on a copy of the template symbol, since zint updates some of its inputs (e.g., `height`)
+   * while encoding, and encodes may be running concurrently on the libuv thread pool.
+   */
+  class Encoder : public Nan::ObjectWrap {
+    public:
+      static void Init(v8::Local<v8::Object> exports, AddonData *addonData, v8::Local<v8::External> data) {
+        v8::Local<v8::Context> context = exports->CreationContext();
+        v8::Local<v8::FunctionTemplate> tpl = Nan::New<v8::FunctionTemplate>(New);
+
+        tpl->SetClassName(Nan::New("Encoder").ToLocalChecked());
+        tpl->InstanceTemplate()->SetInternalFieldCount(1);
+
+        Nan::SetPrototypeMethod(tpl, "encode", Encode, data);
+
+        // kept per instance, since a template can only be used with the isolate that created it
+        addonData->encoderTemplate.Reset(tpl);
+
+        (void)exports->Set(context,
+          Nan::New("Encoder").ToLocalChecked(),
+          tpl->GetFunction(context).ToLocalChecked());
+      }
+
+    private:
+      Encoder(zint_symbol *templ, int rotate_angle) : templ(templ), rotate_angle(rotate_angle) {}
+
+      ~Encoder() {
+        ZBarcode_Delete(templ);
+      }
+
+      /**
+       * Constructs an encoder from the symbology config arguments (the same as `createStream()`'s, less the
+       * data and callback).
+       */
+      static void New(const Nan::FunctionCallbackInfo<v8::Value>& args) {
+        v8::Local<v8::Context> context = args.GetIsolate()->GetCurrentContext();
+
+        if (!args.IsConstructCall()) {
+          Nan::ThrowTypeError("Encoder() must be called with `new`.");
+          return;
+        }
+
+        struct zint_symbol *templ = getSymbolFromArgs(context, args, 0);
+        int rotate_angle = (int)args[17]->NumberValue(context).FromJust();
+
+        // validate what can be validated up front, so that a bad config fails once rather than on every encode
+        if (!ZBarcode_ValidID(templ->symbology)) {
+          ZBarcode_Delete(templ);
+          Nan::ThrowRangeError("Encoder() was given an invalid symbology.");
+          return;
+        }
+        if (rotate_angle != 0 && rotate_angle != 90 && rotate_angle != 180 && rotate_angle != 270) {
+          ZBarcode_Delete(templ);
+          Nan::ThrowRangeError("Encoder() was given an invalid rotation angle.");
+          return;
+        }
+
+        Encoder *encoder = new Encoder(templ, rotate_angle);
+        encoder->Wrap(args.This());
+        args.GetReturnValue().Set(args.This());
+      }
+
+      /**
+       * Encodes the data (the first argument) asynchronously with the encoder's config.
+       * The callback (the second argument) receives the same object as `createStream()`'s, or, as with
+       * `createStream()`, the object is returned if it is cached. The optional third argument is the MIME type of a
+       * data URL to request, as with `createStream()`.
+       */
+      static void Encode(const Nan::FunctionCallbackInfo<v8::Value>& args) {
+        AddonData *addonData = getAddonData(args);
+
+        // `Unwrap()` would read an arbitrary object's fields as an encoder, so make sure it is one
+        if (!Nan::New(addonData->encoderTemplate)->HasInstance(args.Holder())) {
+          Nan::ThrowTypeError("encode() must be called on an Encoder.");
+          return;
+        }
+
+        Encoder *encoder = Nan::ObjectWrap::Unwrap<Encoder>(args.Holder());
+
+        if (!args[1]->IsFunction()) {
+          Nan::ThrowTypeError("encode() expects a callback as its last argument.");
+          return;
+        }
+
+        Nan::Utf8String data(args[0]);
+
+        queueStreamWorker(args, addonData, cloneSymbol(encoder->templ), *data, encoder->rotate_angle, args[1].As<v8::Function>(), getDataUrlType(args[2]));
+      }
+
+      zint_symbol *templ;
+      int rotate_angle;
+  };
+
+  /**
+   * Encodes a symbology once on the libuv thread pool, and then renders it with each of a list of render specs
+   * (output type, scale, rotation and colours). Each render works on a copy of the encoded symbol, so every render
+   * is the same as if it had been encoded by itself.
+   */
+  class RenderWorker : public Nan::AsyncWorker {
+    public:
+      RenderWorker(Nan::Callback *callback, zint_symbol *symbol, const char *data)
+        : Nan::AsyncWorker(callback, "codify:createRenders"), symbol(symbol), data(data), queued_at(0.0) {}
+
+      ~RenderWorker() {
+        for (size_t i = 0; i < renders.size(); i++) {
+          ZBarcode_Delete(renders[i].symbol);
+          free(renders[i].image);
+        }
+        ZBarcode_Delete(symbol);
+      }
+
+      /**
+       * Adds a render of the symbology, from a render spec object with `fileName`, `outputOptions`, `scale`,
+       * `rotation`, `foregroundColor` and `backgroundColor`.
+       */
+      void addRender(v8::Local<v8::Context> context, v8::Local<v8::Object> spec) {
+        Nan::Utf8String fileName(Nan::Get(spec, Nan::New("fileName").ToLocalChecked()).ToLocalChecked());
+        Nan::Utf8String fgcolor(Nan::Get(spec, Nan::New("foregroundColor").ToLocalChecked()).ToLocalChecked());
+        Nan::Utf8String bgcolor(Nan::Get(spec, Nan::New("backgroundColor").ToLocalChecked()).ToLocalChecked());
+        Render render = { NULL, "", 0, 1.0f, "", "", 0, 0, NULL, 0, Timings() };
+
+        render.file_name = *fileName;
+        render.fgcolour = *fgcolor;
+        render.bgcolour = *bgcolor;
+        render.output_options = (int)Nan::Get(spec, Nan::New("outputOptions").ToLocalChecked()).ToLocalChecked()->NumberValue(context).FromJust();
+        render.scale = (float)Nan::Get(spec, Nan::New("scale").ToLocalChecked()).ToLocalChecked()->NumberValue(context).FromJust();
+        render.rotate_angle = (int)Nan::Get(spec, Nan::New("rotation").ToLocalChecked()).ToLocalChecked()->NumberValue(context).FromJust();
+
+        renders.push_back(render);
+      }
+
+      /**
+       * Times the phases of each render from now on, and adds them to the given stats once they are rendered.
+       */
+      void setStats(const std::shared_ptr<Stats> &stats) {
+        this->stats = stats;
+        this->queued_at = monotonicMs();
+      }
+
+      void Execute() {
+        double queue_ms = 0.0;
+
+        if (stats) {
+          queue_ms = monotonicMs() - queued_at;
+          symbol->output_options |= BARCODE_TIMINGS;
+        }
+
+        int encode_status = ZBarcode_Encode(symbol, (uint8_t*)data.c_str(), 0);
+
+        for (size_t i = 0; i < renders.size(); i++) {
+          Render &render = renders[i];
+          Timings *timed = stats ? &render.timings : NULL;
+
+          render.symbol = cloneSymbol(symbol);
+
+          if (timed != NULL) {
+            // each render shares the time spent waiting and encoding
+            timed->ms[PHASE_QUEUE] = queue_ms;
+            timed->ms[PHASE_CONVERT] = symbol->timings.convert;
+            timed->ms[PHASE_ENCODE] = symbol->timings.encode;
+          }
+
+          if (encode_status >= ZINT_ERROR) {
+            render.status_code = encode_status;
+
+            if (timed != NULL) {
+              timed->ms[PHASE_TOTAL] = monotonicMs() - queued_at;
+            }
+            continue;
+          }
+
+          strncpy(render.symbol->outfile, render.file_name.c_str(), sizeof(render.symbol->outfile) - 1);
+          strncpy(render.symbol->fgcolour, render.fgcolour.c_str(), sizeof(render.symbol->fgcolour) - 1);
+          strncpy(render.symbol->bgcolour, render.bgcolour.c_str(), sizeof(render.symbol->bgcolour) - 1);
+
+          if (render.output_options > -1) {
+            render.symbol->output_options = render.output_options;
+          }
+          if (render.scale > 0) {
+            render.symbol->scale = render.scale;
+          }
+
+          render.status_code = renderEncodedSymbol(render.symbol, encode_status, render.rotate_angle, &render.image, &render.image_length, timed);
+
+          if (timed != NULL) {
+            timed->ms[PHASE_TOTAL] = monotonicMs() - queued_at;
+          }
+        }
+      }
+
+      void HandleOKCallback() {
+        Nan::HandleScope scope;
+        Isolate *isolate = v8::Isolate::GetCurrent();
+        v8::Local<v8::Array> results = Nan::New<v8::Array>((int)renders.size());
+
+        for (size_t i = 0; i < renders.size(); i++) {
+          Render &render = renders[i];
+
+          v8::Local<v8::Object> obj = createStreamHandle(isolate, render.symbol, render.status_code, render.image, render.image_length);
+
+          // the result now owns the image
+          render.image = NULL;
+
+          if (stats) {
+            setTimings(obj, render.timings);
+
+            if (stats->enabled()) {
+              stats->record(render.timings, render.status_code);
+            }
+          }
+
+          Nan::Set(results, (uint32_t)i, obj);
+        }
+
+        v8::Local<v8::Value> argv[] = { results };
+
+        callback->Call(1, argv, async_resource);
+      }
+
+    private:
+      struct Render {
+        zint_symbol *symbol;
+        std::string file_name;
+        int output_options;
+        float scale;
+        std::string fgcolour;
+        std::string bgcolour;
+        int rotate_angle;
+        int status_code;
+        unsigned char *image;
+        size_t image_length;
+        Timings timings;
+      };
+
+      zint_symbol *symbol;
+      std::string data;
+      std::vector<Render> renders;
+      std::shared_ptr<Stats> stats;
+      double queued_at;
+  };
+
+  /**
+   * Encodes a symbology once and renders it with each of a list of render specs, asynchronously. Takes the same
+   * arguments as `createStream()`, followed by an array of render specs (see `RenderWorker::addRender()`) before the
+   * callback. The callback receives an array of the objects `createStream()` would produce, one for each render spec.
+   */
+  void createRenders(const Nan::FunctionCallbackInfo<v8::Value>& args) {
+    Isolate* isolate = args.GetIsolate();
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+
+    if (!args[20]->IsArray()) {
+      Nan::ThrowTypeError("createRenders() expects an array of render specs before its callback.");
+      return;
+    }
+    if (!args[21]->IsFunction()) {
+      Nan::ThrowTypeError("createRenders() expects a callback as its last argument.");
+      return;
+    }
+
+    v8::Local<v8::Array> specs = args[20].As<v8::Array>();
+    Nan::Utf8String data(args[0]);
+    Nan::Callback *callback = new Nan::Callback(args[21].As<v8::Function>());
+    RenderWorker *worker = new RenderWorker(callback, getSymbolFromArgs(context, args, 1), *data);
+
+    for (uint32_t i = 0; i < specs->Length(); i++) {
+      v8::Local<v8::Value> spec = Nan::Get(specs, i).ToLocalChecked();
+
+      if (!spec->IsObject()) {
+        delete worker;
+        Nan::ThrowTypeError("createRenders() expects each render spec to be an object.");
+        return;
+      }
+      worker->addRender(context, spec.As<v8::Object>());
+    }
+
+    if (getAddonData(args)->stats->enabled()) {
+      worker->setStats(getAddonData(args)->stats);
+    }
+
+    Nan::AsyncQueueWorker(worker);
+  }
+
+  /** Number of items of a `createStreams()` batch rendered by each work item of the libuv thread pool */
+  const uint32_t BATCH_CHUNK_SIZE = 128;
+
+  /**
+   * The state shared by the chunks of a `createStreams()` batch: the config they all render with, the data still to
+   * be queued, and the array of results which is passed to the callback once the last chunk is done.
+   */
+  struct StreamBatch {
+    StreamBatch(Nan::Callback *callback, zint_symbol *templ, int rotate_angle, v8::Local<v8::Array> data)
+      : callback(callback), templ(templ), rotate_angle(rotate_angle), queued_at(0.0), length(data->Length()),
+        next_item(0), pending(0), data(data), results(Nan::New<v8::Array>(data->Length())) {}
+
+    ~StreamBatch() {
+      delete callback;
+      ZBarcode_Delete(templ);
+    }
+
+    Nan::Callback *callback;
+    zint_symbol *templ;
+    int rotate_angle;
+    std::shared_ptr<Stats> stats;
+    double queued_at;
+    uint32_t length;
+    uint32_t next_item;
+    size_t pending;
+    Nan::Global<v8::Array> data;
+    Nan::Global<v8::Array> results;
+  };
+
+  void queueBatchChunk(const std::shared_ptr<StreamBatch> &batch);
+
+  /**
+   * Encodes and renders a chunk of at most `BATCH_CHUNK_SIZE` consecutive items of a batch on a thread of the libuv
+   * thread pool. Once it is done, its results are added to the batch and the next chunk is queued behind whatever
+   * else was queued on the pool meanwhile. The last chunk passes all the results to the callback, in the same order
+   * as the data.
+   */
+  class BatchWorker : public Nan::AsyncWorker {
+    public:
+      BatchWorker(const std::shared_ptr<StreamBatch> &batch, uint32_t offset)
+        : Nan::AsyncWorker(NULL, "codify:createStreams"), batch(batch), offset(offset) {}
+
+      ~BatchWorker() {
+        for (size_t i = 0; i < items.size(); i++) {
+          ZBarcode_Delete(items[i].symbol);
+          free(items[i].image);
+        }
+      }
+
+      /**
+       * Adds the data of one symbology to the chunk.
+       */
+      void addItem(const char *data) {
+        BatchItem item = { NULL, data, 0, NULL, 0, Timings() };
+
+        items.push_back(item);
+      }
+
+      void Execute() {
+        for (size_t i = 0; i < items.size(); i++) {
+          BatchItem &item = items[i];
+          Timings *timed = batch->stats ? &item.timings : NULL;
+
+          if (timed != NULL) {
+            timed->ms[PHASE_QUEUE] = monotonicMs() - batch->queued_at;
+          }
+
+          item.symbol = cloneSymbol(batch->templ);
+          item.status_code = renderSymbol(item.symbol, item.data, batch->rotate_angle, &item.image, &item.image_length,
+            timed);
+
+          if (timed != NULL) {
+            timed->ms[PHASE_TOTAL] = monotonicMs() - batch->queued_at;
+          }
+        }
+      }
+
+      void HandleOKCallback() {
+        Nan::HandleScope scope;
+        Isolate *isolate = v8::Isolate::GetCurrent();
+        v8::Local<v8::Array> results = Nan::New(batch->results);
+
+        for (size_t i = 0; i < items.size(); i++) {
+          BatchItem &item = items[i];
+
+          v8::Local<v8::Object> obj = createStreamHandle(isolate, item.symbol, item.status_code, item.image, item.image_length);
+
+          // the result now owns the image
+          item.image = NULL;
+
+          if (batch->stats) {
+            setTimings(obj, item.timings);
+
+            if (batch->stats->enabled()) {
+              batch->stats->record(item.timings, item.status_code);
+            }
+          }
+
+          Nan::Set(results, offset + (uint32_t)i, obj);
+        }
+        batch->pending--;
+
+        if (batch->next_item < batch->length) {
+          queueBatchChunk(batch);
+        } else if (batch->pending == 0) {
+          v8::Local<v8::Value> argv[] = { results };
+
+          batch->callback->Call(1, argv, async_resource);
+        }
+      }
+
+    private:
+      struct BatchItem {
+        zint_symbol *symbol;
+        std::string data;
+        int status_code;
+        unsigned char *image;
+        size_t image_length;
+        Timings timings;
+      };
+
+      std::shared_ptr<StreamBatch> batch;
+      uint32_t offset;
+      std::vector<BatchItem> items;
+  };
+
+  /**
+   * Queues the next chunk of a batch on the libuv thread pool.
+   */
+  void queueBatchChunk(const std::shared_ptr<StreamBatch> &batch) {
+    v8::Local<v8::Array> data = Nan::New(batch->data);
+    uint32_t end = std::min(batch->next_item + BATCH_CHUNK_SIZE, batch->length);
+    BatchWorker *worker = new BatchWorker(batch, batch->next_item);
+
+    for (uint32_t i = batch->next_item; i < end; i++) {
+      Nan::Utf8String item(Nan::Get(data, i).ToLocalChecked());
+
+      worker->addItem(*item);
+    }
+    batch->next_item = end;
+    batch->pending++;
+
+    Nan::AsyncQueueWorker(worker);
+  }
+
+  /**
+   * Creates a batch of barcode streams asynchronously. The first argument is an array of the data to encode,
+   * followed by the same config arguments as `createStream()`. The last argument is a callback which receives
+   * an array of the objects `createStream()` would produce, in the same order as the data.
+   *
+   * The batch is rendered in chunks of `BATCH_CHUNK_SIZE` items, with at most one chunk per CPU queued on the libuv
+   * thread pool at a time, so that other work on the pool waits for a chunk at most rather than the whole batch.
+   * The data of each chunk is read from the array when the chunk is queued, so the array must not change until the
+   * callback is called.
+   */
+  void createStreams(const Nan::FunctionCallbackInfo<v8::Value>& args) {
+    Isolate* isolate = args.GetIsolate();
+    v8::Local<v8::Context> context = isolate->GetCurrentContext();
+
+    if (!args[0]->IsArray()) {
+      Nan::ThrowTypeError("createStreams() expects an array of data as its first argument.");
+      return;
+    }
+    if (!args[20]->IsFunction()) {
+      Nan::ThrowTypeError("createStreams() expects a callback as its last argument.");
+      return;
+    }
+
+    int rotate_angle = (int)args[18]->NumberValue(context).FromJust();
+    Nan::Callback *callback = new Nan::Callback(args[20].As<v8::Function>());
+    std::shared_ptr<StreamBatch> batch =
+      std::make_shared<StreamBatch>(callback, getSymbolFromArgs(context, args, 1), rotate_angle, args[0].As<v8::Array>());
+    size_t max_pending = std::max(std::thread::hardware_concurrency(), 1u);
+
+    if (getAddonData(args)->stats->enabled()) {
+      batch->stats = getAddonData(args)->stats;
+      batch->queued_at = monotonicMs();
+    }
+
+    // an empty batch still gets one (empty) chunk, so that its callback is called asynchronously
+    do {
+      queueBatchChunk(batch);
+    } while (batch->next_item < batch->length && batch->pending < max_pending);
+  }
+
+  /**
+   * Sets the byte budget of the instance's result cache (the first argument). A budget of 0 disables the cache.
+   */
+  void configureCache(const Nan::FunctionCallbackInfo<v8::Value>& args) {
+    v8::Local<v8::Context> context = args.GetIsolate()->GetCurrentContext();
+    double max_bytes = args[0]->NumberValue(context).FromJust();
+
+    if (!(max_bytes >= 0)) {
+      Nan::ThrowRangeError("configureCache() expects a byte budget of 0 or more.");
+      return;
+    }
+
+    getAddonData(args)->cache->setMaxBytes((size_t)max_bytes);
+  }
+
+  /**
+   * Removes all results from the instance's result cache (its counters are kept).
+   */
+  void clearCache(const Nan::FunctionCallbackInfo<v8::Value>& args) {
+    getAddonData(args)->cache->clear();
+  }
+
+  /**
+   * Returns the counters and size of the instance's result cache.
+   */
+  void getCacheStats(const Nan::FunctionCallbackInfo<v8::Value>& args) {
+    ResultCache *cache = getAddonData(args)->cache.get();
+    v8::Local<v8::Object> obj = Nan::New<v8::Object>();
+
+    Nan::Set(obj, Nan::New<String>("hits").ToLocalChecked(), Nan::New<v8::Number>((double)cache->getHits()));
+    Nan::Set(obj, Nan::New<String>("misses").ToLocalChecked(), Nan::New<v8::Number>((double)cache->getMisses()));
+    Nan::Set(obj, Nan::New<String>("entries").ToLocalChecked(), Nan::New<v8::Number>((double)cache->getEntries()));
+    Nan::Set(obj, Nan::New<String>("bytes").ToLocalChecked(), Nan::New<v8::Number>((double)cache->getBytes()));
+    Nan::Set(obj, Nan::New<String>("maxBytes").ToLocalChecked(), Nan::New<v8::Number>((double)cache->getMaxBytes()));
+
+    args.GetReturnValue().Set(obj);
+  }
+
+  /**
+   * Enables or disables the timing of renders by the instance (the first argument). While enabled, each result of
+   * `createStream()`, `createStreams()`, `createRenders()` and `Encoder.encode()` has the durations of its phases as
+   * `timings`, and they are added to the instance's stats.
+   */
+  void configureStats(const Nan::FunctionCallbackInfo<v8::Value>& args) {
+    getAddonData(args)->stats->setEnabled(args[0]->BooleanValue(args.GetIsolate()));
+  }
+
+  /**
+   * Resets the counters of the instance's stats.
+   */
+  void clearStats(const Nan::FunctionCallbackInfo<v8::Value>& args) {
+    getAddonData(args)->stats->clear();
+  }
+
+  /**
+   * Returns the counters of the instance's stats, with the count, total, maximum and histogram of the durations of
+   * each phase (see `Stats`).
+   */
+  void getStats(const Nan::FunctionCallbackInfo<v8::Value>& args) {
+    Stats *stats = getAddonData(args)->stats.get();
+    v8::Local<v8::Object> obj = Nan::New<v8::Object>();
+    v8::Local<v8::Object> phases = Nan::New<v8::Object>();
+
+    for (int i = 0; i < PHASE_COUNT; i++) {
+      const Stats::PhaseStats &phase = stats->getPhase(i);
+      v8::Local<v8::Object> phaseObj = Nan::New<v8::Object>();
+      v8::Local<v8::Array> histogram = Nan::New<v8::Array>(Stats::HISTOGRAM_BUCKETS);
+
+      for (int bucket = 0; bucket < Stats::HISTOGRAM_BUCKETS; bucket++) {
+        Nan::Set(histogram, (uint32_t)bucket, Nan::New<v8::Number>((double)phase.histogram[bucket]));
+      }
+
+      Nan::Set(phaseObj, Nan::New<String>("count").ToLocalChecked(), Nan::New<v8::Number>((double)phase.count));
+      Nan::Set(phaseObj, Nan::New<String>("totalMs").ToLocalChecked(), Nan::New<v8::Number>(phase.total_ms));
+      Nan::Set(phaseObj, Nan::New<String>("maxMs").ToLocalChecked(), Nan::New<v8::Number>(phase.max_ms));
+      Nan::Set(phaseObj, Nan::New<String>("histogram").ToLocalChecked(), histogram);
+      Nan::Set(phases, Nan::New<String>(PHASE_NAMES[i]).ToLocalChecked(), phaseObj);
+    }
+
+    Nan::Set(obj, Nan::New<String>("enabled").ToLocalChecked(), Nan::New<v8::Boolean>(stats->enabled()));
+    Nan::Set(obj, Nan::New<String>("renders").ToLocalChecked(), Nan::New<v8::Number>((double)stats->getRenders()));
+    Nan::Set(obj, Nan::New<String>("errors").ToLocalChecked(), Nan::New<v8::Number>((double)stats->getErrors()));
+    Nan::Set(obj, Nan::New<String>("phases").ToLocalChecked(), phases);
+
+    args.GetReturnValue().Set(obj);
+  }
+
+  void Init(v8::Local<v8::Object> exports) {
+    v8::Local<v8::Context> context = exports->CreationContext();
+    Isolate *isolate = context->GetIsolate();
+    AddonData *addonData = new AddonData();
+
+    // free this instance's data along with its environment
+    node::AddEnvironmentCleanupHook(isolate, deleteAddonData, addonData);
+
+    v8::Local<v8::External> data = Nan::New<v8::External>(addonData);
+
+    Encoder::Init(exports, addonData, data);
+
+    (void)exports->Set(context,
+      Nan::New("createStream").ToLocalChecked(),
+      Nan::New<v8::FunctionTemplate>(createStream, data)
+          ->GetFunction(context)
+          .ToLocalChecked());
+
+    (void)exports->Set(context,
+      Nan::New("createStreams").ToLocalChecked(),
+      Nan::New<v8::FunctionTemplate>(createStreams, data)
+          ->GetFunction(context)
+          .ToLocalChecked());
+
+    (void)exports->Set(context,
+      Nan::New("createRenders").ToLocalChecked(),
+      Nan::New<v8::FunctionTemplate>(createRenders, data)
+          ->GetFunction(context)
+          .ToLocalChecked());
+
+    (void)exports->Set(context,
+      Nan::New("createVector").ToLocalChecked(),
+      Nan::New<v8::FunctionTemplate>(createVector)
+          ->GetFunction(context)
+          .ToLocalChecked());
+
+    (void)exports->Set(context,
+      Nan::New("createRaster").ToLocalChecked(),
+      Nan::New<v8::FunctionTemplate>(createRaster)
+          ->GetFunction(context)
+          .ToLocalChecked());
+
+    (void)exports->Set(context,
+      Nan::New("encode").ToLocalChecked(),
+      Nan::New<v8::FunctionTemplate>(encode)
+          ->GetFunction(context)
+          .ToLocalChecked());
+
+    (void)exports->Set(context,
+      Nan::New("configureCache").ToLocalChecked(),
+      Nan::New<v8::FunctionTemplate>(configureCache, data)
+          ->GetFunction(context)
+          .ToLocalChecked());
+
+    (void)exports->Set(context,
+      Nan::New("clearCache").ToLocalChecked(),
+      Nan::New<v8::FunctionTemplate>(clearCache, data)
+          ->GetFunction(context)
+          .ToLocalChecked());
+
+    (void)exports->Set(context,
+      Nan::New("getCacheStats").ToLocalChecked(),
+      Nan::New<v8::FunctionTemplate>(getCacheStats, data)
+          ->GetFunction(context)
+          .ToLocalChecked());
+
+    (void)exports->Set(context,
+      Nan::New("configureStats").ToLocalChecked(),
+      Nan::New<v8::FunctionTemplate>(configureStats, data)
+          ->GetFunction(context)
+          .ToLocalChecked());
+
+    (void)exports->Set(context,
+      Nan::New("clearStats").ToLocalChecked(),
+      Nan::New<v8::FunctionTemplate>(clearStats, data)
+          ->GetFunction(context)
+          .ToLocalChecked());
+
+    (void)exports->Set(context,
+      Nan::New("getStats").ToLocalChecked(),
+      Nan::New<v8::FunctionTemplate>(getStats, data)
           ->GetFunction(context)
           .ToLocalChecked());
   }
 
-  NODE_MODULE(codify, Init);
+  // context-aware, so that the addon can be loaded by worker threads as well as by the main thread
+  NAN_MODULE_WORKER_ENABLED(codify, Init)
 }
@@ -0,0 +1,74 @@
+#include <string.h>
+#include <chrono>
+#include "stats.h"
+
+namespace codify {
+  const char *const PHASE_NAMES[PHASE_COUNT] = {
+    "queue", "convert", "encode", "plot", "output", "image", "dataUrl", "total"
+  };
+
+  double monotonicMs() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  Timings::Timings() {
+    for (int i = 0; i < PHASE_COUNT; i++) {
+      ms[i] = -1.0;
+    }
+  }
+
+  void Timings::setZintTimings(const zint_symbol *symbol) {
+    ms[PHASE_CONVERT] = symbol->timings.convert;
+    ms[PHASE_ENCODE] = symbol->timings.encode;
+    ms[PHASE_PLOT] = symbol->timings.plot;
+    ms[PHASE_OUTPUT] = symbol->timings.output;
+  }
+
+  Stats::Stats() : is_enabled(false) {
+    clear();
+  }
+
+  void Stats::record(const Timings &timings, int status_code) {
+    renders++;
+
+    if (status_code >= ZINT_ERROR) {
+      errors++;
+    }
+
+    for (int i = 0; i < PHASE_COUNT; i++) {
+      double ms = timings.ms[i];
+
+      // skip the phases which did not run
+      if (ms < 0) {
+        continue;
+      }
+
+      PhaseStats &phase = phases[i];
+
+      phase.count++;
+      phase.total_ms += ms;
+      phase.histogram[getBucket(ms)]++;
+
+      if (ms > phase.max_ms) {
+        phase.max_ms = ms;
+      }
+    }
+  }
+
+  void Stats::clear() {
+    renders = 0;
+    errors = 0;
+    memset(phases, 0, sizeof(phases));
+  }
+
+  int Stats::getBucket(double ms) {
+    double limit_us = 1.0;
+    int bucket = 0;
+
+    while (bucket < HISTOGRAM_BUCKETS - 1 && ms * 1000.0 >= limit_us) {
+      bucket++;
+      limit_us *= 2.0;
+    }
+    return bucket;
+  }
+}
@@ -0,0 +1,110 @@
+#ifndef CODIFY_STATS_H
+#define CODIFY_STATS_H
+
+#include <stdint.h>
+#include "../../.zint/backend/zint.h"
+
+namespace codify {
+  /**
+   * The phases of a render, in the order they run. `PHASE_CONVERT` to `PHASE_OUTPUT` are timed by zint itself
+   * (see `BARCODE_TIMINGS`); the others are timed by the binding.
+   */
+  enum Phase {
+    /** Waiting for a thread of the libuv thread pool */
+    PHASE_QUEUE,
+    /** Input processing (escapes, UTF-8, GS1 verification) */
+    PHASE_CONVERT,
+    /** Symbology encoding */
+    PHASE_ENCODE,
+    /** Raster or vector layout of the encoded symbol */
+    PHASE_PLOT,
+    /** Output of the layout (bitmap buffering or file writing) */
+    PHASE_OUTPUT,
+    /** Encoding the PNG file */
+    PHASE_IMAGE,
+    /** Encoding the image file as a base64 data URL */
+    PHASE_DATA_URL,
+    /** From queueing the render until its result is ready to be handled */
+    PHASE_TOTAL,
+    PHASE_COUNT
+  };
+
+  /** Names of the phases, as given to JS */
+  extern const char *const PHASE_NAMES[PHASE_COUNT];
+
+  /**
+   * Returns the current time of a monotonic clock, in milliseconds.
+   */
+  double monotonicMs();
+
+  /**
+   * The durations of the phases of one render, in milliseconds. Phases which did not run are negative.
+   */
+  struct Timings {
+    double ms[PHASE_COUNT];
+
+    Timings();
+
+    /**
+     * Copies the durations timed by zint (the symbol must have been rendered with `BARCODE_TIMINGS` set).
+     */
+    void setZintTimings(const zint_symbol *symbol);
+  };
+
+  /**
+   * Aggregate counters of the timed renders, with the count, total, maximum and a log2 histogram of the durations of
+   * each phase. It is not thread-safe: it must only be used from the JS thread of the addon instance that owns it.
+   */
+  class Stats {
+    public:
+      /** Bucket 0 counts durations under 1 µs, bucket `i` those from 2^(i-1) µs to under 2^i µs, and the last bucket any longer ones */
+      static const int HISTOGRAM_BUCKETS = 24;
+
+      struct PhaseStats {
+        uint64_t count;
+        double total_ms;
+        double max_ms;
+        uint64_t histogram[HISTOGRAM_BUCKETS];
+      };
+
+      Stats();
+
+      bool enabled() const {
+        return is_enabled;
+      }
+
+      /**
+       * Enables or disables the timing of renders. The counters are kept either way.
+       */
+      void setEnabled(bool enabled) {
+        is_enabled = enabled;
+      }
+
+      /**
+       * Adds the timings of a render, which failed if its status code is an error.
+       */
+      void record(const Timings &timings, int status_code);
+
+      /**
+       * Resets all counters.
+       */
+      void clear();
+
+      uint64_t getRenders() const { return renders; }
+      uint64_t getErrors() const { return errors; }
+      const PhaseStats &getPhase(int phase) const { return phases[phase]; }
+
+      /**
+       * Returns the histogram bucket of a duration, in milliseconds.
+       */
+      static int getBucket(double ms);
+
+    private:
+      bool is_enabled;
+      uint64_t renders;
+      uint64_t errors;
+      PhaseStats phases[PHASE_COUNT];
+  };
+}
+
+#endif
@@ -3,23 +3,49 @@ import DataMatrix from './types/enums/DataMatrix'
 import EncodingMode from './types/enums/EncodingMode'
 import OutputOption from './types/enums/OutputOption'
 import OutputType from './types/enums/OutputType'
-import { createStream, createFile } from './main'
+import RasterMode from './types/enums/RasterMode'
+import { createStream, createStreams, createFile, createFiles, createEncoder, createReadStream, createRenders, createVector, createRaster, encode, configureCache, clearCache, getCacheStats, configureStats, clearStats, getStats } from './main'
 
 export { default as SymbologyType } from './types/enums/SymbologyType'
 export { default as DataMatrix } from './types/enums/DataMatrix'
 export { default as EncodingMode } from './types/enums/EncodingMode'
 export { default as OutputOption } from './types/enums/OutputOption'
 export { default as OutputType } from './types/enums/OutputType'
+export { default as RasterMode } from './types/enums/RasterMode'
 export { default as SymbologyConfig } from './types/SymbologyConfig'
 export { default as SymbologyResult } from './types/SymbologyResult'
-export { createStream, createFile } from './main'
+export { default as SymbologyEncoder } from './types/SymbologyEncoder'
+export { default as CacheStats } from './types/CacheStats'
+export { default as RenderStats } from './types/RenderStats'
+export { default as RenderTimings } from './types/RenderTimings'
+export { default as RenderSpec } from './types/RenderSpec'
+export { default as StreamOptions } from './types/StreamOptions'
+export { default as SymbologyVector } from './types/SymbologyVector'
+export { default as SymbologyMatrix } from './types/SymbologyMatrix'
+export { default as SymbologyRaster } from './types/SymbologyRaster'
+export { createStream, createStreams, createFile, createFiles, createEncoder, createReadStream, createRenders, createVector, createRaster, encode, configureCache, clearCache, getCacheStats, configureStats, clearStats, getStats } from './main'
 
 export default {
     DataMatrix,
     EncodingMode,
     OutputOption,
     OutputType,
+    RasterMode,
     SymbologyType,
     createStream,
+    createStreams,
     createFile,
+    createFiles,
+    createEncoder,
+    createReadStream,
+    createRenders,
+    createVector,
+    createRaster,
+    encode,
+    configureCache,
+    clearCache,
+    getCacheStats,
+    configureStats,
+    clearStats,
+    getStats,
 }
@@ -1,5 +1,6 @@
 import EncodingMode from '../../types/enums/EncodingMode'
 import OutputType from '../../types/enums/OutputType'
+import RasterMode from '../../types/enums/RasterMode'
 import OutputOption from '../../types/enums/OutputOption'
 import binding from '../../binding'
 import binary from '../binary'
@@ -11,17 +12,18 @@ describe('Binary methods', () => {
     beforeEach(() => {
       jest
         .spyOn(binding, 'createStream')
-        .mockReturnValue({
+        .mockImplementation((...args: any[]) => args[args.length - 1]({
           message: 'Barcode created',
           code: 2,
           width: 32,
           height: 32,
-          bitmap: [],
+          bitmap: Buffer.alloc(0),
+          image: Buffer.alloc(0),
           encodedData: ''
-        })
+        }))
     })
 
-    it('should call createStream() with the arguments provided by the config', () => {
+    it('should call createStream() with the arguments provided by the config', async () => {
       const symbol = {
         symbology: 10,
         height: 30,
@@ -45,7 +47,7 @@ describe('Binary methods', () => {
       }
       const barcodeData = 'primary data'
 
-      binary.createBuffer(symbol, barcodeData)
+      await binary.createBuffer(symbol, barcodeData)
 
       expect(binding.createStream).toHaveBeenCalledWith(
         barcodeData,
@@ -67,11 +69,13 @@ describe('Binary methods', () => {
         symbol.eci,
         symbol.primary,
         symbol.rotation,
-        symbol.dotSize
+        symbol.dotSize,
+        expect.any(Function),
+        undefined
       )
     })
 
-    it('should fallback to default values for values missing in config', () => {
+    it('should fallback to default values for values missing in config', async () => {
       const symbol = {
         symbology: 10,
         height: 30,
@@ -95,7 +99,7 @@ describe('Binary methods', () => {
       }
       const barcodeData = 'primary data'
 
-      binary.createBuffer(symbol, barcodeData)
+      await binary.createBuffer(symbol, barcodeData)
 
       expect(binding.createStream).toHaveBeenCalledWith(
         barcodeData,
@@ -117,9 +121,157 @@ describe('Binary methods', () => {
         symbol.eci,
         symbol.primary,
         symbol.rotation,
-        symbol.dotSize
+        symbol.dotSize,
+        expect.any(Function),
+        undefined
       )
     })
+
+    it('should resolve with the result passed to the native callback', async () => {
+      expect.assertions(1)
+
+      await expect(binary.createBuffer({ symbology: 10 }, '12345')).resolves.toEqual({
+        message: 'Barcode created',
+        code: 2,
+        width: 32,
+        height: 32,
+        bitmap: Buffer.alloc(0),
+        image: Buffer.alloc(0),
+        encodedData: ''
+      })
+    })
+
+    it('should pass the MIME type of the data URL to create to the native function', async () => {
+      await binary.createBuffer({ symbology: 10 }, '12345', 'image/gif')
+
+      expect((binding.createStream as jest.Mock).mock.calls[0][21]).toEqual('image/gif')
+    })
+
+    it('should resolve with a cached result returned by the native function', async () => {
+      const cached = {
+        message: 'Cached',
+        code: 0,
+        width: 32,
+        height: 32,
+        bitmap: Buffer.alloc(0),
+        image: Buffer.from([0x89]),
+        encodedData: ''
+      }
+
+      jest
+        .spyOn(binding, 'createStream')
+        .mockReturnValue(cached)
+
+      await expect(binary.createBuffer({ symbology: 10 }, '12345')).resolves.toBe(cached)
+    })
+  })
+
+  describe('createBuffers()', () => {
+    const result = {
+      message: 'Barcode created',
+      code: 2,
+      width: 32,
+      height: 32,
+      bitmap: Buffer.alloc(0),
+      image: Buffer.alloc(0),
+      encodedData: ''
+    }
+
+    beforeEach(() => {
+      jest
+        .spyOn(binding, 'createStreams')
+        .mockImplementation((...args: any[]) => args[args.length - 1](args[0].map(() => result)))
+    })
+
+    it('should call createStreams() once with the data array and the arguments provided by the config', async () => {
+      const dataArray = ['12345', '67890']
+
+      await binary.createBuffers({ symbology: 10, text: 'example text' }, dataArray)
+
+      expect(binding.createStreams).toHaveBeenCalledTimes(1)
+      expect(binding.createStreams).toHaveBeenCalledWith(
+        dataArray,
+        10,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        0,
+        'example text',
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        expect.any(Function)
+      )
+    })
+
+    it('should resolve with the results passed to the native callback', async () => {
+      expect.assertions(1)
+
+      await expect(binary.createBuffers({ symbology: 10 }, ['1', '2'])).resolves.toEqual([result, result])
+    })
+  })
+
+  describe('invokeAll()', () => {
+    const result = {
+      code: 0,
+      message: 'Success',
+      bitmap: Buffer.alloc(0),
+      image: Buffer.alloc(0),
+      encodedData: '<encoded data>',
+      width: 10,
+      height: 15
+    }
+
+    it('should resolve with every result in order, including failures', async () => {
+      const failure = { ...result, code: 5, message: 'Failure' }
+
+      jest
+        .spyOn(binary, 'createBuffers')
+        .mockResolvedValue([{ ...result }, failure])
+
+      expect.assertions(1)
+
+      await expect(binary.invokeAll({ symbology: 10 }, ['1', '2'], OutputType.SVG)).resolves.toEqual([
+        { ...result, message: 'Codify successfully created.' },
+        failure
+      ])
+    })
+
+    it('should render the batch into memory for non-PNG images', async () => {
+      const config = {
+        symbology: 10,
+        outputOptions: OutputOption.BARCODE_BIND
+      }
+      const dataArray = ['1', '2']
+
+      jest
+        .spyOn(binary, 'createBuffers')
+        .mockResolvedValue([])
+
+      await binary.invokeAll(config, dataArray, OutputType.EPS)
+
+      expect(binary.createBuffers).toHaveBeenCalledWith({
+        ...config,
+        fileName: 'out.eps',
+        outputOptions: config.outputOptions | OutputOption.BARCODE_MEMORY_FILE
+      }, dataArray)
+    })
+
+    it('should reject if the output type is not supported', async () => {
+      expect.assertions(1)
+
+      await expect(binary.invokeAll({ symbology: 10 }, ['1'], 'jpg' as OutputType)).rejects.toEqual('Invalid output type: jpg')
+    })
   })
 
   describe('invoke()', () => {
@@ -127,7 +279,8 @@ describe('Binary methods', () => {
       const result = {
         code: 0,
         message: 'Success',
-        bitmap: [],
+        bitmap: Buffer.alloc(0),
+        image: Buffer.alloc(0),
         encodedData: '<encoded data>',
         width: 10,
         height: 15
@@ -136,7 +289,7 @@ describe('Binary methods', () => {
       beforeEach(() => {
         jest
           .spyOn(binary, 'createBuffer')
-          .mockReturnValue(result)
+          .mockResolvedValue(result)
       })
 
       it('should resolve with the resulting binary data when symbology is successfully rendered', async () => {
@@ -150,7 +303,7 @@ describe('Binary methods', () => {
         })
       })
 
-      it('should apply bitmap output option (8) to existing output options for non-PNG images', async () => {
+      it('should apply the memory file output option to existing output options for non-PNG images', async () => {
         const config = {
           symbology: 10,
           outputOptions: OutputOption.BARCODE_BIND
@@ -163,11 +316,11 @@ describe('Binary methods', () => {
         expect(binary.createBuffer).toHaveBeenCalledWith({
           ...config,
           fileName: 'out.svg',
-          outputOptions: config.outputOptions + 8
-        }, barcodeData)
+          outputOptions: config.outputOptions | OutputOption.BARCODE_MEMORY_FILE
+        }, barcodeData, undefined)
       })
 
-      it('should set the output options to bitmap output (8) to non-PNG images wth no previous output specified', async () => {
+      it('should set the output options to the memory file option for non-PNG images with no previous output specified', async () => {
         const config = {
           symbology: 10,
           outputOptions: 0
@@ -180,8 +333,36 @@ describe('Binary methods', () => {
         expect(binary.createBuffer).toHaveBeenCalledWith({
           ...config,
           fileName: 'out.svg',
-          outputOptions: 8
-        }, barcodeData)
+          outputOptions: OutputOption.BARCODE_MEMORY_FILE
+        }, barcodeData, undefined)
+      })
+
+      it('should render other image files into memory with the memory file option', async () => {
+        const config = {
+          symbology: 10,
+          outputOptions: 0
+        }
+        const barcodeData = '12345'
+
+        await binary.invoke(config, barcodeData, OutputType.TIFF)
+
+        expect(binary.createBuffer).toHaveBeenCalledWith({
+          ...config,
+          fileName: 'out.tif',
+          outputOptions: OutputOption.BARCODE_MEMORY_FILE
+        }, barcodeData, undefined)
+      })
+
+      it('should request a data URL of the MIME type of the output type', async () => {
+        await binary.invoke({ symbology: 10 }, '12345', OutputType.GIF, true)
+
+        expect(binary.createBuffer).toHaveBeenCalledWith(expect.anything(), '12345', 'image/gif')
+      })
+
+      it('should not request a data URL for text output types', async () => {
+        await binary.invoke({ symbology: 10 }, '12345', OutputType.SVG, true)
+
+        expect(binary.createBuffer).toHaveBeenCalledWith(expect.anything(), '12345', undefined)
       })
 
       it('should not mutate the output options for PNG images', async () => {
@@ -195,8 +376,9 @@ describe('Binary methods', () => {
 
         expect(binary.createBuffer).toHaveBeenCalledTimes(1)
         expect(binary.createBuffer).toHaveBeenCalledWith({
-          ...config
-        }, barcodeData)
+          ...config,
+          fileName: 'out.png'
+        }, barcodeData, undefined)
       })
     })
 
@@ -205,7 +387,8 @@ describe('Binary methods', () => {
         const result = {
           code: 1,
           message: 'Created with warnings',
-          bitmap: [],
+          bitmap: Buffer.alloc(0),
+          image: Buffer.alloc(0),
           encodedData: '<encoded data>',
           width: 10,
           height: 15
@@ -213,7 +396,7 @@ describe('Binary methods', () => {
 
         jest
           .spyOn(binary, 'createBuffer')
-          .mockReturnValue(result)
+          .mockResolvedValue(result)
 
         expect.assertions(1)
 
@@ -228,7 +411,8 @@ describe('Binary methods', () => {
         const result = {
           code: 3,
           message: 'Failure',
-          bitmap: [],
+          bitmap: Buffer.alloc(0),
+          image: Buffer.alloc(0),
           encodedData: '<encoded data>',
           width: 10,
           height: 15
@@ -236,7 +420,7 @@ describe('Binary methods', () => {
 
         jest
           .spyOn(binary, 'createBuffer')
-          .mockReturnValue(result)
+          .mockResolvedValue(result)
 
         expect.assertions(1)
 
@@ -247,6 +431,492 @@ describe('Binary methods', () => {
     })
   })
 
+  describe('invokeRenders()', () => {
+    const result = {
+      code: 0,
+      message: 'Success',
+      bitmap: Buffer.alloc(0),
+      image: Buffer.alloc(0),
+      encodedData: '<svg></svg>',
+      width: 10,
+      height: 10
+    }
+    const config = {
+      symbology: 20,
+      outputOptions: OutputOption.BARCODE_BIND,
+      scale: 1,
+      rotation: 0,
+      foregroundColor: '000000',
+      backgroundColor: 'FFFFFF'
+    }
+
+    it('should pass the native render options of each spec, falling back to the config', async () => {
+      jest
+        .spyOn(binding, 'createRenders')
+        .mockImplementation((...args: any[]) => args[args.length - 1]([result, result]))
+
+      await binary.invokeRenders(config, '12345', [
+        { outputType: OutputType.PNG, scale: 4 },
+        { outputType: OutputType.SVG, rotation: 90, foregroundColor: 'FF0000' }
+      ])
+
+      const args = (binding.createRenders as jest.Mock).mock.calls[0]
+
+      // the render specs are passed after the data and the 19 config arguments, before the callback
+      expect(args[0]).toEqual('12345')
+      expect(args[21]).toEqual(expect.any(Function))
+      expect(args[20]).toEqual([{
+          fileName: 'out.png',
+          outputOptions: OutputOption.BARCODE_BIND,
+          scale: 4,
+          rotation: 0,
+          foregroundColor: '000000',
+          backgroundColor: 'FFFFFF'
+        }, {
+          fileName: 'out.svg',
+          outputOptions: OutputOption.BARCODE_BIND | OutputOption.BARCODE_MEMORY_FILE,
+          scale: 1,
+          rotation: 90,
+          foregroundColor: 'FF0000',
+          backgroundColor: 'FFFFFF'
+        }])
+    })
+
+    it('should resolve with the result of each render', async () => {
+      jest
+        .spyOn(binary, 'createRenderBuffers')
+        .mockResolvedValue([{ ...result }, { ...result, code: 2, message: 'Warning' }])
+
+      await expect(binary.invokeRenders(config, '12345', [
+        { outputType: OutputType.SVG },
+        { outputType: OutputType.SVG }
+      ])).resolves.toEqual([
+        { ...result, message: 'Codify successfully created.' },
+        { ...result, code: 2, message: 'Warning' }
+      ])
+    })
+
+    it('should reject with the message of a failed render', async () => {
+      jest
+        .spyOn(binary, 'createRenderBuffers')
+        .mockResolvedValue([{ ...result }, { ...result, code: 6, message: 'Failure' }])
+
+      expect.assertions(1)
+
+      await expect(binary.invokeRenders(config, '12345', [
+        { outputType: OutputType.SVG },
+        { outputType: OutputType.SVG }
+      ])).rejects.toEqual('Failure')
+    })
+
+    it('should reject if the output type of a spec is not supported', async () => {
+      expect.assertions(1)
+
+      await expect(binary.invokeRenders(config, '12345', [
+        { outputType: 'jpg' as OutputType }
+      ])).rejects.toEqual('Invalid output type: jpg')
+    })
+  })
+
+  describe('invokeVector()', () => {
+    const vector = {
+      width: 20,
+      height: 10,
+      rectangles: new Float32Array([0, 0, 2, 10, -1]),
+      hexagons: new Float32Array(0),
+      circles: new Float32Array(0),
+      strings: new Float32Array([10, 9, 7, 20, 0, 0]),
+      texts: ['12345'],
+      message: '',
+      code: 0
+    }
+
+    it('should call createVector() with the data and the arguments provided by the config', async () => {
+      jest
+        .spyOn(binding, 'createVector')
+        .mockImplementation((...args: any[]) => args[args.length - 1]({ ...vector }))
+
+      await binary.invokeVector({ symbology: 20, rotation: 90 }, '12345')
+
+      expect(binding.createVector).toHaveBeenCalledWith(
+        '12345',
+        20,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        0,
+        '12345',
+        undefined,
+        undefined,
+        undefined,
+        90,
+        undefined,
+        expect.any(Function)
+      )
+    })
+
+    it('should resolve with the vector geometry when the symbology is successfully encoded', async () => {
+      jest
+        .spyOn(binary, 'createVectorBuffer')
+        .mockResolvedValue({ ...vector })
+
+      await expect(binary.invokeVector({ symbology: 20 }, '12345')).resolves.toEqual({
+        ...vector,
+        message: 'Codify successfully created.'
+      })
+    })
+
+    it('should reject if the status code is greater than 2', async () => {
+      jest
+        .spyOn(binary, 'createVectorBuffer')
+        .mockResolvedValue({ ...vector, code: 5, message: 'Failure' })
+
+      expect.assertions(1)
+
+      await expect(binary.invokeVector({ symbology: 20 }, '12345')).rejects.toEqual('Failure')
+    })
+  })
+
+  describe('invokeRaster()', () => {
+    const raster = {
+      width: 2,
+      height: 1,
+      stride: 8,
+      pixels: Buffer.from([0, 0, 0, 255, 255, 255, 255, 0]),
+      palette: Buffer.alloc(0),
+      message: '',
+      code: 0
+    }
+
+    it('should call createRaster() with the data, the arguments provided by the config and the mode', async () => {
+      jest
+        .spyOn(binding, 'createRaster')
+        .mockImplementation((...args: any[]) => args[20]({ ...raster }))
+
+      await binary.invokeRaster({ symbology: 20, rotation: 90 }, '12345', RasterMode.RGBA)
+
+      expect(binding.createRaster).toHaveBeenCalledWith(
+        '12345',
+        20,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        0,
+        '12345',
+        undefined,
+        undefined,
+        undefined,
+        90,
+        undefined,
+        expect.any(Function),
+        RasterMode.RGBA
+      )
+    })
+
+    it('should resolve with the pixels and their mode when the symbology is successfully rendered', async () => {
+      jest
+        .spyOn(binding, 'createRaster')
+        .mockImplementation((...args: any[]) => args[20]({ ...raster }))
+
+      await expect(binary.invokeRaster({ symbology: 20 }, '12345', RasterMode.RGBA)).resolves.toEqual({
+        ...raster,
+        mode: RasterMode.RGBA,
+        message: 'Codify successfully created.'
+      })
+    })
+
+    it('should pass an indexed raster mode to createRaster()', async () => {
+      jest
+        .spyOn(binding, 'createRaster')
+        .mockImplementation((...args: any[]) => args[20]({ ...raster }))
+
+      await expect(binary.invokeRaster({ symbology: 20 }, '12345', RasterMode.MONO)).resolves.toMatchObject({
+        mode: RasterMode.MONO
+      })
+      expect((binding.createRaster as jest.Mock).mock.calls[0][21]).toEqual('mono')
+    })
+
+    it('should reject if the status code is greater than 2', async () => {
+      jest
+        .spyOn(binary, 'createRasterBuffer')
+        .mockResolvedValue({ ...raster, mode: RasterMode.RGBA, code: 5, message: 'Failure' })
+
+      expect.assertions(1)
+
+      await expect(binary.invokeRaster({ symbology: 20 }, '12345', RasterMode.RGBA)).rejects.toEqual('Failure')
+    })
+  })
+
+  describe('invokeMatrix()', () => {
+    const matrix = {
+      rows: 1,
+      width: 11,
+      stride: 2,
+      height: 50,
+      modules: Buffer.from([0x8b, 0x01]),
+      colours: Buffer.alloc(0),
+      rowHeights: new Float32Array([50]),
+      message: '',
+      code: 0
+    }
+
+    it('should call encode() with the data and the arguments provided by the config', async () => {
+      jest
+        .spyOn(binding, 'encode')
+        .mockImplementation((...args: any[]) => args[args.length - 1]({ ...matrix }))
+
+      await binary.invokeMatrix({ symbology: 20, option1: 2 }, '12345')
+
+      expect(binding.encode).toHaveBeenCalledWith(
+        '12345',
+        20,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        2,
+        undefined,
+        undefined,
+        0,
+        '12345',
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        expect.any(Function)
+      )
+    })
+
+    it('should resolve with the module matrix when the symbology is successfully encoded', async () => {
+      jest
+        .spyOn(binary, 'createMatrixBuffer')
+        .mockResolvedValue({ ...matrix })
+
+      await expect(binary.invokeMatrix({ symbology: 20 }, '12345')).resolves.toEqual({
+        ...matrix,
+        message: 'Codify successfully created.'
+      })
+    })
+
+    it('should keep the message of a symbology encoded with a warning', async () => {
+      jest
+        .spyOn(binary, 'createMatrixBuffer')
+        .mockResolvedValue({ ...matrix, code: 2, message: 'Warning' })
+
+      await expect(binary.invokeMatrix({ symbology: 20 }, '12345')).resolves.toEqual({
+        ...matrix,
+        code: 2,
+        message: 'Warning'
+      })
+    })
+
+    it('should reject if the status code is greater than 2', async () => {
+      jest
+        .spyOn(binary, 'createMatrixBuffer')
+        .mockResolvedValue({ ...matrix, code: 6, message: 'Failure' })
+
+      expect.assertions(1)
+
+      await expect(binary.invokeMatrix({ symbology: 20 }, '12345')).rejects.toEqual('Failure')
+    })
+  })
+
+  describe('createEncoder()', () => {
+    const result = {
+      code: 0,
+      message: 'Success',
+      bitmap: Buffer.alloc(0),
+      image: Buffer.alloc(0),
+      encodedData: '<encoded data>',
+      width: 10,
+      height: 15
+    }
+    const encode = jest.fn()
+
+    beforeEach(() => {
+      encode.mockImplementation((data: string, callback: Function) => callback({ ...result }))
+
+      jest
+        .spyOn(binding, 'Encoder')
+        .mockImplementation(() => ({ encode }) as any)
+    })
+
+    it('should construct the native encoder once with the config arguments for the output type', async () => {
+      const config = {
+        symbology: 10,
+        outputOptions: OutputOption.BARCODE_BIND,
+        text: 'example text'
+      }
+
+      const encoder = binary.createEncoder(config, OutputType.SVG)
+
+      await encoder.encode('12345')
+      await encoder.encode('67890')
+
+      expect(binding.Encoder).toHaveBeenCalledTimes(1)
+      expect(binding.Encoder).toHaveBeenCalledWith(
+        config.symbology,
+        undefined,
+        undefined,
+        undefined,
+        config.outputOptions | OutputOption.BARCODE_MEMORY_FILE,
+        undefined,
+        undefined,
+        'out.svg',
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        0,
+        config.text,
+        undefined,
+        undefined,
+        undefined,
+        undefined,
+        undefined
+      )
+      expect(encode).toHaveBeenCalledTimes(2)
+      expect(encode).toHaveBeenCalledWith('12345', expect.any(Function), undefined)
+      expect(encode).toHaveBeenCalledWith('67890', expect.any(Function), undefined)
+    })
+
+    it('should request a data URL of the MIME type of the output type from the native encoder', async () => {
+      await binary.createEncoder({ symbology: 10 }, OutputType.PNG).encode('12345', true)
+
+      expect(encode).toHaveBeenCalledWith('12345', expect.any(Function), 'image/png')
+    })
+
+    it('should resolve with the resulting binary data when symbology is successfully rendered', async () => {
+      expect.assertions(1)
+
+      await expect(binary.createEncoder({
+        symbology: 10
+      }, OutputType.PNG).encode('12345')).resolves.toEqual({
+        ...result,
+        message: 'Codify successfully created.'
+      })
+    })
+
+    it('should resolve with a cached result returned by the native encoder', async () => {
+      encode.mockImplementation(() => ({ ...result, message: 'Cached', code: 2 }))
+
+      await expect(binary.createEncoder({
+        symbology: 10
+      }, OutputType.PNG).encode('12345')).resolves.toEqual({
+        ...result,
+        message: 'Cached',
+        code: 2
+      })
+    })
+
+    it('should reject if the status code is greater than 2', async () => {
+      encode.mockImplementation((data: string, callback: Function) => callback({ ...result, code: 5, message: 'Failure' }))
+
+      expect.assertions(1)
+
+      await expect(binary.createEncoder({
+        symbology: 10
+      }, OutputType.PNG).encode('12345')).rejects.toEqual('Failure')
+    })
+
+    it('should throw if the output type is not supported', () => {
+      expect(() => binary.createEncoder({
+        symbology: 10
+      }, 'jpg' as OutputType)).toThrow('Invalid output type: jpg')
+    })
+  })
+
+  describe('result cache', () => {
+    it('should set the byte budget of the native cache', () => {
+      jest
+        .spyOn(binding, 'configureCache')
+        .mockReturnValue()
+
+      binary.configureCache(1024)
+
+      expect(binding.configureCache).toHaveBeenCalledWith(1024)
+    })
+
+    it('should clear the native cache', () => {
+      jest
+        .spyOn(binding, 'clearCache')
+        .mockReturnValue()
+
+      binary.clearCache()
+
+      expect(binding.clearCache).toHaveBeenCalledTimes(1)
+    })
+
+    it('should return the stats of the native cache', () => {
+      const stats = { hits: 1, misses: 2, entries: 1, bytes: 100, maxBytes: 1024 }
+
+      jest
+        .spyOn(binding, 'getCacheStats')
+        .mockReturnValue(stats)
+
+      expect(binary.getCacheStats()).toEqual(stats)
+    })
+  })
+
+  describe('render stats', () => {
+    it('should enable the native render stats', () => {
+      jest
+        .spyOn(binding, 'configureStats')
+        .mockReturnValue()
+
+      binary.configureStats(true)
+
+      expect(binding.configureStats).toHaveBeenCalledWith(true)
+    })
+
+    it('should clear the native render stats', () => {
+      jest
+        .spyOn(binding, 'clearStats')
+        .mockReturnValue()
+
+      binary.clearStats()
+
+      expect(binding.clearStats).toHaveBeenCalledTimes(1)
+    })
+
+    it('should return the native render stats', () => {
+      const phase = { count: 0, totalMs: 0, maxMs: 0, histogram: [] }
+      const stats = {
+        enabled: false,
+        renders: 0,
+        errors: 0,
+        phases: { queue: phase, convert: phase, encode: phase, plot: phase, output: phase, image: phase, dataUrl: phase, total: phase }
+      }
+
+      jest
+        .spyOn(binding, 'getStats')
+        .mockReturnValue(stats)
+
+      expect(binary.getStats()).toEqual(stats)
+    })
+  })
+
   describe('getOutputType()', () => {
     it('should return PNG for a file with a .png extension', () => {
       expect(binary.getOutputType('out.PNG')).toEqual(OutputType.PNG)
@@ -260,8 +930,40 @@ describe('Binary methods', () => {
       expect(binary.getOutputType('out.EPS')).toEqual(OutputType.EPS)
     })
 
+    it('should return the type of each image file extension', () => {
+      expect(binary.getOutputType('out.gif')).toEqual(OutputType.GIF)
+      expect(binary.getOutputType('out.TIF')).toEqual(OutputType.TIFF)
+      expect(binary.getOutputType('out.tiff')).toEqual(OutputType.TIFF)
+      expect(binary.getOutputType('out.bmp')).toEqual(OutputType.BMP)
+      expect(binary.getOutputType('out.pcx')).toEqual(OutputType.PCX)
+      expect(binary.getOutputType('out.emf')).toEqual(OutputType.EMF)
+    })
+
     it('should fall back to PNG for an unrecognized file extension', () => {
-      expect(binary.getOutputType('out.tiff')).toEqual(OutputType.PNG)
+      expect(binary.getOutputType('out.jpg')).toEqual(OutputType.PNG)
+    })
+  })
+
+  describe('getMimeType()', () => {
+    it('should return the MIME type of image files', () => {
+      expect(binary.getMimeType(OutputType.PNG)).toEqual('image/png')
+      expect(binary.getMimeType(OutputType.TIFF)).toEqual('image/tiff')
+    })
+
+    it('should return undefined for SVG and EPS', () => {
+      expect(binary.getMimeType(OutputType.SVG)).toBeUndefined()
+    })
+  })
+
+  describe('isTextOutput()', () => {
+    it('should return true for SVG and EPS', () => {
+      expect(binary.isTextOutput(OutputType.SVG)).toEqual(true)
+      expect(binary.isTextOutput(OutputType.EPS)).toEqual(true)
+    })
+
+    it('should return false for image files', () => {
+      expect(binary.isTextOutput(OutputType.PNG)).toEqual(false)
+      expect(binary.isTextOutput(OutputType.EMF)).toEqual(false)
     })
   })
 })
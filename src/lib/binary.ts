@@ -1,20 +1,45 @@
 import codify from '../binding'
 import BinResult from '../types/BinResult'
+import CacheStats from '../types/CacheStats'
+import OutputOption from '../types/enums/OutputOption'
 import OutputType from '../types/enums/OutputType'
+import RasterMode from '../types/enums/RasterMode'
+import RenderSpec from '../types/RenderSpec'
+import RenderStats from '../types/RenderStats'
 import SymbologyConfig from '../types/SymbologyConfig'
+import SymbologyMatrix from '../types/SymbologyMatrix'
+import SymbologyRaster from '../types/SymbologyRaster'
+import SymbologyVector from '../types/SymbologyVector'
 
 /**
- * Calls the given function name from the c++ library wrapper, validates
- * the struct values and passes the arguments sent in symbologyStruct
- * in the correct order.
+ * Native encoder with a preconverted symbology config (see `createEncoder()`).
+ */
+type BinEncoder = {
+  /** Encodes and renders the given data, with its image file as a `dataUrl` if `dataUrl` is set */
+  encode (barcodeData: string, dataUrl?: boolean): Promise<BinResult>
+}
+
+/**
+ * MIME types of the image file of each output type, used for their data URLs
+ */
+const mimeTypes: { [outputType: string]: string } = {
+  [OutputType.PNG]: 'image/png',
+  [OutputType.GIF]: 'image/gif',
+  [OutputType.TIFF]: 'image/tiff',
+  [OutputType.BMP]: 'image/bmp',
+  [OutputType.PCX]: 'image/x-pcx',
+  [OutputType.EMF]: 'image/emf'
+}
+
+/**
+ * Returns the arguments of the symbology config in the order expected by the c++ library wrapper.
  *
  * @param {SymbologyConfig} config - symbology config
- * @param {string} barcodeData - primary data to encode
- * @return {BinResult}
+ * @param {string} text - human-readable text
+ * @returns {any[]}
  */
-function createBuffer (config: SymbologyConfig, barcodeData: string): BinResult {
-  return codify.createStream(
-    barcodeData,
+function getConfigArgs (config: SymbologyConfig, text: string): any[] {
+  return [
     config.symbology,
     config.height,
     config.whitespaceWidth,
@@ -22,70 +47,391 @@ function createBuffer (config: SymbologyConfig, barcodeData: string): BinResult
     config.outputOptions,
     config.backgroundColor,
     config.foregroundColor,
-    // indicate to the library that we want BMP instead of PNG
-    // this is to force zint to return a bitmap array buffer instead PNG binary
-    config.fileName?.replace(/\.png$/g, '.bmp'),
+    config.fileName,
     config.scale,
     config.option1,
     config.option2,
     config.option3,
     config.showHumanReadableText ? 1 : 0,
-    (config.text || barcodeData),
+    text,
     config.encoding,
     config.eci,
     config.primary,
     config.rotation,
     config.dotSize
-  )
+  ]
 }
 
 /**
- * Renders a png, svg, or eps barcode.
- * If PNG, it returns the stream as a base64 string.
+ * Calls the given function name from the c++ library wrapper, validates
+ * the struct values and passes the arguments sent in symbologyStruct
+ * in the correct order.
  *
- * @note The file will be created in memory and then passed to the returned object.
+ * @note The symbology is encoded and rendered on the libuv thread pool, unless its result is cached.
+ * If a MIME type is given, the image file is also base64-encoded there, and passed as `dataUrl` instead of `image`.
+ *
+ * @param {SymbologyConfig} config - symbology config
+ * @param {string} barcodeData - primary data to encode
+ * @param {string} [mimeType] - MIME type of the data URL of the image file to create, if any
+ * @return {Promise<BinResult>}
+ */
+function createBuffer (config: SymbologyConfig, barcodeData: string, mimeType?: string): Promise<BinResult> {
+  return new Promise(resolve => {
+    const cached = codify.createStream(
+      barcodeData,
+      ...getConfigArgs(config, config.text || barcodeData),
+      resolve,
+      mimeType
+    )
+
+    // a cached result is returned right away, instead of being passed to the callback
+    if (cached) {
+      resolve(cached)
+    }
+  })
+}
+
+/**
+ * Calls the c++ library wrapper once to encode and render each of the given data with the same config.
+ * The items are rendered in parallel, in chunks queued on the libuv thread pool.
+ *
+ * @param {SymbologyConfig} config - symbology config
+ * @param {string[]} dataArray - primary data of each symbology to encode
+ * @return {Promise<BinResult[]>} results in the same order as `dataArray`
+ */
+function createBuffers (config: SymbologyConfig, dataArray: string[]): Promise<BinResult[]> {
+  // the binding reads the data chunk by chunk, so keep the caller from changing it meanwhile
+  const data = dataArray.slice()
+
+  return new Promise(resolve => codify.createStreams(
+    data,
+    ...getConfigArgs(config, config.text || ''),
+    resolve
+  ))
+}
+
+/**
+ * Calls the c++ library wrapper once to encode the given data, and then render it with each of the given specs.
+ * Each spec must have the native render options (see `getRenderSpec()`).
+ *
+ * @param {SymbologyConfig} config - symbology config
+ * @param {string} barcodeData - primary data to encode
+ * @param {object[]} specs - native render options of each render
+ * @return {Promise<BinResult[]>} results in the same order as `specs`
+ */
+function createRenderBuffers (config: SymbologyConfig, barcodeData: string, specs: object[]): Promise<BinResult[]> {
+  return new Promise(resolve => codify.createRenders(
+    barcodeData,
+    ...getConfigArgs(config, config.text || barcodeData),
+    specs,
+    resolve
+  ))
+}
+
+/**
+ * Calls the c++ library wrapper to encode the given data and buffer its vector geometry, rather than render a file.
+ *
+ * @param {SymbologyConfig} config - symbology config
+ * @param {string} barcodeData - primary data to encode
+ * @return {Promise<SymbologyVector>}
+ */
+function createVectorBuffer (config: SymbologyConfig, barcodeData: string): Promise<SymbologyVector> {
+  return new Promise(resolve => codify.createVector(
+    barcodeData,
+    ...getConfigArgs(config, config.text || barcodeData),
+    resolve
+  ))
+}
+
+/**
+ * Calls the c++ library wrapper to encode and buffer the given data, returning its raster pixels in the given mode.
+ *
+ * @param {SymbologyConfig} config - symbology config
+ * @param {string} barcodeData - primary data to encode
+ * @param {RasterMode} mode - pixel format
+ * @return {Promise<SymbologyRaster>}
+ */
+function createRasterBuffer (config: SymbologyConfig, barcodeData: string, mode: RasterMode): Promise<SymbologyRaster> {
+  return new Promise<Omit<SymbologyRaster, 'mode'>>(resolve => codify.createRaster(
+    barcodeData,
+    ...getConfigArgs(config, config.text || barcodeData),
+    resolve,
+    mode
+  )).then(res => ({ ...res, mode }))
+}
+
+/**
+ * Calls the c++ library wrapper to encode the given data only, returning its module matrix.
  *
  * @param {SymbologyConfig} config - symbology config
  * @param {string} barcodeData - primary data to encode
+ * @return {Promise<SymbologyMatrix>}
+ */
+function createMatrixBuffer (config: SymbologyConfig, barcodeData: string): Promise<SymbologyMatrix> {
+  return new Promise(resolve => codify.encode(
+    barcodeData,
+    ...getConfigArgs(config, config.text || barcodeData),
+    resolve
+  ))
+}
+
+/**
+ * Returns a copy of the config with the file name and output options that render the given output type.
+ * Throws if the output type is not supported.
+ *
+ * @param {SymbologyConfig} config - symbology config
  * @param {OutputType} outputType
- * @returns {Promise<BinResult>} object with resulting props (see docs)
+ * @returns {SymbologyConfig}
  */
-function invoke (config: SymbologyConfig, barcodeData: string, outputType: OutputType): Promise<BinResult> {
+function getOutputConfig (config: SymbologyConfig, outputType: OutputType): SymbologyConfig {
   const symbol = { ...config }
 
-  if (![OutputType.PNG, OutputType.EPS, OutputType.SVG].includes(outputType)) {
-    return Promise.reject(`Invalid output type: ${outputType}`)
+  if (!Object.values(OutputType).includes(outputType)) {
+    throw `Invalid output type: ${outputType}`
   }
 
-  if (outputType !== OutputType.PNG) {
-    symbol.fileName = `out.${outputType}`
+  // the native layer determines what to render by the file extension; files are written by the caller
+  symbol.fileName = `out.${outputType}`
 
-    // apply option 8 (suppress stdout)
-    if (symbol.outputOptions) {
-      symbol.outputOptions += 8
-    } else {
-      symbol.outputOptions = 8
-    }
+  if (outputType !== OutputType.PNG) {
+    // apply the memory file option, so the file is rendered into memory rather than written to disk
+    symbol.outputOptions = (symbol.outputOptions || 0) | OutputOption.BARCODE_MEMORY_FILE
   }
 
-  const res = binary.createBuffer(symbol, barcodeData)
+  return symbol
+}
 
-  if (res.code <= 2) {
-    // remove all data after the trailing EOF marker
-    res.encodedData = res
-      .encodedData
-      .split('<<< EOF >>>')[0]
+/**
+ * Returns the native render options of a render spec, falling back to the config for those it does not specify.
+ * Throws if the output type is not supported.
+ *
+ * @param {SymbologyConfig} config - symbology config
+ * @param {RenderSpec} spec - render spec
+ * @returns {object}
+ */
+function getRenderSpec (config: SymbologyConfig, spec: RenderSpec): object {
+  const symbol = getOutputConfig(config, spec.outputType)
 
-    if (res.code === 0) {
-      res.message = 'Codify successfully created.'
-    }
+  return {
+    fileName: symbol.fileName,
+    outputOptions: symbol.outputOptions,
+    scale: spec.scale ?? symbol.scale,
+    rotation: spec.rotation ?? symbol.rotation,
+    foregroundColor: spec.foregroundColor ?? symbol.foregroundColor,
+    backgroundColor: spec.backgroundColor ?? symbol.backgroundColor
+  }
+}
 
-    return Promise.resolve(res)
+/**
+ * Resolves with the native result if the symbology was rendered (with or without warnings), or rejects with its message.
+ *
+ * @param {BinResult} res - native result
+ * @returns {Promise<BinResult>}
+ */
+function getResult (res: BinResult): Promise<BinResult> {
+  if (res.code <= 2) {
+    return Promise.resolve(setSuccessMessage(res))
   }
 
   return Promise.reject(res.message)
 }
 
+/**
+ * Resolves with a native result which is not a rendered file (e.g. vector geometry) if the symbology was encoded
+ * (with or without warnings), or rejects with its message.
+ *
+ * @param {T} res - native result
+ * @returns {Promise<T>}
+ */
+function getEncodedResult<T extends { message: string, code: number }> (res: T): Promise<T> {
+  if (res.code > 2) {
+    return Promise.reject(res.message)
+  }
+
+  if (res.code === 0) {
+    res.message = 'Codify successfully created.'
+  }
+
+  return Promise.resolve(res)
+}
+
+/**
+ * Sets the message of a result rendered without warnings.
+ *
+ * @param {BinResult} res - native result
+ * @returns {BinResult}
+ */
+function setSuccessMessage (res: BinResult): BinResult {
+  if (res.code === 0) {
+    res.message = 'Codify successfully created.'
+  }
+
+  return res
+}
+
+/**
+ * Renders a barcode in any of the output types.
+ * SVG and EPS are returned as text in `encodedData`; the files of all other types are returned in `image`.
+ *
+ * @note The file will be created in memory and then passed to the returned object.
+ *
+ * @param {SymbologyConfig} config - symbology config
+ * @param {string} barcodeData - primary data to encode
+ * @param {OutputType} outputType
+ * @param {boolean} [dataUrl] - whether to pass an image file as a base64 `dataUrl` instead of as `image`
+ * @returns {Promise<BinResult>} object with resulting props (see docs)
+ */
+async function invoke (config: SymbologyConfig, barcodeData: string, outputType: OutputType, dataUrl = false): Promise<BinResult> {
+  const symbol = getOutputConfig(config, outputType)
+  const res = await binary.createBuffer(symbol, barcodeData, dataUrl ? getMimeType(outputType) : undefined)
+
+  return getResult(res)
+}
+
+/**
+ * Renders a batch of barcodes with the same config and output type.
+ * Unlike `invoke()`, a symbology that fails to render does not reject; its status is given by its `code`.
+ *
+ * @param {SymbologyConfig} config - symbology config
+ * @param {string[]} dataArray - primary data of each symbology to encode
+ * @param {OutputType} outputType
+ * @returns {Promise<BinResult[]>} results in the same order as `dataArray`
+ */
+async function invokeAll (config: SymbologyConfig, dataArray: string[], outputType: OutputType): Promise<BinResult[]> {
+  const symbol = getOutputConfig(config, outputType)
+  const results = await binary.createBuffers(symbol, dataArray)
+
+  return results.map(setSuccessMessage)
+}
+
+/**
+ * Encodes a barcode once, and renders it with each of the given render specs.
+ * Rejects with the message of the first render that failed, if any.
+ *
+ * @param {SymbologyConfig} config - symbology config
+ * @param {string} barcodeData - primary data to encode
+ * @param {RenderSpec[]} specs - output type, scale, rotation and colours of each render
+ * @returns {Promise<BinResult[]>} results in the same order as `specs`
+ */
+async function invokeRenders (config: SymbologyConfig, barcodeData: string, specs: RenderSpec[]): Promise<BinResult[]> {
+  const renderSpecs = specs.map(spec => getRenderSpec(config, spec))
+  const results = await binary.createRenderBuffers(config, barcodeData, renderSpecs)
+
+  return Promise.all(results.map(getResult))
+}
+
+/**
+ * Encodes a barcode and returns its vector geometry, packed into typed arrays.
+ *
+ * @param {SymbologyConfig} config - symbology config
+ * @param {string} barcodeData - primary data to encode
+ * @returns {Promise<SymbologyVector>} vector geometry, or rejects with the message if the symbology failed to encode
+ */
+async function invokeVector (config: SymbologyConfig, barcodeData: string): Promise<SymbologyVector> {
+  const res = await binary.createVectorBuffer(config, barcodeData)
+
+  return getEncodedResult(res)
+}
+
+/**
+ * Encodes a barcode without rendering it, and returns its bit-packed module matrix and row heights.
+ *
+ * @param {SymbologyConfig} config - symbology config
+ * @param {string} barcodeData - primary data to encode
+ * @returns {Promise<SymbologyMatrix>} module matrix, or rejects with the message if the symbology failed to encode
+ */
+async function invokeMatrix (config: SymbologyConfig, barcodeData: string): Promise<SymbologyMatrix> {
+  const res = await binary.createMatrixBuffer(config, barcodeData)
+
+  return getEncodedResult(res)
+}
+
+/**
+ * Encodes and buffers a barcode and returns its raster pixels, merged natively into the given pixel format.
+ *
+ * @param {SymbologyConfig} config - symbology config
+ * @param {string} barcodeData - primary data to encode
+ * @param {RasterMode} mode - pixel format
+ * @returns {Promise<SymbologyRaster>} raster pixels, or rejects with the message if the symbology failed to render
+ */
+async function invokeRaster (config: SymbologyConfig, barcodeData: string, mode: RasterMode): Promise<SymbologyRaster> {
+  const res = await binary.createRasterBuffer(config, barcodeData, mode)
+
+  return getEncodedResult(res)
+}
+
+/**
+ * Creates a native encoder for the given config and output type. The config is converted and validated
+ * once, so that each `encode()` only passes the data to encode to the native layer.
+ *
+ * @param {SymbologyConfig} config - symbology config
+ * @param {OutputType} outputType
+ * @returns {BinEncoder}
+ */
+function createEncoder (config: SymbologyConfig, outputType: OutputType): BinEncoder {
+  const encoder = new codify.Encoder(...getConfigArgs(getOutputConfig(config, outputType), config.text || ''))
+
+  return {
+    encode: (barcodeData: string, dataUrl = false) => new Promise<BinResult>(resolve => {
+      const cached = encoder.encode(barcodeData, resolve, dataUrl ? getMimeType(outputType) : undefined)
+
+      if (cached) {
+        resolve(cached)
+      }
+    }).then(getResult)
+  }
+}
+
+/**
+ * Sets the byte budget of the native result cache. A budget of 0 disables the cache (the default).
+ *
+ * @param {number} maxBytes
+ */
+function configureCache (maxBytes: number): void {
+  codify.configureCache(maxBytes)
+}
+
+/**
+ * Removes all results from the native result cache.
+ */
+function clearCache (): void {
+  codify.clearCache()
+}
+
+/**
+ * Returns the counters and size of the native result cache.
+ *
+ * @returns {CacheStats}
+ */
+function getCacheStats (): CacheStats {
+  return codify.getCacheStats()
+}
+
+/**
+ * Enables or disables the timing of native renders (disabled by default).
+ *
+ * @param {boolean} enabled
+ */
+function configureStats (enabled: boolean): void {
+  codify.configureStats(enabled)
+}
+
+/**
+ * Resets the counters of the native render stats.
+ */
+function clearStats (): void {
+  codify.clearStats()
+}
+
+/**
+ * Returns the counters and phase histograms of the timed native renders.
+ *
+ * @returns {RenderStats}
+ */
+function getStats (): RenderStats {
+  return codify.getStats()
+}
+
 /**
  * Determines the OutputType of the given file name by its extension. Defaults to PNG.
  *
@@ -93,20 +439,71 @@ function invoke (config: SymbologyConfig, barcodeData: string, outputType: Outpu
  * @returns {OutputType}
  */
 function getOutputType (fileName: string): OutputType {
-  switch (fileName.toLowerCase().substr(-3)) {
+  switch (fileName.toLowerCase().split('.').pop()) {
     case 'svg':
       return OutputType.SVG
     case 'eps':
       return OutputType.EPS
+    case 'gif':
+      return OutputType.GIF
+    case 'tif':
+    case 'tiff':
+      return OutputType.TIFF
+    case 'bmp':
+      return OutputType.BMP
+    case 'pcx':
+      return OutputType.PCX
+    case 'emf':
+      return OutputType.EMF
     default:
       return OutputType.PNG
   }
 }
 
+/**
+ * Returns whether the given output type is rendered as text (SVG or EPS) in `encodedData`, rather than as an
+ * image file in `image`.
+ *
+ * @param {OutputType} outputType
+ * @returns {boolean}
+ */
+function isTextOutput (outputType: OutputType): boolean {
+  return outputType === OutputType.SVG || outputType === OutputType.EPS
+}
+
+/**
+ * Returns the MIME type of the image file of the given output type, or undefined if it is rendered as text.
+ *
+ * @param {OutputType} outputType
+ * @returns {string | undefined}
+ */
+function getMimeType (outputType: OutputType): string | undefined {
+  return mimeTypes[outputType]
+}
+
 const binary = {
   createBuffer,
+  createBuffers,
+  createRenderBuffers,
+  createVectorBuffer,
+  createRasterBuffer,
+  createMatrixBuffer,
   invoke,
-  getOutputType
+  invokeAll,
+  invokeRenders,
+  invokeVector,
+  invokeRaster,
+  invokeMatrix,
+  createEncoder,
+  configureCache,
+  clearCache,
+  getCacheStats,
+  configureStats,
+  clearStats,
+  getStats,
+  getOutputType,
+  getMimeType,
+  isTextOutput
 }
 
 export default binary
@@ -1,11 +1,22 @@
 import fs from 'fs'
+import { Readable } from 'stream'
 import binary from './lib/binary'
 import png from './lib/png'
 import EncodingMode from './types/enums/EncodingMode'
 import OutputOption from './types/enums/OutputOption'
 import OutputType from './types/enums/OutputType'
+import RasterMode from './types/enums/RasterMode'
+import BinResult from './types/BinResult'
+import CacheStats from './types/CacheStats'
+import RenderSpec from './types/RenderSpec'
+import RenderStats from './types/RenderStats'
 import SymbologyConfig from './types/SymbologyConfig'
+import SymbologyEncoder from './types/SymbologyEncoder'
+import StreamOptions from './types/StreamOptions'
+import SymbologyMatrix from './types/SymbologyMatrix'
+import SymbologyRaster from './types/SymbologyRaster'
 import SymbologyResult from './types/SymbologyResult'
+import SymbologyVector from './types/SymbologyVector'
 
 /**
  * Default Symbology config, populated with default values
@@ -31,11 +42,35 @@ const defaultConfig: SymbologyConfig = {
 }
 
 /**
- * Renders a symbology image as a string in SVG, EPS, or base64-encoded PNG format.
+ * Converts the native result of a rendered output type to a SymbologyResult.
+ *
+ * @param {BinResult} res - native result
+ * @param {OutputType} outputType
+ * @returns {SymbologyResult}
+ */
+function getStreamResult (res: BinResult, outputType: OutputType): SymbologyResult {
+  const result: SymbologyResult = {
+    // the image file is rendered natively, and usually base64-encoded there too (see `dataUrl`)
+    data: binary.isTextOutput(outputType)
+      ? res.encodedData
+      : res.dataUrl || png.toBase64(res.image, binary.getMimeType(outputType)),
+    width: res.width,
+    height: res.height,
+    message: res.message
+  }
+
+  if (res.timings) {
+    result.timings = res.timings
+  }
+  return result
+}
+
+/**
+ * Renders a symbology image as a string in SVG or EPS format, or as a base64 data URL of any other output type.
  *
  * @param {SymbologyConfig} config - symbology configuration
  * @param {string} barcodeData - data to encode
- * @param {OutputType} outputType - `png`, `eps`, or `svg`.
+ * @param {OutputType} outputType - format to render (see `OutputType`)
  * @returns {Promise<SymbologyResult>} object with resulting props (see docs)
  */
 export async function createStream (config: SymbologyConfig, barcodeData: string, outputType: OutputType = OutputType.PNG): Promise<SymbologyResult> {
@@ -44,31 +79,227 @@ export async function createStream (config: SymbologyConfig, barcodeData: string
     ...config,
     fileName: `out.${outputType}`
   }
-  const res = await binary.invoke(symbol, barcodeData, outputType)
+  const res = await binary.invoke(symbol, barcodeData, outputType, true)
+
+  return getStreamResult(res, outputType)
+}
+
+/**
+ * Encodes a symbology once, and renders it with each of the given render specs (output type, scale, rotation and
+ * colours), in the same format as `createStream()`. Only the rendering is repeated for each spec, so this is much
+ * faster than calling `createStream()` for each of them.
+ *
+ * @param {SymbologyConfig} config - symbology configuration
+ * @param {string} barcodeData - data to encode
+ * @param {RenderSpec[]} specs - output type of each render, and the options that override the config's
+ * @returns {Promise<SymbologyResult[]>} results in the same order as `specs`
+ */
+export async function createRenders (config: SymbologyConfig, barcodeData: string, specs: RenderSpec[]): Promise<SymbologyResult[]> {
+  const results = await binary.invokeRenders({ ...defaultConfig, ...config }, barcodeData, specs)
+
+  return results.map((res, i) => getStreamResult(res, specs[i].outputType))
+}
+
+/**
+ * Encodes a symbology and returns its vector geometry (rectangles, hexagons, circles and strings) as packed typed
+ * arrays, so that it can be drawn directly (e.g. to a canvas or PDF) without rendering and parsing an SVG.
+ *
+ * @param {SymbologyConfig} config - symbology configuration
+ * @param {string} barcodeData - data to encode
+ * @returns {Promise<SymbologyVector>} vector geometry (see docs)
+ */
+export async function createVector (config: SymbologyConfig, barcodeData: string): Promise<SymbologyVector> {
+  return binary.invokeVector({ ...defaultConfig, ...config }, barcodeData)
+}
+
+/**
+ * Renders a symbology to raw raster pixels in the given pixel format, e.g. to draw it onto a canvas or to composite it
+ * into another image. The pixels are produced natively (with the alpha of the configured colours), so they need no
+ * processing in JS.
+ *
+ * @param {SymbologyConfig} config - symbology configuration
+ * @param {string} barcodeData - data to encode
+ * @param {RasterMode} mode - pixel format (see `RasterMode`)
+ * @returns {Promise<SymbologyRaster>} raster pixels (see docs)
+ */
+export async function createRaster (config: SymbologyConfig, barcodeData: string, mode: RasterMode = RasterMode.RGBA): Promise<SymbologyRaster> {
+  return binary.invokeRaster({ ...defaultConfig, ...config }, barcodeData, mode)
+}
+
+/**
+ * Encodes a symbology without rendering it, and returns its logical module matrix (one bit per module) and the
+ * height of each row, for callers who lay the symbology out themselves (e.g. in a PDF or ZPL stream).
+ *
+ * @param {SymbologyConfig} config - symbology configuration
+ * @param {string} barcodeData - data to encode
+ * @returns {Promise<SymbologyMatrix>} module matrix (see docs)
+ */
+export async function encode (config: SymbologyConfig, barcodeData: string): Promise<SymbologyMatrix> {
+  return binary.invokeMatrix({ ...defaultConfig, ...config }, barcodeData)
+}
+
+/**
+ * Renders each item of a (possibly async) iterable of data as a symbology image, in the same format as `createStream()`,
+ * and returns an object-mode Readable of the results in the same order as the data.
+ *
+ * @note At most `options.concurrency` symbologies are rendered at once, and the source is only read while the consumer
+ * keeps up, so memory use does not grow with the size of the source. A symbology that fails to render destroys the
+ * stream with its message.
+ *
+ * @param {SymbologyConfig} config - symbology configuration
+ * @param {Iterable<string> | AsyncIterable<string>} source - data of each symbology to encode
+ * @param {OutputType} outputType - format to render (see `OutputType`)
+ * @param {StreamOptions} options - concurrency and whether to emit raw image Buffers
+ * @returns {Readable} stream of SymbologyResult objects, or of Buffers if `options.raw` is set
+ */
+export function createReadStream (config: SymbologyConfig, source: Iterable<string> | AsyncIterable<string>, outputType: OutputType = OutputType.PNG, options: StreamOptions = {}): Readable {
+  const encoder = binary.createEncoder({ ...defaultConfig, ...config }, outputType)
+  const concurrency = Math.max(1, options.concurrency || Number(process.env.UV_THREADPOOL_SIZE) || 4)
+  const iterator = Symbol.asyncIterator in source
+    ? (source as AsyncIterable<string>)[Symbol.asyncIterator]()
+    : (source as Iterable<string>)[Symbol.iterator]()
+  const pending: Array<Promise<SymbologyResult | Buffer>> = []
+  let exhausted = false
+  let reading = false
+
+  const render = async (barcodeData: string): Promise<SymbologyResult | Buffer> => {
+    const res = await encoder.encode(barcodeData, !options.raw)
+
+    if (options.raw) {
+      return binary.isTextOutput(outputType) ? Buffer.from(res.encodedData) : res.image
+    }
+
+    return getStreamResult(res, outputType)
+  }
+
+  // starts rendering the next items of the source until `concurrency` of them are in flight
+  const fill = async () => {
+    while (!exhausted && pending.length < concurrency) {
+      const next = await iterator.next()
+
+      if (next.done) {
+        exhausted = true
+      } else {
+        const result = render(next.value)
 
-  if (outputType === OutputType.PNG) {
-    // write the bitmap to a base64-encoded PNG string
-    const image = png.render(res.bitmap, res.width, res.height, symbol.backgroundColor, symbol.foregroundColor)
-    const base64Data = await png.blobToBase64(image)
+        // failures are handled when the result is reached in order; don't report them as unhandled before then
+        result.catch(() => {})
+        pending.push(result)
+      }
+    }
+  }
+
+  return new Readable({
+    objectMode: true,
+    highWaterMark: concurrency,
+    async read () {
+      if (reading) {
+        return
+      }
+
+      reading = true
+
+      try {
+        let wanted = true
+
+        while (wanted && !this.destroyed) {
+          await fill()
+
+          const result = pending.shift()
+
+          if (!result) {
+            this.push(null)
+            break
+          }
+
+          wanted = this.push(await result)
+        }
+      } catch (err) {
+        this.destroy(err instanceof Error ? err : new Error(String(err)))
+      }
+
+      reading = false
+    },
+    destroy (err, callback) {
+      if (!exhausted && iterator.return) {
+        // let the source release its resources (e.g. close a cursor)
+        Promise.resolve(iterator.return()).catch(() => {})
+      }
+
+      exhausted = true
+      callback(err)
+    }
+  })
+}
+
+/**
+ * Converts the native result of one symbology of a batch to a SymbologyResult, which includes its status code.
+ * Symbologies that failed to render only have their message and code.
+ *
+ * @param {BinResult} res - native result
+ * @param {OutputType} outputType - format to render (see `OutputType`)
+ * @returns {SymbologyResult}
+ */
+function getBatchResult (res: BinResult, outputType: OutputType): SymbologyResult {
+  if (res.code > 2) {
+    const result: SymbologyResult = {
+      width: 0,
+      height: 0,
+      message: res.message,
+      code: res.code
+    }
 
-    return {
-      data: base64Data,
-      width: res.width,
-      height: res.height,
-      message: res.message
+    if (res.timings) {
+      result.timings = res.timings
     }
+    return result
   }
 
   return {
-    data: res.encodedData,
-    width: res.width,
-    height: res.height,
-    message: res.message
+    ...getStreamResult(res, outputType),
+    code: res.code
   }
 }
 
 /**
- * Creates a symbology image file of a PNG, SVG or EPS file in the specified `fileName` path.
+ * Renders a batch of symbology images with the same config, in the same format as `createStream()`.
+ * All of the data is rendered by one native call, in parallel across all CPUs.
+ *
+ * @note Each symbology has its own status `code`; one failing to render does not reject the batch.
+ *
+ * @param {SymbologyConfig} config - symbology configuration
+ * @param {string[]} dataArray - data of each symbology to encode
+ * @param {OutputType} outputType - format to render (see `OutputType`)
+ * @returns {Promise<SymbologyResult[]>} results in the same order as `dataArray`
+ */
+export async function createStreams (config: SymbologyConfig, dataArray: string[], outputType: OutputType = OutputType.PNG): Promise<SymbologyResult[]> {
+  const symbol: SymbologyConfig = {
+    ...defaultConfig,
+    ...config
+  }
+  const results = await binary.invokeAll(symbol, dataArray, outputType)
+
+  return results.map(res => getBatchResult(res, outputType))
+}
+
+/**
+ * Creates an encoder which renders symbology images with the same config, in the same format as `createStream()`.
+ * The config is converted and validated once, which saves its setup on each render.
+ *
+ * @param {SymbologyConfig} config - symbology configuration
+ * @param {OutputType} outputType - format to render (see `OutputType`)
+ * @returns {SymbologyEncoder} encoder with an `encode(barcodeData)` method
+ */
+export function createEncoder (config: SymbologyConfig, outputType: OutputType = OutputType.PNG): SymbologyEncoder {
+  const encoder = binary.createEncoder({ ...defaultConfig, ...config }, outputType)
+
+  return {
+    encode: async (barcodeData: string) => getStreamResult(await encoder.encode(barcodeData, true), outputType)
+  }
+}
+
+/**
+ * Creates a symbology image file of any output type (PNG, SVG, EPS, GIF, TIF, BMP, PCX or EMF) in the specified `fileName` path.
  *
  * @param {SymbologyConfig} config - symbology configuration
  * @param {string} barcodeData - data to encode
@@ -87,15 +318,12 @@ export async function createFile (config: SymbologyConfig, barcodeData: string):
   const outputType = binary.getOutputType(symbol.fileName)
   const res = await binary.invoke(symbol, barcodeData, outputType)
 
-  if (outputType === OutputType.PNG) {
-    // write the bitmap to a PNG image file
-    const image = png.render(res.bitmap, res.width, res.height, symbol.backgroundColor, symbol.foregroundColor)
-    const buffer = png.getBuffer(image)
-
-    fs.writeFileSync(symbol.fileName, buffer)
-  } else {
+  if (binary.isTextOutput(outputType)) {
     // write SVG or EPS to a file
     fs.writeFileSync(symbol.fileName, res.encodedData)
+  } else {
+    // write the natively-encoded image (PNG, GIF, TIF, BMP, PCX or EMF) to a file
+    fs.writeFileSync(symbol.fileName, res.image)
   }
 
   return {
@@ -104,3 +332,103 @@ export async function createFile (config: SymbologyConfig, barcodeData: string):
     message: res.message
   }
 }
+
+/**
+ * Creates a batch of symbology image files with the same config. The type of each file is determined by the
+ * extension of its `fileName`, and each type is rendered by one native call, in parallel across all CPUs.
+ *
+ * @note Each file has its own status `code`; one failing to render does not reject the batch.
+ *
+ * @param {SymbologyConfig} config - symbology configuration
+ * @param {Array<{ fileName: string, data: string }>} files - path and data to encode of each file
+ * @returns {Promise<SymbologyResult[]>} results in the same order as `files`
+ */
+export async function createFiles (config: SymbologyConfig, files: Array<{ fileName: string, data: string }>): Promise<SymbologyResult[]> {
+  const symbol: SymbologyConfig = {
+    ...defaultConfig,
+    ...config
+  }
+  const results: SymbologyResult[] = new Array(files.length)
+  const outputTypes = files.map(file => binary.getOutputType(file.fileName))
+
+  for (const outputType of new Set(outputTypes)) {
+    const indices = files.map((file, i) => i).filter(i => outputTypes[i] === outputType)
+    const batch = await binary.invokeAll(symbol, indices.map(i => files[i].data), outputType)
+
+    batch.forEach((res, j) => {
+      const i = indices[j]
+
+      if (res.code <= 2) {
+        fs.writeFileSync(files[i].fileName, binary.isTextOutput(outputType) ? res.encodedData : res.image)
+      }
+
+      results[i] = {
+        width: res.code <= 2 ? res.width : 0,
+        height: res.code <= 2 ? res.height : 0,
+        message: res.message,
+        code: res.code
+      }
+    })
+  }
+
+  return results
+}
+
+/**
+ * Enables, resizes or disables the result cache. When enabled, the output of each `createStream()` and
+ * `SymbologyEncoder.encode()` render is kept (up to `maxBytes` in total, least recently used first out), and a
+ * render with exactly the same config, data and output type is answered from the cache without encoding it again.
+ *
+ * @note The cache is disabled by default, and is separate for each thread (e.g. worker thread) using this module.
+ *
+ * @param {{ maxBytes: number }} options - byte budget of the cache; 0 disables it
+ */
+export function configureCache (options: { maxBytes: number }): void {
+  binary.configureCache(options.maxBytes)
+}
+
+/**
+ * Removes all results from the result cache.
+ */
+export function clearCache (): void {
+  binary.clearCache()
+}
+
+/**
+ * Returns the hit and miss counters and the size of the result cache.
+ *
+ * @returns {CacheStats}
+ */
+export function getCacheStats (): CacheStats {
+  return binary.getCacheStats()
+}
+
+/**
+ * Enables or disables the timing of renders. When enabled, each result of `createStream()`, `createStreams()`,
+ * `createRenders()` and `SymbologyEncoder.encode()` has the durations of the phases of its render as `timings`
+ * (results answered from the cache are not rendered, so they have none), and they are added up in `getStats()`.
+ *
+ * @note Stats are disabled by default, and are separate for each thread (e.g. worker thread) using this module.
+ *
+ * @param {{ enabled: boolean }} options
+ */
+export function configureStats (options: { enabled: boolean }): void {
+  binary.configureStats(options.enabled)
+}
+
+/**
+ * Resets the counters of the render stats.
+ */
+export function clearStats (): void {
+  binary.clearStats()
+}
+
+/**
+ * Returns the render and error counters of the timed renders, and the count, total, maximum and histogram of the
+ * durations of each phase.
+ *
+ * @returns {RenderStats}
+ */
+export function getStats (): RenderStats {
+  return binary.getStats()
+}
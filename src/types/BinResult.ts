@@ -1,6 +1,12 @@
+import RenderTimings from './RenderTimings'
+
 type BinResult = {
-  /** Buffer output of bitmap data */
-  bitmap: number[]
+  /** Buffer output of RGB bitmap data (3 bytes per pixel) */
+  bitmap: Uint8Array
+  /** Buffer output of an encoded image file (PNG, GIF, TIF, BMP, PCX or EMF) */
+  image: Uint8Array
+  /** Base64 data URL of the image file, if requested (the image file is then not passed as `image`) */
+  dataUrl?: string
   /** Buffer output of SVG or EPS data */
   encodedData: string
   /** Width of the rendered symbology */
@@ -11,6 +17,8 @@ type BinResult = {
   message: string
   /** Code produced by the library during render */
   code: number
+  /** Durations of the phases of the render, in milliseconds, if stats are enabled */
+  timings?: RenderTimings
 }
 
 export default BinResult
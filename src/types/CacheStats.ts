@@ -0,0 +1,14 @@
+type CacheStats = {
+  /** Number of renders answered from the cache */
+  hits: number
+  /** Number of renders looked up in the cache but not found (and rendered) */
+  misses: number
+  /** Number of results held by the cache */
+  entries: number
+  /** Approximate number of bytes held by the cache */
+  bytes: number
+  /** Byte budget of the cache (0 if disabled) */
+  maxBytes: number
+}
+
+export default CacheStats
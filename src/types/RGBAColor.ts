@@ -1,8 +0,0 @@
-type RGBAColor = {
-  red: number
-  green: number
-  blue: number
-  alpha?: number
-}
-
-export default RGBAColor
@@ -0,0 +1,16 @@
+import OutputType from './enums/OutputType'
+
+type RenderSpec = {
+  /** Output type to render */
+  outputType: OutputType
+  /** Scale factor of the render. Defaults to the config's `scale` */
+  scale?: number
+  /** Rotation of the render (0, 90, 180 or 270). Defaults to the config's `rotation` */
+  rotation?: number
+  /** Foreground colour of the render. Defaults to the config's `foregroundColor` */
+  foregroundColor?: string
+  /** Background colour of the render. Defaults to the config's `backgroundColor` */
+  backgroundColor?: string
+}
+
+export default RenderSpec
@@ -0,0 +1,35 @@
+type PhaseStats = {
+  /** Number of renders in which the phase ran */
+  count: number
+  /** Total duration of the phase, in milliseconds */
+  totalMs: number
+  /** Longest duration of the phase, in milliseconds */
+  maxMs: number
+  /**
+   * Counts of the durations of the phase by powers of two of microseconds: bucket 0 counts those under 1 µs,
+   * bucket `i` those from 2^(i-1) µs to under 2^i µs, and the last bucket any longer ones
+   */
+  histogram: number[]
+}
+
+type RenderStats = {
+  /** Whether renders are being timed */
+  enabled: boolean
+  /** Number of timed renders */
+  renders: number
+  /** Number of timed renders which failed */
+  errors: number
+  /** Stats of each phase of the timed renders (see `RenderTimings`) */
+  phases: {
+    queue: PhaseStats
+    convert: PhaseStats
+    encode: PhaseStats
+    plot: PhaseStats
+    output: PhaseStats
+    image: PhaseStats
+    dataUrl: PhaseStats
+    total: PhaseStats
+  }
+}
+
+export default RenderStats
@@ -0,0 +1,20 @@
+type RenderTimings = {
+  /** Time spent waiting for a thread of the libuv thread pool */
+  queue: number
+  /** Input processing (escapes, UTF-8, GS1 verification) */
+  convert: number
+  /** Symbology encoding */
+  encode: number
+  /** Raster or vector layout of the encoded symbology (absent if the encode failed) */
+  plot?: number
+  /** Output of the layout, i.e. buffering its bitmap or writing its file (absent if the encode failed) */
+  output?: number
+  /** Encoding the PNG file (PNG only) */
+  image?: number
+  /** Encoding the image file as a base64 data URL (image output types only) */
+  dataUrl?: number
+  /** Time from queueing the render until its result was ready */
+  total: number
+}
+
+export default RenderTimings
@@ -0,0 +1,8 @@
+type StreamOptions = {
+  /** Maximum number of symbologies being rendered natively at once. Defaults to the size of the libuv thread pool */
+  concurrency?: number
+  /** Emit the raw image file of each symbology as a Buffer, rather than a SymbologyResult */
+  raw?: boolean
+}
+
+export default StreamOptions
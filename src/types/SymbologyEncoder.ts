@@ -0,0 +1,8 @@
+import SymbologyResult from './SymbologyResult'
+
+type SymbologyEncoder = {
+  /** Renders the given data with the encoder's config and output type */
+  encode (barcodeData: string): Promise<SymbologyResult>
+}
+
+export default SymbologyEncoder
@@ -0,0 +1,28 @@
+type SymbologyMatrix = {
+  /** Number of rows of modules */
+  rows: number
+  /** Number of modules in each row */
+  width: number
+  /** Number of bytes of each row in `modules` */
+  stride: number
+  /** Height of the symbology in X-dimensions (the sum of `rowHeights`) */
+  height: number
+  /**
+   * One bit per module, row-major, with each row padded to `stride` bytes. Module `(row, column)` is dark if
+   * `(modules[row * stride + (column >> 3)] >> (column & 7)) & 1` is set.
+   */
+  modules: Uint8Array
+  /**
+   * Ultracode only (empty otherwise): the colour of each module at `row * width + column`, where 0 is none and
+   * 1-8 are Cyan, Blue, Magenta, Red, Yellow, Green, Black and White.
+   */
+  colours: Uint8Array
+  /** Height of each row in X-dimensions */
+  rowHeights: Float32Array
+  /** Messages produced by the library during encoding */
+  message: string
+  /** Status code produced by the library during encoding */
+  code: number
+}
+
+export default SymbologyMatrix
@@ -0,0 +1,25 @@
+import RasterMode from './enums/RasterMode'
+
+type SymbologyRaster = {
+  /** Pixel format of `pixels` */
+  mode: RasterMode
+  /** Width of the rendered symbology, in pixels */
+  width: number
+  /** Height of the rendered symbology, in pixels */
+  height: number
+  /** Number of bytes of each row in `pixels` */
+  stride: number
+  /** Pixels of the rendered symbology, row-major from the top left, in the format of `mode` */
+  pixels: Uint8Array
+  /**
+   * Indexed modes only (empty otherwise): the RGBA value of each colour, 4 bytes each. Colour 0 is the background
+   * and colour 1 the foreground; Ultracode modules have their own colours after them.
+   */
+  palette: Uint8Array
+  /** Messages produced by the library during render */
+  message: string
+  /** Status code produced by the library during render */
+  code: number
+}
+
+export default SymbologyRaster
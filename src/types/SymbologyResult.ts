@@ -1,3 +1,5 @@
+import RenderTimings from './RenderTimings'
+
 type SymbologyResult = {
   /** String output of symbology graphics */
   data?: string
@@ -7,6 +9,10 @@ type SymbologyResult = {
   height: number
   /** Messages produced by the library during render */
   message: string
+  /** Status code produced by the library during render (batch renders only) */
+  code?: number
+  /** Durations of the phases of the render, in milliseconds, if stats are enabled (see `configureStats()`) */
+  timings?: RenderTimings
 }
 
 export default SymbologyResult
@@ -0,0 +1,31 @@
+type SymbologyVector = {
+  /** Width of the symbology, including its text and whitespace */
+  width: number
+  /** Height of the symbology, including its text and whitespace */
+  height: number
+  /**
+   * Rectangles (bars and modules), packed as `x, y, width, height, colour` for each rectangle.
+   * A colour of -1 is the foreground colour; 1-8 are Cyan, Blue, Magenta, Red, Yellow, Green, Black and White.
+   */
+  rectangles: Float32Array
+  /** Hexagons (MaxiCode modules), packed as `x, y, diameter, rotation` for each hexagon */
+  hexagons: Float32Array
+  /**
+   * Circles (dots, and the MaxiCode bullseye), packed as `x, y, diameter, width, colour` for each circle.
+   * A width of 0 is a filled disc; a non-zero colour is drawn with the background colour.
+   */
+  circles: Float32Array
+  /**
+   * Strings (human-readable text), packed as `x, y, fontSize, width, rotation, halign` for each string.
+   * An halign of 0 is centred on `x`, 1 is left-aligned and 2 is right-aligned.
+   */
+  strings: Float32Array
+  /** Text of each string, in the same order as `strings` */
+  texts: string[]
+  /** Messages produced by the library during render */
+  message: string
+  /** Status code produced by the library during render */
+  code: number
+}
+
+export default SymbologyVector
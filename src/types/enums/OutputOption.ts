@@ -16,7 +16,9 @@ enum OutputOption {
   /** Plot a matrix symbol using dots rather than squares. */
   BARCODE_DOTTY_MODE = 256,
   /** Use GS instead FNC1 as GS1 separator. */
-  GS1_GS_SEPARATOR = 512
+  GS1_GS_SEPARATOR = 512,
+  /** Render the file into memory rather than to disk (applied to every image type except PNG). */
+  BARCODE_MEMORY_FILE = 65536
 }
 
 export default OutputOption
@@ -4,7 +4,17 @@ enum OutputType {
   /** Scalable Vector Graphics */
   SVG = 'svg',
   /** Adobe Encapsulated PostScript */
-  EPS = 'eps'
+  EPS = 'eps',
+  /** Graphics Interchange Format (bitmap) */
+  GIF = 'gif',
+  /** Tagged Image File Format (bitmap) */
+  TIFF = 'tif',
+  /** Windows Bitmap */
+  BMP = 'bmp',
+  /** ZSoft Paintbrush image (bitmap) */
+  PCX = 'pcx',
+  /** Windows Enhanced Metafile (vector) */
+  EMF = 'emf'
 }
 
 export default OutputType
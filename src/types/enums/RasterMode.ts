@@ -0,0 +1,10 @@
+enum RasterMode {
+  /** 8-bit RGBA, 4 bytes per pixel, with the alpha of the foreground and background colours */
+  RGBA = 'rgba',
+  /** One byte per pixel, indexing `palette` */
+  INDEXED = 'indexed',
+  /** One bit per pixel (most significant bit first), indexing `palette`. Not available for Ultracode. */
+  MONO = 'mono'
+}
+
+export default RasterMode
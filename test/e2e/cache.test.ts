@@ -0,0 +1,44 @@
+import OutputType from '../../src/types/enums/OutputType'
+import SymbologyType from '../../src/types/enums/SymbologyType'
+import symbology from '../../src'
+
+describe('Symbology Result Cache', () => {
+  afterEach(() => {
+    symbology.configureCache({ maxBytes: 0 })
+  })
+
+  it('should not cache anything until it is configured', async () => {
+    const before = symbology.getCacheStats()
+
+    await symbology.createStream({ symbology: SymbologyType.QRCODE }, 'not cached', OutputType.PNG)
+
+    expect(symbology.getCacheStats()).toEqual(before)
+  })
+
+  it('should answer a repeated render from the cache with the same output', async () => {
+    symbology.configureCache({ maxBytes: 1 << 20 })
+    symbology.clearCache()
+
+    const { hits, misses } = symbology.getCacheStats()
+    const first = await symbology.createStream({ symbology: SymbologyType.QRCODE }, 'SKU-1', OutputType.PNG)
+    const second = await symbology.createStream({ symbology: SymbologyType.QRCODE }, 'SKU-1', OutputType.PNG)
+    const other = await symbology.createStream({ symbology: SymbologyType.QRCODE, scale: 2 }, 'SKU-1', OutputType.PNG)
+    const stats = symbology.getCacheStats()
+
+    expect(second).toEqual(first)
+    expect(other.data).not.toEqual(first.data)
+    expect(stats.hits - hits).toEqual(1)
+    expect(stats.misses - misses).toEqual(2)
+    expect(stats.entries).toEqual(2)
+    expect(stats.bytes).toBeLessThanOrEqual(stats.maxBytes)
+  })
+
+  it('should empty the cache when cleared', async () => {
+    symbology.configureCache({ maxBytes: 1 << 20 })
+
+    await symbology.createStream({ symbology: SymbologyType.CODE128 }, '12345', OutputType.SVG)
+    symbology.clearCache()
+
+    expect(symbology.getCacheStats()).toEqual(expect.objectContaining({ entries: 0, bytes: 0 }))
+  })
+})
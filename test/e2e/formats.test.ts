@@ -0,0 +1,47 @@
+import symbology from '../../src'
+import OutputType from '../../src/types/enums/OutputType'
+import SymbologyType from '../../src/types/enums/SymbologyType'
+import { createImageFile } from '../helpers'
+
+describe('Symbology Output Types', () => {
+  // file signature (magic number) of each natively-rendered image file
+  const signatures: Array<[OutputType, number[], number]> = [
+    [OutputType.PNG, [0x89, 0x50, 0x4e, 0x47], 0],
+    [OutputType.GIF, [0x47, 0x49, 0x46, 0x38], 0], // "GIF8"
+    [OutputType.TIFF, [0x49, 0x49, 0x2a, 0x00], 0], // little-endian "II*"
+    [OutputType.BMP, [0x42, 0x4d], 0], // "BM"
+    [OutputType.PCX, [0x0a], 0],
+    [OutputType.EMF, [0x20, 0x45, 0x4d, 0x46], 40] // " EMF" in the header record
+  ]
+
+  signatures.forEach(([outputType, signature, offset]) => {
+    it(`should render a ${outputType.toUpperCase()} file`, async () => {
+      const image = await createImageFile({
+        symbology: SymbologyType.CODE128
+      }, outputType, '12345')
+
+      expect([...image.subarray(offset, offset + signature.length)]).toEqual(signature)
+    })
+  })
+
+  it('should write a two-colour PNG as a 1-bit indexed image', async () => {
+    const image = await createImageFile({
+      symbology: SymbologyType.QRCODE
+    }, OutputType.PNG, '12345')
+
+    // IHDR bit depth and colour type (indexed)
+    expect([image[24], image[25]]).toEqual([1, 3])
+  })
+
+  signatures.forEach(([outputType]) => {
+    it(`should encode a ${outputType.toUpperCase()} file as a data URL of the same file`, async () => {
+      const config = { symbology: SymbologyType.CODE128 }
+      const image = await createImageFile(config, outputType, '12345')
+      const { data } = await symbology.createStream(config, '12345', outputType)
+      const [prefix, payload] = (data as string).split(',')
+
+      expect(prefix).toMatch(/^data:image\/[a-z-]+;base64$/)
+      expect(Buffer.from(payload, 'base64').equals(image)).toBe(true)
+    })
+  })
+})
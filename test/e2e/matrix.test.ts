@@ -0,0 +1,46 @@
+import SymbologyType from '../../src/types/enums/SymbologyType'
+import symbology from '../../src'
+
+describe('Symbology Module Matrix', () => {
+  const isDark = (modules: Uint8Array, stride: number, row: number, column: number) => {
+    return ((modules[row * stride + (column >> 3)] >> (column & 7)) & 1) === 1
+  }
+
+  it('should return the modules of a QR Code symbology, starting with its finder patterns', async () => {
+    const res = await symbology.encode({
+      symbology: SymbologyType.QRCODE
+    }, '12345')
+
+    expect(res.code).toEqual(0)
+    expect(res.rows).toEqual(21)
+    expect(res.width).toEqual(21)
+    expect(res.stride).toEqual(3)
+    expect(res.modules).toHaveLength(21 * 3)
+    expect(res.rowHeights).toHaveLength(21)
+
+    // the top row of the top-left finder pattern is 7 dark modules, followed by a light separator
+    for (let column = 0; column < 7; column++) {
+      expect(isDark(res.modules, res.stride, 0, column)).toEqual(true)
+    }
+    expect(isDark(res.modules, res.stride, 0, 7)).toEqual(false)
+  })
+
+  it('should share the height of a linear symbology with its row', async () => {
+    const res = await symbology.encode({
+      symbology: SymbologyType.CODE128,
+      height: 30
+    }, '12345')
+
+    expect(res.rows).toEqual(1)
+    expect(res.rowHeights[0]).toEqual(30)
+    expect(res.colours).toHaveLength(0)
+  })
+
+  it('should return the colour of each Ultracode module', async () => {
+    const res = await symbology.encode({
+      symbology: SymbologyType.ULTRA
+    }, '12345')
+
+    expect(res.colours).toHaveLength(res.rows * res.width)
+  })
+})
@@ -0,0 +1,92 @@
+import SymbologyType from '../../src/types/enums/SymbologyType'
+import RasterMode from '../../src/types/enums/RasterMode'
+import symbology from '../../src'
+
+describe('Symbology Raster Pixels', () => {
+  it('should return 4 bytes of RGBA per pixel', async () => {
+    const res = await symbology.createRaster({
+      symbology: SymbologyType.CODE128
+    }, '12345', RasterMode.RGBA)
+
+    expect(res.mode).toEqual(RasterMode.RGBA)
+    expect(res.width).toBeGreaterThan(0)
+    expect(res.height).toBeGreaterThan(0)
+    expect(res.pixels).toHaveLength(res.width * res.height * 4)
+  })
+
+  it('should take the alpha of each pixel from the alpha of its colour', async () => {
+    const res = await symbology.createRaster({
+      symbology: SymbologyType.QRCODE,
+      foregroundColor: '11223380',
+      backgroundColor: 'FFFFFF00'
+    }, '12345')
+    const alphas = new Set<number>()
+
+    for (let i = 0; i < res.pixels.length; i += 4) {
+      alphas.add(res.pixels[i + 3])
+    }
+
+    expect([...alphas].sort((a, b) => a - b)).toEqual([0x00, 0x80])
+    expect([...res.pixels.subarray(0, 4)]).toEqual([0x11, 0x22, 0x33, 0x80]) // top-left finder pattern
+  })
+
+  it('should keep the colours of Ultracode modules', async () => {
+    const res = await symbology.createRaster({
+      symbology: SymbologyType.ULTRA
+    }, '12345')
+    const colours = new Set<string>()
+
+    for (let i = 0; i < res.pixels.length; i += 4) {
+      colours.add(res.pixels.subarray(i, i + 3).toString())
+    }
+
+    expect(colours.size).toBeGreaterThan(2)
+  })
+
+  it('should return one palette index per pixel in indexed mode', async () => {
+    const config = {
+      symbology: SymbologyType.QRCODE,
+      foregroundColor: '112233',
+      backgroundColor: 'FFFFFF00'
+    }
+    const rgba = await symbology.createRaster(config, '12345', RasterMode.RGBA)
+    const res = await symbology.createRaster(config, '12345', RasterMode.INDEXED)
+
+    expect(res.stride).toEqual(res.width)
+    expect([...res.palette]).toEqual([0xff, 0xff, 0xff, 0x00, 0x11, 0x22, 0x33, 0xff])
+
+    // expanding the indices through the palette gives the RGBA pixels
+    const expanded = Buffer.concat([...res.pixels].map(i => res.palette.subarray(i * 4, i * 4 + 4)))
+
+    expect(expanded.equals(Buffer.from(rgba.pixels))).toBe(true)
+  })
+
+  it('should pack one bit per pixel in mono mode', async () => {
+    const config = { symbology: SymbologyType.DATAMATRIX }
+    const indexed = await symbology.createRaster(config, '12345', RasterMode.INDEXED)
+    const res = await symbology.createRaster(config, '12345', RasterMode.MONO)
+
+    expect(res.stride).toEqual(Math.ceil(res.width / 8))
+    expect(res.pixels).toHaveLength(res.stride * res.height)
+
+    for (let y = 0; y < res.height; y++) {
+      for (let x = 0; x < res.width; x++) {
+        const bit = (res.pixels[y * res.stride + (x >> 3)] >> (7 - (x & 7))) & 1
+
+        expect(bit).toEqual(indexed.pixels[y * indexed.stride + x])
+      }
+    }
+  })
+
+  it('should reject mono mode for the colours of Ultracode', async () => {
+    await expect(symbology.createRaster({
+      symbology: SymbologyType.ULTRA
+    }, '12345', RasterMode.MONO)).rejects.toMatch(/colours/)
+  })
+
+  it('should reject with the message of a symbology that fails to encode', async () => {
+    await expect(symbology.createRaster({
+      symbology: SymbologyType.EANX
+    }, 'not a number')).rejects.toMatch(/Error/)
+  })
+})
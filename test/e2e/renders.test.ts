@@ -0,0 +1,31 @@
+import OutputType from '../../src/types/enums/OutputType'
+import SymbologyType from '../../src/types/enums/SymbologyType'
+import symbology from '../../src'
+
+describe('Symbology Renders', () => {
+  it('should render each spec the same as createStream() does', async () => {
+    const config = {
+      symbology: SymbologyType.QRCODE
+    }
+    const specs = [
+      { outputType: OutputType.PNG, scale: 1 },
+      { outputType: OutputType.PNG, scale: 4, rotation: 90 },
+      { outputType: OutputType.SVG, foregroundColor: 'FF0000' },
+      { outputType: OutputType.GIF, backgroundColor: '00FF00' }
+    ]
+
+    const renders = await symbology.createRenders(config, '12345', specs)
+    const streams = await Promise.all(specs.map(({ outputType, ...options }) => {
+      return symbology.createStream({ ...config, ...options }, '12345', outputType)
+    }))
+
+    expect(renders.map(res => res.data)).toEqual(streams.map(res => res.data))
+    expect(renders[1].width).toEqual(renders[0].width * 4)
+  })
+
+  it('should reject if the symbology fails to encode', async () => {
+    await expect(symbology.createRenders({
+      symbology: SymbologyType.EANX
+    }, 'not a number', [{ outputType: OutputType.PNG }])).rejects.toMatch(/Error/)
+  })
+})
@@ -0,0 +1,64 @@
+import OutputType from '../../src/types/enums/OutputType'
+import SymbologyType from '../../src/types/enums/SymbologyType'
+import symbology from '../../src'
+
+describe('Symbology Render Stats', () => {
+  beforeEach(() => {
+    symbology.configureCache({ maxBytes: 0 })
+    symbology.clearStats()
+  })
+
+  afterEach(() => {
+    symbology.configureStats({ enabled: false })
+  })
+
+  it('should not time anything until it is enabled', async () => {
+    const res = await symbology.createStream({ symbology: SymbologyType.QRCODE }, 'not timed', OutputType.PNG)
+    const stats = symbology.getStats()
+
+    expect(res).not.toHaveProperty('timings')
+    expect(stats.enabled).toBe(false)
+    expect(stats.renders).toEqual(0)
+  })
+
+  it('should time each phase of a PNG render', async () => {
+    symbology.configureStats({ enabled: true })
+
+    const { timings } = await symbology.createStream({ symbology: SymbologyType.QRCODE }, 'timed', OutputType.PNG)
+
+    expect(Object.keys(timings!)).toEqual(['queue', 'convert', 'encode', 'plot', 'output', 'image', 'dataUrl', 'total'])
+    Object.values(timings!).forEach(ms => expect(ms).toBeGreaterThanOrEqual(0))
+    expect(timings!.total).toBeGreaterThanOrEqual(timings!.encode + timings!.image!)
+  })
+
+  it('should leave out the phases a render does not run', async () => {
+    symbology.configureStats({ enabled: true })
+
+    const [svg] = await symbology.createRenders({ symbology: SymbologyType.CODE128 }, '12345', [{ outputType: OutputType.SVG }])
+    const [failed] = await symbology.createStreams({ symbology: SymbologyType.EANX }, ['not a number'], OutputType.PNG)
+
+    expect(Object.keys(svg.timings!)).toEqual(['queue', 'convert', 'encode', 'plot', 'output', 'total'])
+    expect(Object.keys(failed.timings!)).toEqual(['queue', 'convert', 'encode', 'total'])
+  })
+
+  it('should add up the timings of every render', async () => {
+    symbology.configureStats({ enabled: true })
+
+    const encoder = symbology.createEncoder({ symbology: SymbologyType.DATAMATRIX }, OutputType.SVG)
+
+    await encoder.encode('1')
+    await encoder.encode('2')
+    await symbology.createStreams({ symbology: SymbologyType.EANX }, ['12345', 'not a number'], OutputType.PNG)
+
+    const { renders, errors, phases } = symbology.getStats()
+    const sum = (histogram: number[]) => histogram.reduce((total, count) => total + count, 0)
+
+    expect(renders).toEqual(4)
+    expect(errors).toEqual(1)
+    expect(phases.total.count).toEqual(4)
+    expect(phases.image.count).toEqual(1)
+    expect(phases.dataUrl.count).toEqual(0)
+    expect(sum(phases.encode.histogram)).toEqual(4)
+    expect(phases.total.maxMs).toBeLessThanOrEqual(phases.total.totalMs)
+  })
+})
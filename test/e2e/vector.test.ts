@@ -0,0 +1,33 @@
+import SymbologyType from '../../src/types/enums/SymbologyType'
+import symbology from '../../src'
+
+describe('Symbology Vector Geometry', () => {
+  it('should return the bars and human-readable text of a linear symbology', async () => {
+    const res = await symbology.createVector({
+      symbology: SymbologyType.CODE128
+    }, '12345')
+
+    expect(res.code).toEqual(0)
+    expect(res.rectangles.length % 5).toEqual(0)
+    expect(res.rectangles.length).toBeGreaterThan(0)
+    expect(res.hexagons).toHaveLength(0)
+    expect(res.strings).toHaveLength(6)
+    expect(res.texts).toEqual(['12345'])
+  })
+
+  it('should return the hexagons and bullseye circles of a MaxiCode symbology', async () => {
+    const res = await symbology.createVector({
+      symbology: SymbologyType.MAXICODE
+    }, '12345')
+
+    expect(res.rectangles).toHaveLength(0)
+    expect(res.hexagons.length / 4).toBeGreaterThan(0)
+    expect(res.circles).toHaveLength(3 * 5)
+  })
+
+  it('should reject with the message of a symbology that fails to encode', async () => {
+    await expect(symbology.createVector({
+      symbology: SymbologyType.EANX
+    }, 'not a number')).rejects.toMatch(/Error/)
+  })
+})
@@ -0,0 +1,44 @@
+import path from 'path'
+import { Worker } from 'worker_threads'
+import symbology from '../../src'
+import OutputOption from '../../src/types/enums/OutputOption'
+import OutputType from '../../src/types/enums/OutputType'
+import SymbologyType from '../../src/types/enums/SymbologyType'
+
+/**
+ * Renders an SVG of the given Code 128 data with the native addon loaded by a worker thread.
+ *
+ * @param {string} data - barcode data
+ * @returns {Promise<string>} SVG data
+ */
+function createSvgInWorker (data: string): Promise<string> {
+  const binding = path.join(__dirname, '../../src/binding/index.js')
+  const outputOptions = OutputOption.BARCODE_NO_ASCII | OutputOption.BARCODE_MEMORY_FILE
+  const worker = new Worker(`
+    const { parentPort, workerData } = require('worker_threads')
+    const codify = require(${JSON.stringify(binding)})
+
+    codify.createStream(workerData, ${SymbologyType.CODE128}, 50, 0, 0, ${outputOptions}, 'FFFFFFFF', '000000FF', 'out.svg',
+      1, -1, -1, -1, 1, workerData, 0, 0, '', 0, 0.8, res => parentPort.postMessage(res.encodedData))
+  `, { eval: true, workerData: data })
+
+  return new Promise((resolve, reject) => {
+    worker.once('message', resolve)
+    worker.once('error', reject)
+  })
+}
+
+describe('Worker threads', () => {
+  it('should render the same symbology in worker threads as in the main thread', async () => {
+    const { data } = await symbology.createStream({
+      symbology: SymbologyType.CODE128
+    }, '12345', OutputType.SVG)
+
+    const results = await Promise.all([
+      createSvgInWorker('12345'),
+      createSvgInWorker('12345')
+    ])
+
+    expect(results).toEqual([data, data])
+  })
+})